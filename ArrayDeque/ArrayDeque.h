@@ -0,0 +1,495 @@
+// By Fabio Nardelli
+// coda a doppia entrata (deque) implementata mediante vettore segmentato.
+// Gli elementi sono memorizzati in blocchi di dimensione fissa, allocati come
+// memoria grezza; una mappa (vettore dinamico di puntatori ai blocchi) tiene
+// traccia dei blocchi in uso. Ciascun elemento ha un indice globale,
+// g = start + posizione, e si trova nel blocco g / blockSize, alla posizione
+// g % blockSize; blockSize e' una potenza di 2, per cui l'accesso casuale
+// costa O(1). Gli inserimenti e le rimozioni alle due estremita' costano O(1)
+// (ammortizzato, per la crescita della mappa) e non spostano mai gli elementi
+// gia' presenti: i riferimenti agli elementi restano validi dopo un
+// inserimento in testa o in coda, mentre gli iteratori vengono invalidati.
+
+#ifndef ARRAY_DEQUE_H
+#define ARRAY_DEQUE_H
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include "../Utils/Range.h"
+
+template <typename T>
+class ArrayDeque;
+
+template <typename T>
+std::ostream &operator<<(std::ostream &, const ArrayDeque<T> &);
+
+template <typename T>
+class ArrayDeque {
+    friend std::ostream &operator<< <>(std::ostream &, const ArrayDeque<T> &);
+    template <typename V> class BasicIterator;
+public:
+    typedef int Position;
+    // iteratori ad accesso casuale, dal primo all'ultimo elemento
+    typedef BasicIterator<T> iterator;
+    typedef BasicIterator<const T> const_iterator;
+
+    ArrayDeque(); // costruttore di default
+    ArrayDeque(const ArrayDeque<T> &); // costruttore per copia
+    ArrayDeque(ArrayDeque<T> &&); // costruttore di spostamento
+    ~ArrayDeque(); // distruttore
+    ArrayDeque<T> &operator=(const ArrayDeque<T> &);
+    ArrayDeque<T> &operator=(ArrayDeque<T> &&);
+
+    // operatori
+    // restituisce true se la deque e' vuota, false altrimenti
+    bool isEmpty() const { return size == 0; }
+    // restituisce il numero di elementi contenuti nella deque
+    int getSize() const { return size; }
+    void print() const; // stampa la deque
+    // inserisce un elemento in coda
+    void pushBack(const T &item) { emplaceBack(item); }
+    void pushBack(T &&item) { emplaceBack(std::move(item)); }
+    // inserisce un elemento in testa
+    void pushFront(const T &item) { emplaceFront(item); }
+    void pushFront(T &&item) { emplaceFront(std::move(item)); }
+    // costruiscono un elemento in coda/in testa a partire dagli argomenti
+    template <typename... Args>
+    void emplaceBack(Args &&...);
+    template <typename... Args>
+    void emplaceFront(Args &&...);
+    void popBack(); // rimuove l'elemento in coda
+    void popFront(); // rimuove l'elemento in testa
+    const T &front() const; // legge l'elemento in testa
+    const T &back() const; // legge l'elemento in coda
+    const T &read(Position) const; // legge l'elemento nella posizione indicata
+    void write(Position, const T &); // scrive nell'elemento indicato
+    // operatore di uguaglianza ==
+    bool operator==(const ArrayDeque<T> &) const;
+
+    // iteratori compatibili con la libreria standard: ibegin() indica
+    // il primo elemento, iend() la posizione successiva all'ultimo
+    iterator ibegin() { return iterator(map, start); }
+    iterator iend() { return iterator(map, start + size); }
+    const_iterator ibegin() const { return const_iterator(map, start); }
+    const_iterator iend() const { return const_iterator(map, start + size); }
+    // consente di scandire la deque con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
+
+private:
+    T **map; // vettore dei puntatori ai blocchi (0 = blocco non allocato)
+    int mapCapacity; // dimensione della mappa
+    int start; // indice globale del primo elemento
+    int size; // numero di elementi contenuti nella deque
+    T *spare; // ultimo blocco liberato, riutilizzato dal prossimo inserimento
+
+    // numero di elementi per blocco: una potenza di 2, scelta in modo che
+    // un blocco occupi circa 4 KB (almeno 16 elementi per i tipi grandi)
+    static const int blockSize = sizeof(T) <= 4 ? 1024 : sizeof(T) <= 8 ? 512
+        : sizeof(T) <= 16 ? 256 : sizeof(T) <= 32 ? 128
+        : sizeof(T) <= 64 ? 64 : 16;
+    static const int defaultMapCapacity = 8;
+
+    // restituiscono il blocco e la posizione nel blocco di un indice globale
+    static int block(int g) { return static_cast<unsigned>(g) / blockSize; }
+    static int offset(int g) { return static_cast<unsigned>(g) % blockSize; }
+    // restituisce l'elemento con l'indice globale indicato
+    T &at(int g) const { return map[block(g)][offset(g)]; }
+
+    // assegna un blocco alla posizione b della mappa, se non ne ha gia' uno
+    void acquireBlock(int b);
+    // libera il blocco nella posizione b della mappa
+    void releaseBlock(int b);
+    // ricentra i blocchi in uso nella mappa, facendola crescere se
+    // necessario, in modo che ci sia spazio per un blocco a ogni estremita'
+    void recenter();
+    // distrugge tutti gli elementi e libera blocchi e mappa
+    void clear();
+};
+
+// iteratore ad accesso casuale: memorizza la mappa e l'indice globale
+// dell'elemento, che viene convertito in blocco e posizione nel blocco
+// solo quando l'elemento viene letto
+template <typename T>
+template <typename V>
+class ArrayDeque<T>::BasicIterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_cv<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    BasicIterator() : map(0), index(0) { }
+    BasicIterator(T *const *m, int i) : map(m), index(i) { }
+    // conversione da iteratore a iteratore costante
+    operator BasicIterator<const V>() const
+        { return BasicIterator<const V>(map, index); }
+
+    reference operator*() const
+        { return map[block(index)][offset(index)]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    BasicIterator &operator++() { ++index; return *this; }
+    BasicIterator operator++(int)
+        { BasicIterator old(*this); ++index; return old; }
+    BasicIterator &operator--() { --index; return *this; }
+    BasicIterator operator--(int)
+        { BasicIterator old(*this); --index; return old; }
+    BasicIterator &operator+=(difference_type n)
+        { index += static_cast<int>(n); return *this; }
+    BasicIterator &operator-=(difference_type n)
+        { index -= static_cast<int>(n); return *this; }
+    BasicIterator operator+(difference_type n) const
+        { BasicIterator it(*this); return it += n; }
+    BasicIterator operator-(difference_type n) const
+        { BasicIterator it(*this); return it -= n; }
+    friend BasicIterator operator+(difference_type n, const BasicIterator &it)
+        { return it + n; }
+    difference_type operator-(const BasicIterator &it) const
+        { return index - it.index; }
+
+    bool operator==(const BasicIterator &it) const { return index == it.index; }
+    bool operator!=(const BasicIterator &it) const { return index != it.index; }
+    bool operator<(const BasicIterator &it) const { return index < it.index; }
+    bool operator>(const BasicIterator &it) const { return index > it.index; }
+    bool operator<=(const BasicIterator &it) const { return index <= it.index; }
+    bool operator>=(const BasicIterator &it) const { return index >= it.index; }
+private:
+    T *const *map; // mappa dei blocchi
+    int index; // indice globale dell'elemento
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T>
+std::ostream &operator<<(std::ostream &output, const ArrayDeque<T> &d)
+{
+    d.print();
+    return output; // consente cout << a << b << c
+}
+
+// costruttore di default: la mappa e' vuota e il primo elemento
+// verra' inserito a meta' della mappa
+template <typename T>
+ArrayDeque<T>::ArrayDeque()
+    : map(new T *[defaultMapCapacity]()), mapCapacity(defaultMapCapacity),
+      start(defaultMapCapacity / 2 * blockSize), size(0), spare(0)
+{
+}
+
+// costruttore per copia
+template <typename T>
+ArrayDeque<T>::ArrayDeque(const ArrayDeque<T> &d)
+    : map(new T *[defaultMapCapacity]()), mapCapacity(defaultMapCapacity),
+      start(defaultMapCapacity / 2 * blockSize), size(0), spare(0)
+{
+    try {
+        for (int i = 0; i < d.size; ++i)
+            emplaceBack(d.at(d.start + i));
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// costruttore di spostamento: si appropria dei blocchi di d, che resta vuota
+template <typename T>
+ArrayDeque<T>::ArrayDeque(ArrayDeque<T> &&d)
+    : map(d.map), mapCapacity(d.mapCapacity), start(d.start), size(d.size),
+      spare(d.spare)
+{
+    d.map = 0;
+    d.mapCapacity = d.start = d.size = 0;
+    d.spare = 0;
+}
+
+// distrugge tutti gli elementi e libera blocchi e mappa
+template <typename T>
+void ArrayDeque<T>::clear()
+{
+    for (int i = 0; i < size; ++i)
+        at(start + i).~T();
+    for (int b = 0; b < mapCapacity; ++b)
+        ::operator delete(map[b]);
+    ::operator delete(spare);
+    delete [] map;
+    map = 0;
+    mapCapacity = start = size = 0;
+    spare = 0;
+}
+
+// distruttore
+template <typename T>
+ArrayDeque<T>::~ArrayDeque()
+{
+    clear();
+}
+
+// overload dell'operatore di assegnazione =
+template <typename T>
+ArrayDeque<T> &ArrayDeque<T>::operator=(const ArrayDeque<T> &d)
+{
+    if (&d != this) { // evita l'autoassegnazione
+        // costruisce prima la copia, in modo che un'eccezione
+        // lasci invariata questa deque
+        ArrayDeque<T> temp(d);
+        *this = std::move(temp);
+    }
+
+    return *this; // consente (a = b = c)
+}
+
+// overload dell'operatore di assegnazione = per spostamento
+template <typename T>
+ArrayDeque<T> &ArrayDeque<T>::operator=(ArrayDeque<T> &&d)
+{
+    if (&d != this) { // evita l'autoassegnazione
+        std::swap(map, d.map);
+        std::swap(mapCapacity, d.mapCapacity);
+        std::swap(start, d.start);
+        std::swap(size, d.size);
+        std::swap(spare, d.spare);
+    }
+
+    return *this; // consente (a = b = c)
+}
+
+// stampa la deque
+template <typename T>
+void ArrayDeque<T>::print() const
+{
+    if (isEmpty()) {
+        std::cout << "\n Deque is empty!\n";
+        return;
+    }
+    std::cout << "\n [";
+
+    for (int i = 0; i < size; ++i) {
+        std::cout << std::setw(3) << at(start + i) << " ";
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if ((i + 1) % 5 == 0 && i != size - 1)
+            std::cout << "\n ";
+    }
+    std::cout << " ]\n";
+}
+
+// assegna un blocco alla posizione b della mappa, riutilizzando
+// il blocco di riserva se presente
+template <typename T>
+void ArrayDeque<T>::acquireBlock(int b)
+{
+    if (map[b] != 0)
+        return;
+    if (spare != 0) {
+        map[b] = spare;
+        spare = 0;
+    } else
+        map[b] = static_cast<T *>(::operator new(blockSize * sizeof(T)));
+}
+
+// libera il blocco nella posizione b della mappa. Un blocco viene tenuto
+// di riserva, in modo che push e pop alternati sul confine di un blocco
+// non allochino e liberino memoria a ogni operazione
+template <typename T>
+void ArrayDeque<T>::releaseBlock(int b)
+{
+    if (spare == 0)
+        spare = map[b];
+    else
+        ::operator delete(map[b]);
+    map[b] = 0;
+}
+
+// sposta i puntatori ai blocchi in uso al centro della mappa. Se la mappa e'
+// occupata per piu' di meta', la sua dimensione viene raddoppiata: in questo
+// modo il costo della riorganizzazione, proporzionale al numero di blocchi
+// in uso, e' ammortizzato sugli inserimenti che l'hanno resa necessaria
+template <typename T>
+void ArrayDeque<T>::recenter()
+{
+    int first = block(start);
+    int count = (size > 0 ? block(start + size - 1) - first + 1 : 0);
+    int newCapacity = mapCapacity;
+    if (2 * (count + 1) > mapCapacity)
+        newCapacity = 2 * mapCapacity > 2 * (count + 1)
+            ? 2 * mapCapacity : 2 * (count + 1);
+    int newFirst = (newCapacity - count) / 2;
+
+    if (newCapacity != mapCapacity) {
+        T **newMap = new T *[newCapacity]();
+        if (count > 0)
+            std::memcpy(newMap + newFirst, map + first, count * sizeof(T *));
+        delete [] map;
+        map = newMap;
+        mapCapacity = newCapacity;
+    } else {
+        std::memmove(map + newFirst, map + first, count * sizeof(T *));
+        // azzera le posizioni rimaste libere
+        for (int b = 0; b < newFirst; ++b)
+            map[b] = 0;
+        for (int b = newFirst + count; b < mapCapacity; ++b)
+            map[b] = 0;
+    }
+    start = newFirst * blockSize + offset(start);
+}
+
+// costruisce un elemento in coda. Se l'ultimo blocco e' pieno ne viene
+// assegnato uno nuovo; gli elementi presenti non vengono mai spostati
+template <typename T>
+template <typename... Args>
+void ArrayDeque<T>::emplaceBack(Args &&... args)
+{
+    if (start + size == mapCapacity * blockSize)
+        recenter();
+    int g = start + size;
+    acquireBlock(block(g));
+    try {
+        new (&at(g)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        // se il blocco era stato appena assegnato, lo rilascia
+        if (offset(g) == 0 || size == 0)
+            releaseBlock(block(g));
+        throw;
+    }
+    ++size;
+}
+
+// costruisce un elemento in testa
+template <typename T>
+template <typename... Args>
+void ArrayDeque<T>::emplaceFront(Args &&... args)
+{
+    if (start == 0)
+        recenter();
+    int g = start - 1;
+    acquireBlock(block(g));
+    try {
+        new (&at(g)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        // se il blocco era stato appena assegnato, lo rilascia
+        if (offset(g) == blockSize - 1 || size == 0)
+            releaseBlock(block(g));
+        throw;
+    }
+    --start;
+    ++size;
+}
+
+// rimuove l'elemento in coda
+template <typename T>
+void ArrayDeque<T>::popBack()
+{
+    if (isEmpty()) {
+        std::cerr << "Cannot pop: Deque is empty!";
+        return;
+    }
+
+    int g = start + size - 1;
+    at(g).~T();
+    --size;
+    // libera il blocco se e' rimasto vuoto
+    if (offset(g) == 0 || size == 0)
+        releaseBlock(block(g));
+    // se la deque e' vuota, riparte dal centro della mappa
+    if (size == 0)
+        start = mapCapacity / 2 * blockSize;
+}
+
+// rimuove l'elemento in testa
+template <typename T>
+void ArrayDeque<T>::popFront()
+{
+    if (isEmpty()) {
+        std::cerr << "Cannot pop: Deque is empty!";
+        return;
+    }
+
+    int g = start;
+    at(g).~T();
+    ++start;
+    --size;
+    // libera il blocco se e' rimasto vuoto
+    if (offset(g) == blockSize - 1 || size == 0)
+        releaseBlock(block(g));
+    // se la deque e' vuota, riparte dal centro della mappa
+    if (size == 0)
+        start = mapCapacity / 2 * blockSize;
+}
+
+// legge l'elemento in testa
+template <typename T>
+const T &ArrayDeque<T>::front() const
+{
+    if (isEmpty())
+        throw std::domain_error("Deque is empty!");
+
+    return at(start);
+}
+
+// legge l'elemento in coda
+template <typename T>
+const T &ArrayDeque<T>::back() const
+{
+    if (isEmpty())
+        throw std::domain_error("Deque is empty!");
+
+    return at(start + size - 1);
+}
+
+// legge il dato contenuto nell'elemento indicato
+template <typename T>
+const T &ArrayDeque<T>::read(Position pos) const
+{
+    if (isEmpty())
+        throw std::domain_error("Deque is empty!");
+
+    if (pos < 0 || pos >= size)
+        throw std::out_of_range("Invalid position! "
+            "Position must be 0 - (size - 1)");
+
+    return at(start + pos);
+}
+
+// scrive nell'elemento indicato
+template <typename T>
+void ArrayDeque<T>::write(Position pos, const T &item)
+{
+    if (pos < 0 || pos >= size) {
+        std::cerr << "Invalid position! "
+            << "Position must be 0 - (size - 1)";
+        return;
+    }
+
+    at(start + pos) = item;
+}
+
+// overload dell'operatore di uguaglianza ==
+template <typename T>
+bool ArrayDeque<T>::operator==(const ArrayDeque<T> &d) const
+{
+    // se le deque hanno dimensioni diverse, allora sono diverse
+    if (size != d.size)
+        return false;
+
+    // controllo esaustivo su ciascun elemento
+    for (int i = 0; i < size; ++i)
+        if (at(start + i) != d.at(d.start + i))
+            return false;
+
+    return true; // se l'esecuzione arriva qui, le due deque sono uguali
+}
+
+#endif
@@ -0,0 +1,133 @@
+// benchmark di ArrayDeque contro le classi basate su un unico vettore.
+//   testa: n inserimenti e n rimozioni in testa (ArrayList::pushFront e
+//          popFront spostano tutti gli elementi, O(n) per operazione);
+//   coda FIFO: n inserimenti in coda e n rimozioni in testa (come
+//          ArrayDeque, ArrayQueue parte dalla capacita' di default e cresce
+//          durante gli inserimenti);
+//   pila: n inserimenti e n rimozioni in cima.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "ArrayDeque.h"
+#include "../ArrayList/ArrayList.h"
+#include "../ArrayQueue/ArrayQueue.h"
+#include "../ArrayStack/ArrayStack.h"
+using std::cout;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, int ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f(ops);
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+// evita che il compilatore elimini i cicli di lettura
+volatile int sink;
+
+double dequeFront(int n)
+{
+    ArrayDeque<int> d;
+    return timeOps([&d, n](int) {
+        for (int i = 0; i < n; ++i)
+            d.pushFront(i);
+        for (int i = 0; i < n; ++i)
+            d.popFront();
+    }, 2 * n);
+}
+
+double listFront(int n)
+{
+    ArrayList<int> l;
+    return timeOps([&l, n](int) {
+        for (int i = 0; i < n; ++i)
+            l.pushFront(i);
+        for (int i = 0; i < n; ++i)
+            l.popFront();
+    }, 2 * n);
+}
+
+double dequeFifo(int n)
+{
+    ArrayDeque<int> d;
+    return timeOps([&d, n](int) {
+        for (int i = 0; i < n; ++i)
+            d.pushBack(i);
+        for (int i = 0; i < n; ++i) {
+            sink = d.front();
+            d.popFront();
+        }
+    }, 2 * n);
+}
+
+double queueFifo(int n)
+{
+    ArrayQueue<int> q;
+    return timeOps([&q, n](int) {
+        for (int i = 0; i < n; ++i)
+            q.enqueue(i);
+        for (int i = 0; i < n; ++i) {
+            sink = q.top();
+            q.dequeue();
+        }
+    }, 2 * n);
+}
+
+double dequeStack(int n)
+{
+    ArrayDeque<int> d;
+    return timeOps([&d, n](int) {
+        for (int i = 0; i < n; ++i)
+            d.pushBack(i);
+        for (int i = 0; i < n; ++i) {
+            sink = d.back();
+            d.popBack();
+        }
+    }, 2 * n);
+}
+
+double stackStack(int n)
+{
+    ArrayStack<int> s;
+    return timeOps([&s, n](int) {
+        for (int i = 0; i < n; ++i)
+            s.push(i);
+        for (int i = 0; i < n; ++i) {
+            sink = s.top();
+            s.pop();
+        }
+    }, 2 * n);
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK ArrayDeque **************\n\n";
+    cout << "tempo medio per operazione (ns/op)\n\n";
+    cout << std::setw(10) << "n" << std::setw(12) << "Deque"
+         << std::setw(12) << "List" << std::setw(12) << "Deque"
+         << std::setw(12) << "Queue" << std::setw(12) << "Deque"
+         << std::setw(12) << "Stack" << "\n";
+    cout << std::setw(10) << "" << std::setw(24) << "testa"
+         << std::setw(24) << "coda FIFO" << std::setw(24) << "pila" << "\n";
+
+    for (int n = 1 << 10; n <= 1 << 20; n <<= 2) {
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1)
+             << std::setw(12) << dequeFront(n);
+        // ArrayList::pushFront costa O(n): oltre 2^16 elementi
+        // il tempo di esecuzione diventerebbe eccessivo
+        if (n <= 1 << 16)
+            cout << std::setw(12) << listFront(n);
+        else
+            cout << std::setw(12) << "-";
+        cout << std::setw(12) << dequeFifo(n) << std::setw(12) << queueFifo(n)
+             << std::setw(12) << dequeStack(n) << std::setw(12) << stackStack(n)
+             << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include "ArrayDeque.h"
+using std::cout;
+using std::string;
+
+int main()
+{
+    ArrayDeque<int> deque;
+
+    cout << "\n************** TEST CLASSE ArrayDeque **************\n\n";
+
+    // stampa una deque vuota
+    cout << "Crea e tenta di stampare una deque vuota:\n";
+    deque.print();
+
+    // inserimenti alle due estremita'
+    for (int i = 1; i <= 5; ++i) {
+        deque.pushBack(i);
+        deque.pushFront(-i);
+    }
+    cout << "\nFUNZIONI pushFront E pushBack:\ninseriti 1..5 in coda "
+         << "e -1..-5 in testa\n" << deque;
+
+    // lettura degli estremi e accesso casuale
+    cout << "\nFUNZIONI front, back E read:\nfront(): " << deque.front()
+         << "\nback(): " << deque.back()
+         << "\nread(3): " << deque.read(3) << "\n";
+
+    // scrittura
+    deque.write(0, 100);
+    cout << "\nFUNZIONE write:\nscrive 100 in posizione 0\n" << deque;
+
+    // rimozioni alle due estremita'
+    deque.popFront();
+    deque.popBack();
+    cout << "\nFUNZIONI popFront E popBack:\n" << deque;
+
+    // i riferimenti restano validi dopo molti inserimenti,
+    // perche' gli elementi non vengono mai spostati
+    const int &ref = deque.front();
+    for (int i = 0; i < 10000; ++i) {
+        deque.pushFront(0);
+        deque.pushBack(0);
+    }
+    cout << "\nRIFERIMENTI STABILI:\nriferimento al primo elemento preso "
+         << "prima di 20000 inserimenti: " << ref << "\n";
+    for (int i = 0; i < 10000; ++i) {
+        deque.popFront();
+        deque.popBack();
+    }
+
+    // copia e uguaglianza
+    ArrayDeque<int> deque2(deque);
+    cout << "\nCOSTRUTTORE PER COPIA E OPERATORE ==\ndeque2:" << deque2
+         << "deque == deque2: " << (deque == deque2 ? "true" : "false") << "\n";
+    deque2.popFront();
+    cout << "dopo deque2.popFront(), deque == deque2: "
+         << (deque == deque2 ? "true" : "false") << "\n";
+
+    // scansione con un ciclo range-for
+    cout << "\nCICLO range-for:\n";
+    for (int x : deque.items())
+        cout << x << " ";
+    cout << "\n";
+
+    // deque di stringhe
+    ArrayDeque<string> words;
+    words.pushBack("segmentato");
+    words.pushFront("vettore");
+    words.emplaceBack(3, '!');
+    cout << "\nArrayDeque<string>:\n" << words;
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+}
\ No newline at end of file
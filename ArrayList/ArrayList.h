@@ -1,5 +1,14 @@
 // By Fabio Nardelli
-// lista implementata mediante vettore dinamico
+// lista implementata mediante vettore dinamico.
+// Il vettore e' allocato come memoria grezza (non inizializzata): gli elementi
+// vengono costruiti sul posto solo quando sono inseriti e distrutti quando
+// sono rimossi, per cui la crescita del vettore non costruisce per default
+// tutte le celle libere. Durante una riallocazione gli elementi vengono
+// spostati (o copiati, se il loro costruttore di spostamento puo' lanciare
+// eccezioni) nel nuovo vettore; per i tipi banalmente copiabili basta una memcpy.
+// Crescita e contrazione del vettore seguono la politica Growth
+// (vedi Utils/GrowthPolicy.h). Per i tipi aritmetici, le ricerche e il
+// confronto fra liste usano le istruzioni vettoriali della CPU (SimdSearch.h).
 
 #ifndef ARRAY_LIST_H
 #define ARRAY_LIST_H
@@ -7,33 +16,61 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
-
-template <typename T>
+#include <new>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include "../Utils/GrowthPolicy.h"
+#include "../Utils/Range.h"
+#include "SimdSearch.h"
+
+template <typename T, typename Growth = DefaultGrowth>
 class ArrayList;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const ArrayList<T> &);
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &, const ArrayList<T, Growth> &);
 
-template <typename T>
+template <typename T, typename Growth>
 class ArrayList {
-    friend std::ostream &operator<< <>(std::ostream &, const ArrayList<T> &);
+    friend std::ostream &operator<< <>(std::ostream &, const ArrayList<T, Growth> &);
 public:
     typedef int Position;
+    // iteratori ad accesso casuale (puntatori agli elementi del vettore)
+    typedef T *iterator;
+    typedef const T *const_iterator;
 
     // costruttore di default
-    ArrayList(int c = defaultCapacity) : size(0) { create(c); }
-    ArrayList(const ArrayList<T> &); // costruttore per copia
-    ~ArrayList() { delete [] array; } // distruttore
-    ArrayList<T> &operator=(const ArrayList<T> &);
+    ArrayList(int c = defaultCapacity)
+        : array(0), size(0), capacity(defaultCapacity) { create(c); }
+    ArrayList(const ArrayList<T, Growth> &); // costruttore per copia
+    ArrayList(ArrayList<T, Growth> &&); // costruttore di spostamento
+    ~ArrayList(); // distruttore
+    ArrayList<T, Growth> &operator=(const ArrayList<T, Growth> &);
+    ArrayList<T, Growth> &operator=(ArrayList<T, Growth> &&);
 
     // operatori
     // restituisce true se la lista e' vuota, false altrimenti
     bool isEmpty() const { return size == 0; }
     void print() const; // stampa la lista
-    void pushBack(T);  // inserisce un elemento in coda
-    void pushFront(T); // inserisce un elemento in testa
+    // inserisce un elemento in coda
+    void pushBack(const T &item) { emplaceAt(size, item); }
+    void pushBack(T &&item) { emplaceAt(size, std::move(item)); }
+    // costruisce un elemento in coda a partire dagli argomenti indicati
+    template <typename... Args>
+    void emplaceBack(Args &&... args)
+        { emplaceAt(size, std::forward<Args>(args)...); }
+    // inserisce un elemento in testa
+    void pushFront(const T &item) { emplaceAt(0, item); }
+    void pushFront(T &&item) { emplaceAt(0, std::move(item)); }
     // inserisce un elemento nella posizione precedente quella indicata
-    void insert(int, T);
+    void insert(Position pos, const T &item) { emplace(pos, item); }
+    void insert(Position pos, T &&item) { emplace(pos, std::move(item)); }
+    // costruisce un elemento nella posizione precedente quella indicata
+    // a partire dagli argomenti indicati
+    template <typename... Args>
+    void emplace(Position, Args &&...);
     void popBack(); // rimuove l'elemento in coda
     void popFront(); // rimuove l'elemento in testa
     // rimuove l'elemento precedente la posizione indicata
@@ -44,7 +81,22 @@ public:
     Position previous(Position) const;
     // cerca la posizione di un elemento.
     // Utile per le funzioni insert e remove
-    Position search(T) const;
+    Position search(const T &) const;
+    // restituisce la posizione del primo elemento per cui pred restituisce
+    // "true", oppure -1 se non ce ne sono. pred riceve un riferimento
+    // costante all'elemento, che quindi non viene copiato
+    template <typename Pred>
+    Position findIf(Pred pred) const;
+    // chiama f su ciascun elemento, dal primo all'ultimo, passandogli un
+    // riferimento all'elemento (costante se la lista e' costante)
+    template <typename F>
+    void forEach(F f);
+    template <typename F>
+    void forEach(F f) const;
+    // restituisce la lista delle posizioni di tutte le occorrenze di un elemento
+    ArrayList<Position> searchAll(const T &) const;
+    // restituisce il numero di occorrenze di un elemento
+    int count(const T &item) const { return simdCount(array, size, item); }
     // restituisce la posizione del primo elemento
     Position begin() const { return 0; }
     // restituisce la posizione dell'ultimo elemento
@@ -53,9 +105,31 @@ public:
     // alla fine della lista, "false" altrimenti
     bool finished(Position pos) const { return pos == size || pos == -1; }
     const T &read(Position) const; // legge l'elemento nella posizione indicata
-    void write(Position, T); // scrive nell'elemento nella posizione indicata
+    // scrive nell'elemento nella posizione indicata
+    void write(Position, const T &);
+    void write(Position, T &&);
     // operatore di uguaglianza ==
-    bool operator==(const ArrayList<T> &) const;
+    bool operator==(const ArrayList<T, Growth> &) const;
+    // restituisce il numero di elementi contenuti nella lista
+    int getSize() const { return size; }
+    // restituisce la capacita' dell'array
+    int getCapacity() const { return capacity; }
+    // porta la capacita' dell'array ad almeno n elementi
+    void reserve(int n);
+    // riduce la capacita' dell'array al numero di elementi contenuti
+    void shrinkToFit();
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo elemento, iend() la posizione successiva all'ultimo.
+    // Non effettuano controlli sui limiti
+    iterator ibegin() { return array; }
+    iterator iend() { return array + size; }
+    const_iterator ibegin() const { return array; }
+    const_iterator iend() const { return array + size; }
+    // consente di scandire la lista con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
 
 private:
     T *array; // puntatore usato per la rappresentazione dell'array che contiene la lista
@@ -64,14 +138,30 @@ private:
     int capacity; // dimensione dell'array
 
     static const int defaultCapacity = 16;
-    static const float minLoadFactor;
     void create(int); // crea una lista vuota
-};
 
-// costante che rappresenta il fattore di carico minimo al di sotto del quale
-// la dimensione del vettore viene dimezzata
-template <typename T>
-const float ArrayList<T>::minLoadFactor = .25;
+    // allocano e deallocano memoria non inizializzata per n elementi
+    static T *allocate(int n)
+        { return static_cast<T *>(::operator new(n * sizeof(T))); }
+    static void deallocate(T *p) { ::operator delete(p); }
+    // distrugge gli elementi di p nell'intervallo [first, last)
+    static void destroy(T *p, int first, int last);
+    // costruisce in dest gli n elementi di src, spostandoli se il costruttore
+    // di spostamento non lancia eccezioni, copiandoli altrimenti.
+    // Gli elementi di src non vengono distrutti
+    static void transfer(T *src, int n, T *dest, std::true_type);
+    static void transfer(T *src, int n, T *dest, std::false_type);
+    static void transfer(T *src, int n, T *dest)
+        { transfer(src, n, dest, std::is_trivially_copyable<T>()); }
+    // alloca un vettore di dimensione newCapacity e vi trasferisce gli elementi
+    void reallocate(int newCapacity);
+    // contrae il vettore se lo richiede la politica Growth
+    void shrinkIfNeeded();
+    // costruisce un elemento nella posizione indicata, spostando
+    // in avanti di un posto gli elementi successivi
+    template <typename... Args>
+    void emplaceAt(Position, Args &&...);
+};
 
 
 /*===========================================================================*/
@@ -79,16 +169,16 @@ const float ArrayList<T>::minLoadFactor = .25;
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const ArrayList<T> &l) 
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &output, const ArrayList<T, Growth> &l)
 {
     l.print();
     return output; // consente cout << a << b << c
 }
 
 // stampa la lista
-template <typename T>
-void ArrayList<T>::print() const
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::print() const
 {
     if (isEmpty()) {
         std::cout << "\n List is empty!\n";
@@ -106,95 +196,182 @@ void ArrayList<T>::print() const
 } 
 
 // funzione di inizializzazione
-template <typename T>
-void ArrayList<T>::create(int c) 
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::create(int c)
 {
     if (c > 0)
         capacity = c;
 
-    array = new T[capacity];
+    array = allocate(capacity);
+}
+
+// distrugge gli elementi nell'intervallo [first, last)
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::destroy(T *p, int first, int last)
+{
+    for (int i = first; i < last; ++i)
+        p[i].~T();
+}
+
+// trasferimento per i tipi banalmente copiabili: una sola memcpy
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::transfer(T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// trasferimento per i tipi generici. Se il costruttore di spostamento puo'
+// lanciare eccezioni gli elementi vengono copiati, in modo che un'eccezione
+// lasci intatto il vettore di partenza: gli elementi gia' costruiti in dest
+// vengono distrutti e l'eccezione e' rilanciata
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::transfer(T *src, int n, T *dest, std::false_type)
+{
+    int i = 0;
+    try {
+        for (; i < n; ++i)
+            new (dest + i) T(std::move_if_noexcept(src[i]));
+    } catch (...) {
+        destroy(dest, 0, i);
+        throw;
+    }
+}
+
+// alloca un vettore di dimensione newCapacity e vi trasferisce gli elementi.
+// Se il trasferimento fallisce la lista resta invariata
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::reallocate(int newCapacity)
+{
+    T *temp = allocate(newCapacity);
+    try {
+        transfer(array, size, temp);
+    } catch (...) {
+        deallocate(temp);
+        throw;
+    }
+    destroy(array, 0, size);
+    deallocate(array);
+    array = temp;
+    capacity = newCapacity;
 }
 
 // costruttore per copia
-template <typename T>
-ArrayList<T>::ArrayList(const ArrayList<T> &l) 
+template <typename T, typename Growth>
+ArrayList<T, Growth>::ArrayList(const ArrayList<T, Growth> &l)
+    : array(0), size(0), capacity(l.capacity)
 {
-    capacity = l.capacity;
+    array = allocate(capacity);
+    try {
+        std::uninitialized_copy(l.array, l.array + l.size, array);
+    } catch (...) {
+        deallocate(array);
+        throw;
+    }
     size = l.size;
-    array = new T[capacity];
+}
 
-    for (int i = 0; i < size; ++i)
-        array[i] = l.array[i];
+// costruttore di spostamento: si appropria del vettore di l, che resta vuota
+template <typename T, typename Growth>
+ArrayList<T, Growth>::ArrayList(ArrayList<T, Growth> &&l)
+    : array(l.array), size(l.size), capacity(l.capacity)
+{
+    l.array = 0;
+    l.size = 0;
+    l.capacity = 0;
+}
+
+// distruttore
+template <typename T, typename Growth>
+ArrayList<T, Growth>::~ArrayList()
+{
+    destroy(array, 0, size);
+    deallocate(array);
 }
 
 // overload dell'operatore di assegnazione =
-template <typename T>
-ArrayList<T> &ArrayList<T>::operator=(const ArrayList<T> &l) 
+template <typename T, typename Growth>
+ArrayList<T, Growth> &ArrayList<T, Growth>::operator=(const ArrayList<T, Growth> &l)
 {
     if (&l != this) { // evita l'autoassegnazione
-
-        if (capacity != l.capacity) { // se i due array hanno capacita'
-            delete [] array;          // diversa, dealloca quello di sinistra
-            capacity = l.capacity;    // e alloca un nuovo array di capacita'
-            array = new T[capacity];  // uguale a quello da copiare
-        }
-
-        size = l.size;
-
-        // copia gli elementi
-        for (int i = 0; i < size; ++i)
-            array[i] = l.array[i];
+        // costruisce prima la copia, in modo che un'eccezione
+        // lasci invariata questa lista
+        ArrayList<T, Growth> temp(l);
+        *this = std::move(temp);
     }
 
     return *this; // consente (a = b = c)
 }
 
-// inserisce un elemento in coda
-template <typename T>
-void ArrayList<T>::pushBack(T item) 
+// overload dell'operatore di assegnazione = per spostamento
+template <typename T, typename Growth>
+ArrayList<T, Growth> &ArrayList<T, Growth>::operator=(ArrayList<T, Growth> &&l)
 {
-    if (size < capacity) {  // se c'e' spazio nell'array
-        array[size] = item; // aggiunge semplicemente l'elemento
-    } else { // altrimenti alloca un nuovo array piu' grande
-        capacity *= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = 0; i < size; ++i)
-            temp[i] = array[i];
-        delete [] array;
-        temp[size] = item;
-        array = temp;
+    if (&l != this) { // evita l'autoassegnazione
+        std::swap(array, l.array);
+        std::swap(size, l.size);
+        std::swap(capacity, l.capacity);
     }
-    ++size;
+
+    return *this; // consente (a = b = c)
 }
 
-// inserisce un elemento in testa
-template <typename T>
-void ArrayList<T>::pushFront(T item) 
+// costruisce un elemento nella posizione indicata a partire da args.
+// Gli elementi dalla posizione pos in poi sono spostati in avanti di uno
+template <typename T, typename Growth>
+template <typename... Args>
+void ArrayList<T, Growth>::emplaceAt(Position pos, Args &&... args)
 {
     if (size < capacity) { // se c'e' spazio nell'array
-        // sposta tutti gli elementi in avanti di uno
-        for (int i = size; i > 0; --i)
-            array[i] = array[i - 1];
-        // e aggiunge il nuovo elemento in prima posizione
-        array[0] = item;
+        if (pos == size) { // inserimento in coda: costruisce sul posto
+            new (array + size) T(std::forward<Args>(args)...);
+        } else {
+            // costruisce prima il nuovo elemento, perche' gli argomenti
+            // potrebbero riferirsi a un elemento della lista stessa
+            T item(std::forward<Args>(args)...);
+            // sposta tutti gli elementi dalla posizione pos
+            // in poi in avanti di uno
+            new (array + size) T(std::move(array[size - 1]));
+            std::move_backward(array + pos, array + size - 1, array + size);
+            // e aggiunge il nuovo elemento alla posizione pos
+            array[pos] = std::move(item);
+        }
     } else { // altrimenti alloca un nuovo array piu' grande
-        capacity *= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = size; i > 0; --i)
-            temp[i] = array[i - 1];
-        delete [] array;
-        temp[0] = item;
+        int newCapacity = Growth::grow(capacity);
+        T *temp = allocate(newCapacity);
+        try {
+            // costruisce il nuovo elemento prima di trasferire i vecchi
+            new (temp + pos) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(temp);
+            throw;
+        }
+        int done = 0; // numero di elementi gia' trasferiti prima di pos
+        try {
+            // trasferisce gli elementi dal vecchio array al nuovo...
+            transfer(array, pos, temp);
+            done = pos;
+            // ...lasciando libera la posizione del nuovo elemento
+            transfer(array + pos, size - pos, temp + pos + 1);
+        } catch (...) {
+            destroy(temp, 0, done);
+            temp[pos].~T();
+            deallocate(temp);
+            throw;
+        }
+        destroy(array, 0, size);
+        deallocate(array);
         array = temp;
+        capacity = newCapacity;
     }
     ++size;
 }
 
-// inserisce un elemento nella posizione indicata. Gli elementi successivi
-// vengono spostati in avanti di un posto
-template <typename T>
-void ArrayList<T>::insert(Position pos, T item) 
+// costruisce un elemento nella posizione indicata a partire dagli
+// argomenti. Gli elementi successivi vengono spostati in avanti di un posto
+template <typename T, typename Growth>
+template <typename... Args>
+void ArrayList<T, Growth>::emplace(Position pos, Args &&... args)
 {
     if (((pos < 0 || pos >= size) && size > 0)
         || (pos < 0 && size == 0)) {
@@ -202,33 +379,39 @@ void ArrayList<T>::insert(Position pos, T item)
         return;
     }
 
-    if (size < capacity) { // se c'e' spazio nell'array
-        // sposta tutti gli elementi dalla posizione pos
-        // in poi in avanti di uno
-        for (int i = size; i > pos; --i)
-            array[i] = array[i - 1];
-        // e aggiunge il nuovo elemento alla posizione pos
-        array[pos] = item;
-    } else { // altrimenti alloca un nuovo array piu' grande
-        capacity *= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo...
-        for (int i = size; i > pos; --i)
-            temp[i] = array[i - 1];
-        temp[pos] = item; // ...inserendo il nuovo elemento
-        if (pos > 0)
-            for (int i = pos - 1; i >= 0; --i)
-                temp[i] = array[i];
-
-        delete [] array;
-        array = temp;
-    }
-    ++size;
+    // se la lista e' vuota inserisce in prima posizione
+    emplaceAt(size > 0 ? pos : 0, std::forward<Args>(args)...);
+}
+
+// se il fattore di carico scende alla soglia prevista dalla politica
+// Growth, contrae l'array (mai al di sotto della capacita' di default)
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::shrinkIfNeeded()
+{
+    if (Growth::shouldShrink(size, capacity, defaultCapacity))
+        reallocate(Growth::shrink(capacity, defaultCapacity));
+}
+
+// porta la capacita' dell'array ad almeno n elementi
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::reserve(int n)
+{
+    if (n > capacity)
+        reallocate(n);
+}
+
+// riduce la capacita' dell'array al numero di elementi contenuti
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::shrinkToFit()
+{
+    int newCapacity = size > 0 ? size : 1;
+    if (newCapacity < capacity)
+        reallocate(newCapacity);
 }
 
 // rimuove l'elemento in coda
-template <typename T>
-void ArrayList<T>::popBack() 
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::popBack()
 {
     if (isEmpty()) {
         std::cerr << "Cannot remove: List is empty!";
@@ -236,22 +419,13 @@ void ArrayList<T>::popBack()
     }
 
     --size;
-    // se il fattore di carico diventa <= 1/4
-    // dimezza la capacita' dell'array
-    if (static_cast<float>(size) / capacity <= minLoadFactor) {
-        capacity /= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = 0; i < size; ++i)
-            temp[i] = array[i];
-        delete [] array;
-        array = temp;
-    }
+    array[size].~T();
+    shrinkIfNeeded();
 }
 
 // rimuove l'elemento in testa
-template <typename T>
-void ArrayList<T>::popFront() 
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::popFront()
 {
     if (isEmpty()) {
         std::cerr << "Cannot pop: List is empty!";
@@ -259,25 +433,15 @@ void ArrayList<T>::popFront()
     }
 
     // scala tutti gli elementi a sinistra di una posizione
-    for (int i = 1; i < size; ++i)
-        array[i - 1] = array[i];
+    std::move(array + 1, array + size, array);
     --size;
-    // se il fattore di carico diventa <= minLoadFactor
-    // dimezza la capacita' dell'array
-    if (static_cast<float>(size) / capacity <= minLoadFactor) {
-        capacity /= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = 0; i < size; ++i)
-            temp[i] = array[i];
-        delete [] array;
-        array = temp;
-    }
+    array[size].~T();
+    shrinkIfNeeded();
 }
 
 // rimuove l'elemento alla posizione indicata
-template <typename T>
-void ArrayList<T>::remove(Position pos) 
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::remove(Position pos)
 {
     if (isEmpty()) {
         std::cerr << "Cannot remove: List is empty!";
@@ -295,20 +459,10 @@ void ArrayList<T>::remove(Position pos)
     else if (pos == size - 1)
         popBack();
     else { // se l'elemento da rimuovere e' interno
-        for (int i = pos; i + 1 < size; ++i)
-            array[i] = array[i + 1];
+        std::move(array + pos + 1, array + size, array + pos);
         --size;
-        // se il fattore di carico diventa <= minLoadFactor
-        // dimezza la capacita' dell'array
-        if (static_cast<float>(size) / capacity <= minLoadFactor) {
-            capacity /= 2;
-            T *temp = new T[capacity];
-            // copia gli elementi dal vecchio array al nuovo
-            for (int i = 0; i < size; ++i)
-                temp[i] = array[i];
-            delete [] array;
-            array = temp;
-        }
+        array[size].~T();
+        shrinkIfNeeded();
     }
 }
 
@@ -318,8 +472,8 @@ void ArrayList<T>::remove(Position pos)
 // Si puo' effettuare il controllo sui limiti con la funzione finished().
 // Le altre funzioni controllano la validita' della posizione, per cui non 
 // c'e' rischio di modificare o accedere ad aree di memoria fuori range. 
-template <typename T>
-typename ArrayList<T>::Position ArrayList<T>::next(Position pos) const 
+template <typename T, typename Growth>
+typename ArrayList<T, Growth>::Position ArrayList<T, Growth>::next(Position pos) const
 {
     if (pos >= 0 && pos < size)
         return ++pos;
@@ -333,8 +487,8 @@ typename ArrayList<T>::Position ArrayList<T>::next(Position pos) const
 // Si puo' effettuare il controllo sui limiti con la funzione finished().
 // Le altre funzioni controllano la validita' della posizione, per cui non 
 // c'e' rischio di modificare o accedere ad aree di memoria fuori range.  
-template <typename T>
-typename ArrayList<T>::Position ArrayList<T>::previous(Position pos) const 
+template <typename T, typename Growth>
+typename ArrayList<T, Growth>::Position ArrayList<T, Growth>::previous(Position pos) const
 {
     if (pos >= 0 && pos < size)
         return --pos;
@@ -345,22 +499,64 @@ typename ArrayList<T>::Position ArrayList<T>::previous(Position pos) const
 // cerca la prima occorrenza di un dato. Se lo trova,
 // restituisce la posizione dell'elemento corrispondente, 
 // altrimenti restituisce -1
-template <typename T>
-typename ArrayList<T>::Position ArrayList<T>::search(T item) const 
+template <typename T, typename Growth>
+typename ArrayList<T, Growth>::Position
+    ArrayList<T, Growth>::search(const T &item) const
 {
-    // se la lista e' vuota, termina la ricerca
-    if (isEmpty())
-        return -1;
-    int i;
-    for (i = 0; i < size && array[i] != item; ++i);
-    if (array[i] == item)
-        return i;
+    return simdFind(array, size, item);
+}
+
+// restituisce la posizione del primo elemento che soddisfa pred
+template <typename T, typename Growth>
+template <typename Pred>
+typename ArrayList<T, Growth>::Position
+    ArrayList<T, Growth>::findIf(Pred pred) const
+{
+    for (int i = 0; i < size; ++i)
+        if (pred(static_cast<const T &>(array[i])))
+            return i;
+
     return -1;
 }
 
+// chiama f su ciascun elemento della lista
+template <typename T, typename Growth>
+template <typename F>
+void ArrayList<T, Growth>::forEach(F f)
+{
+    for (int i = 0; i < size; ++i)
+        f(array[i]);
+}
+
+// come sopra, ma su una lista costante
+template <typename T, typename Growth>
+template <typename F>
+void ArrayList<T, Growth>::forEach(F f) const
+{
+    for (int i = 0; i < size; ++i)
+        f(static_cast<const T &>(array[i]));
+}
+
+// restituisce una lista contenente le posizioni di tutte le occorrenze
+// di un dato, in ordine crescente
+template <typename T, typename Growth>
+ArrayList<typename ArrayList<T, Growth>::Position>
+    ArrayList<T, Growth>::searchAll(const T &item) const
+{
+    ArrayList<Position> positions;
+    // riprende ogni volta la ricerca dall'elemento successivo all'ultima
+    // occorrenza trovata
+    int i = 0, found;
+    while (i < size && (found = simdFind(array + i, size - i, item)) >= 0) {
+        positions.pushBack(i + found);
+        i += found + 1;
+    }
+    return positions;
+}
+
 // legge il dato contenuto nell'elemento indicato
-template <typename T>
-const T &ArrayList<T>::read(Position pos) const 
+template <typename T, typename Growth>
+const T &ArrayList<T, Growth>::read(Position pos) const
 {
     if (isEmpty())
         throw std::domain_error("List is empty!");
@@ -373,8 +569,8 @@ const T &ArrayList<T>::read(Position pos) const
 }
 
 // scrive nell'elemento indicato
-template <typename T>
-void ArrayList<T>::write(Position pos, T item) 
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::write(Position pos, const T &item)
 {
     if (pos < 0 || pos >= size) {
         std::cerr << "Invalid position! "
@@ -385,9 +581,22 @@ void ArrayList<T>::write(Position pos, T item)
     }
 }
 
+// come sopra, ma sposta il dato indicato invece di copiarlo
+template <typename T, typename Growth>
+void ArrayList<T, Growth>::write(Position pos, T &&item)
+{
+    if (pos < 0 || pos >= size) {
+        std::cerr << "Invalid position! "
+            << "Position must be 0 - (size - 1)";
+        return;
+    } else {
+        array[pos] = std::move(item);
+    }
+}
+
 // overload dell'operatore di uguaglianza ==
-template <typename T>
-bool ArrayList<T>::operator==(const ArrayList<T> &l) const 
+template <typename T, typename Growth>
+bool ArrayList<T, Growth>::operator==(const ArrayList<T, Growth> &l) const
 {
     // se le liste sono entrambe vuote, allora sono uguali
     if (isEmpty() && l.isEmpty())
@@ -409,15 +618,7 @@ bool ArrayList<T>::operator==(const ArrayList<T> &l) const
 
     // controllo esaustivo su ciascun elemento dal secondo al penultimo
     // (il primo e l'ultimo sono gia' stati controllati sopra)
-    int i = 1;
-    while (i < size - 1) {
-        if (array[i] != l.array[i])
-            return false;
-
-        ++i;
-    }
-
-    return true; // se l'esecuzione arriva qui, le due liste sono uguali
+    return simdEqual(array + 1, l.array + 1, size - 2);
 }
 
 #endif
@@ -0,0 +1,487 @@
+// By Fabio Nardelli
+// Ricerca e confronto vettoriali (SSE2/AVX2) su array di tipi aritmetici,
+// usati dalla classe ArrayList (ovviamente possono essere usati da qualunque
+// classe). Le funzioni
+//   simdFind(a, n, v)   restituisce l'indice del primo elemento uguale a v,
+//                       -1 se non c'e';
+//   simdCount(a, n, v)  restituisce il numero di elementi uguali a v;
+//   simdEqual(a, b, n)  restituisce true se i due array sono uguali
+// accettano qualunque tipo T: per interi (1, 2, 4 e 8 byte), float e double
+// scelgono a tempo di esecuzione il kernel AVX2 o SSE2, in base a quanto
+// supportato dalla CPU, negli altri casi (o se il compilatore non e' GCC/Clang
+// su x86) eseguono una normale scansione con l'operatore ==.
+// I float sono confrontati con le istruzioni di confronto in virgola mobile,
+// per cui NaN != NaN e 0.0 == -0.0, esattamente come con l'operatore ==.
+// Il confronto di array di interi, enum e puntatori usa memcmp.
+
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/*=============================  VERSIONI SCALARI  ==========================*/
+
+template <typename T>
+int scalarFind(const T *a, int n, const T &v)
+{
+    for (int i = 0; i < n; ++i)
+        if (a[i] == v)
+            return i;
+    return -1;
+}
+
+template <typename T>
+int scalarCount(const T *a, int n, const T &v)
+{
+    int count = 0;
+    for (int i = 0; i < n; ++i)
+        if (a[i] == v)
+            ++count;
+    return count;
+}
+
+template <typename T>
+bool scalarEqual(const T *a, const T *b, int n)
+{
+    for (int i = 0; i < n; ++i)
+        if (a[i] != b[i])
+            return false;
+    return true;
+}
+
+#ifdef SIMD_SEARCH_X86
+
+/*===========================  DESCRITTORI DI LANE  =========================*/
+
+// Ciascun descrittore indica come caricare un vettore di elementi di tipo T,
+// replicare un valore su tutte le lane e ottenere una maschera con un bit per
+// ogni elemento uguale (bit i = elemento i). lanes e' il numero di elementi
+// contenuti in un registro, fullMask la maschera con tutti i bit accesi.
+
+// descrittore nullo: nessun kernel disponibile per il tipo
+struct NoLanes { };
+
+template <typename T>
+struct Sse2Int8 {
+    typedef T Elem;
+    typedef __m128i Vec;
+    static const int lanes = 16;
+    static const unsigned fullMask = 0xFFFF;
+    __attribute__((target("sse2"))) static Vec load(const T *p)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    __attribute__((target("sse2"))) static Vec set1(T v)
+        { return _mm_set1_epi8(static_cast<char>(v)); }
+    __attribute__((target("sse2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+};
+
+template <typename T>
+struct Sse2Int16 {
+    typedef T Elem;
+    typedef __m128i Vec;
+    static const int lanes = 8;
+    static const unsigned fullMask = 0xFF;
+    __attribute__((target("sse2"))) static Vec load(const T *p)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    __attribute__((target("sse2"))) static Vec set1(T v)
+        { return _mm_set1_epi16(static_cast<short>(v)); }
+    // impacchetta i risultati a 16 bit in byte per avere un bit per elemento
+    __attribute__((target("sse2"))) static unsigned eqMask(Vec a, Vec b)
+    {
+        return _mm_movemask_epi8(_mm_packs_epi16(_mm_cmpeq_epi16(a, b),
+            _mm_setzero_si128()));
+    }
+};
+
+template <typename T>
+struct Sse2Int32 {
+    typedef T Elem;
+    typedef __m128i Vec;
+    static const int lanes = 4;
+    static const unsigned fullMask = 0xF;
+    __attribute__((target("sse2"))) static Vec load(const T *p)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    __attribute__((target("sse2"))) static Vec set1(T v)
+        { return _mm_set1_epi32(static_cast<int>(v)); }
+    __attribute__((target("sse2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+};
+
+struct Sse2Float {
+    typedef float Elem;
+    typedef __m128 Vec;
+    static const int lanes = 4;
+    static const unsigned fullMask = 0xF;
+    __attribute__((target("sse2"))) static Vec load(const float *p)
+        { return _mm_loadu_ps(p); }
+    __attribute__((target("sse2"))) static Vec set1(float v)
+        { return _mm_set1_ps(v); }
+    __attribute__((target("sse2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+};
+
+struct Sse2Double {
+    typedef double Elem;
+    typedef __m128d Vec;
+    static const int lanes = 2;
+    static const unsigned fullMask = 0x3;
+    __attribute__((target("sse2"))) static Vec load(const double *p)
+        { return _mm_loadu_pd(p); }
+    __attribute__((target("sse2"))) static Vec set1(double v)
+        { return _mm_set1_pd(v); }
+    __attribute__((target("sse2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+};
+
+template <typename T>
+struct Avx2Int8 {
+    typedef T Elem;
+    typedef __m256i Vec;
+    static const int lanes = 32;
+    static const unsigned fullMask = 0xFFFFFFFFu;
+    __attribute__((target("avx2"))) static Vec load(const T *p)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    __attribute__((target("avx2"))) static Vec set1(T v)
+        { return _mm256_set1_epi8(static_cast<char>(v)); }
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+    {
+        return static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+};
+
+template <typename T>
+struct Avx2Int16 {
+    typedef T Elem;
+    typedef __m256i Vec;
+    static const int lanes = 16;
+    static const unsigned fullMask = 0xFFFF;
+    __attribute__((target("avx2"))) static Vec load(const T *p)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    __attribute__((target("avx2"))) static Vec set1(T v)
+        { return _mm256_set1_epi16(static_cast<short>(v)); }
+    // _mm256_packs_epi16 lavora sulle due meta' da 128 bit separatamente:
+    // gli elementi 0-7 finiscono nei bit 0-7 della maschera, gli 8-15
+    // nei bit 16-23
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+    {
+        unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_packs_epi16(_mm256_cmpeq_epi16(a, b),
+                _mm256_setzero_si256())));
+        return (m & 0xFF) | ((m >> 8) & 0xFF00);
+    }
+};
+
+template <typename T>
+struct Avx2Int32 {
+    typedef T Elem;
+    typedef __m256i Vec;
+    static const int lanes = 8;
+    static const unsigned fullMask = 0xFF;
+    __attribute__((target("avx2"))) static Vec load(const T *p)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    __attribute__((target("avx2"))) static Vec set1(T v)
+        { return _mm256_set1_epi32(static_cast<int>(v)); }
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+    {
+        return _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    }
+};
+
+template <typename T>
+struct Avx2Int64 {
+    typedef T Elem;
+    typedef __m256i Vec;
+    static const int lanes = 4;
+    static const unsigned fullMask = 0xF;
+    __attribute__((target("avx2"))) static Vec load(const T *p)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    __attribute__((target("avx2"))) static Vec set1(T v)
+        { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+    {
+        return _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+    }
+};
+
+struct Avx2Float {
+    typedef float Elem;
+    typedef __m256 Vec;
+    static const int lanes = 8;
+    static const unsigned fullMask = 0xFF;
+    __attribute__((target("avx2"))) static Vec load(const float *p)
+        { return _mm256_loadu_ps(p); }
+    __attribute__((target("avx2"))) static Vec set1(float v)
+        { return _mm256_set1_ps(v); }
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+};
+
+struct Avx2Double {
+    typedef double Elem;
+    typedef __m256d Vec;
+    static const int lanes = 4;
+    static const unsigned fullMask = 0xF;
+    __attribute__((target("avx2"))) static Vec load(const double *p)
+        { return _mm256_loadu_pd(p); }
+    __attribute__((target("avx2"))) static Vec set1(double v)
+        { return _mm256_set1_pd(v); }
+    __attribute__((target("avx2"))) static unsigned eqMask(Vec a, Vec b)
+        { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+};
+
+// associa a ciascun tipo i descrittori SSE2 e AVX2. Gli interi a 64 bit non
+// hanno un confronto SSE2 (_mm_cmpeq_epi64 richiede SSE4.1): senza AVX2
+// usano la versione scalare
+template <typename T, int Size = sizeof(T),
+          bool Integral = std::is_integral<T>::value>
+struct SimdLanes { typedef NoLanes Sse2; typedef NoLanes Avx2; };
+
+template <typename T>
+struct SimdLanes<T, 1, true>
+    { typedef Sse2Int8<T> Sse2; typedef Avx2Int8<T> Avx2; };
+template <typename T>
+struct SimdLanes<T, 2, true>
+    { typedef Sse2Int16<T> Sse2; typedef Avx2Int16<T> Avx2; };
+template <typename T>
+struct SimdLanes<T, 4, true>
+    { typedef Sse2Int32<T> Sse2; typedef Avx2Int32<T> Avx2; };
+template <typename T>
+struct SimdLanes<T, 8, true>
+    { typedef NoLanes Sse2; typedef Avx2Int64<T> Avx2; };
+template <>
+struct SimdLanes<float, sizeof(float), false>
+    { typedef Sse2Float Sse2; typedef Avx2Float Avx2; };
+template <>
+struct SimdLanes<double, sizeof(double), false>
+    { typedef Sse2Double Sse2; typedef Avx2Double Avx2; };
+
+/*================================  KERNEL  =================================*/
+
+// I kernel sono duplicati per SSE2 e AVX2 perche' l'attributo target deve
+// essere indicato sulla funzione che usa le istruzioni del relativo set.
+// La parte finale dell'array, piu' corta di un registro, e' scandita
+// con la versione scalare.
+
+template <typename L>
+struct Sse2Kernels {
+    typedef typename L::Elem T;
+
+    __attribute__((target("sse2")))
+    static int find(const T *a, int n, T v)
+    {
+        typename L::Vec vv = L::set1(v);
+        int i = 0;
+        for (; i + L::lanes <= n; i += L::lanes) {
+            unsigned m = L::eqMask(L::load(a + i), vv);
+            if (m)
+                return i + __builtin_ctz(m);
+        }
+        int j = scalarFind(a + i, n - i, v);
+        return j < 0 ? -1 : i + j;
+    }
+
+    __attribute__((target("sse2")))
+    static int count(const T *a, int n, T v)
+    {
+        typename L::Vec vv = L::set1(v);
+        int count = 0, i = 0;
+        for (; i + L::lanes <= n; i += L::lanes)
+            count += __builtin_popcount(L::eqMask(L::load(a + i), vv));
+        return count + scalarCount(a + i, n - i, v);
+    }
+
+    __attribute__((target("sse2")))
+    static bool equal(const T *a, const T *b, int n)
+    {
+        int i = 0;
+        for (; i + L::lanes <= n; i += L::lanes)
+            if (L::eqMask(L::load(a + i), L::load(b + i)) != L::fullMask)
+                return false;
+        return scalarEqual(a + i, b + i, n - i);
+    }
+};
+
+template <typename L>
+struct Avx2Kernels {
+    typedef typename L::Elem T;
+
+    __attribute__((target("avx2")))
+    static int find(const T *a, int n, T v)
+    {
+        typename L::Vec vv = L::set1(v);
+        int i = 0;
+        for (; i + L::lanes <= n; i += L::lanes) {
+            unsigned m = L::eqMask(L::load(a + i), vv);
+            if (m)
+                return i + __builtin_ctz(m);
+        }
+        int j = scalarFind(a + i, n - i, v);
+        return j < 0 ? -1 : i + j;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static int count(const T *a, int n, T v)
+    {
+        typename L::Vec vv = L::set1(v);
+        int count = 0, i = 0;
+        for (; i + L::lanes <= n; i += L::lanes)
+            count += __builtin_popcount(L::eqMask(L::load(a + i), vv));
+        return count + scalarCount(a + i, n - i, v);
+    }
+
+    __attribute__((target("avx2")))
+    static bool equal(const T *a, const T *b, int n)
+    {
+        int i = 0;
+        for (; i + L::lanes <= n; i += L::lanes)
+            if (L::eqMask(L::load(a + i), L::load(b + i)) != L::fullMask)
+                return false;
+        return scalarEqual(a + i, b + i, n - i);
+    }
+};
+
+// supporto delle estensioni da parte della CPU, verificato una sola volta
+inline bool cpuHasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2")
+        && __builtin_cpu_supports("popcnt");
+    return avx2;
+}
+
+inline bool cpuHasSse2()
+{
+    static const bool sse2 = __builtin_cpu_supports("sse2");
+    return sse2;
+}
+
+// sceglie il kernel in base alla CPU. La specializzazione parziale
+// per NoLanes ricade sul livello inferiore (o sulla versione scalare)
+template <typename T, typename Sse2 = typename SimdLanes<T>::Sse2,
+          typename Avx2 = typename SimdLanes<T>::Avx2>
+struct SimdDispatch {
+    static int find(const T *a, int n, const T &v)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::find(a, n, v);
+        if (cpuHasSse2())
+            return Sse2Kernels<Sse2>::find(a, n, v);
+        return scalarFind(a, n, v);
+    }
+
+    static int count(const T *a, int n, const T &v)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::count(a, n, v);
+        if (cpuHasSse2())
+            return Sse2Kernels<Sse2>::count(a, n, v);
+        return scalarCount(a, n, v);
+    }
+
+    static bool equal(const T *a, const T *b, int n)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::equal(a, b, n);
+        if (cpuHasSse2())
+            return Sse2Kernels<Sse2>::equal(a, b, n);
+        return scalarEqual(a, b, n);
+    }
+};
+
+template <typename T, typename Avx2>
+struct SimdDispatch<T, NoLanes, Avx2> {
+    static int find(const T *a, int n, const T &v)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::find(a, n, v);
+        return scalarFind(a, n, v);
+    }
+
+    static int count(const T *a, int n, const T &v)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::count(a, n, v);
+        return scalarCount(a, n, v);
+    }
+
+    static bool equal(const T *a, const T *b, int n)
+    {
+        if (cpuHasAvx2())
+            return Avx2Kernels<Avx2>::equal(a, b, n);
+        return scalarEqual(a, b, n);
+    }
+};
+
+template <typename T>
+struct SimdDispatch<T, NoLanes, NoLanes> {
+    static int find(const T *a, int n, const T &v)
+        { return scalarFind(a, n, v); }
+    static int count(const T *a, int n, const T &v)
+        { return scalarCount(a, n, v); }
+    static bool equal(const T *a, const T *b, int n)
+        { return scalarEqual(a, b, n); }
+};
+
+#else
+
+// su architetture diverse da x86 si usano solo le versioni scalari
+template <typename T>
+struct SimdDispatch {
+    static int find(const T *a, int n, const T &v)
+        { return scalarFind(a, n, v); }
+    static int count(const T *a, int n, const T &v)
+        { return scalarCount(a, n, v); }
+    static bool equal(const T *a, const T *b, int n)
+        { return scalarEqual(a, b, n); }
+};
+
+#endif
+
+/*=============================  INTERFACCIA  ===============================*/
+
+// restituisce l'indice del primo elemento di a uguale a v, -1 se non c'e'
+template <typename T>
+int simdFind(const T *a, int n, const T &v)
+{
+    return SimdDispatch<T>::find(a, n, v);
+}
+
+// restituisce il numero di elementi di a uguali a v
+template <typename T>
+int simdCount(const T *a, int n, const T &v)
+{
+    return SimdDispatch<T>::count(a, n, v);
+}
+
+// confronto bit a bit: valido per i tipi in cui l'uguaglianza coincide con
+// l'uguaglianza della rappresentazione in memoria (interi, enum, puntatori)
+template <typename T>
+bool simdEqual(const T *a, const T *b, int n, std::true_type)
+{
+    return n <= 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+}
+
+template <typename T>
+bool simdEqual(const T *a, const T *b, int n, std::false_type)
+{
+    return SimdDispatch<T>::equal(a, b, n);
+}
+
+// restituisce true se i primi n elementi di a e b sono uguali
+template <typename T>
+bool simdEqual(const T *a, const T *b, int n)
+{
+    return simdEqual(a, b, n, std::integral_constant<bool,
+        std::is_integral<T>::value || std::is_enum<T>::value
+        || std::is_pointer<T>::value>());
+}
+
+#endif
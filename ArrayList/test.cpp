@@ -1,6 +1,9 @@
 #include <iostream>
+#include <algorithm>
+#include <string>
 #include "ArrayList.h"
 using std::cout;
+using std::string;
 
 int main()
 {
@@ -63,6 +66,46 @@ int main()
     cout << "\nFUNZIONI popFront E popBack\nRimossi primo e ultimo"
          << " elemento\n" << list;
 
+    // inserimento per spostamento e costruzione sul posto
+    ArrayList<string> words(2);
+    string word("Pippo");
+    words.pushBack(word);
+    words.pushBack(string("Pluto"));
+    words.emplaceBack(3, 'a');
+    words.pushFront("Paperino");
+    words.insert(words.end(), "Topolino");
+    cout << "\nFUNZIONI pushBack(T&&) E emplaceBack\nCrea una lista di stringhe"
+         << " di capacita' 2 e la fa crescere inserendo 5 elementi:\n"
+         << "'Pippo'(copia), 'Pluto'(spostamento), 'aaa'(costruito sul posto),"
+         << " 'Paperino'(in testa), 'Topolino'(prima dell'ultimo)\n" << words;
+
+    // iteratori: range-for e algoritmi della libreria standard
+    ArrayList<int> list4;
+    for (int i = 10; i > 0; --i)
+        list4.pushBack(i * 3 % 7);
+    cout << "\nITERATORI\nCrea una lista 'list4'" << list4;
+    std::sort(list4.ibegin(), list4.iend());
+    cout << "Ordinata con std::sort:\n";
+    for (int x : list4.items())
+        cout << x << " ";
+    cout << "\n";
+
+    // ricerca di tutte le occorrenze e conteggio
+    ArrayList<int> all = list4.searchAll(3);
+    cout << "\nFUNZIONI searchAll E count\nPosizioni dell'elemento 3 in 'list4':"
+         << all << "Occorrenze dell'elemento 6: " << list4.count(6) << "\n";
+
+    // ricerca con un predicato e visita degli elementi per riferimento
+    words.emplace(1, 3, 'b');
+    cout << "\nFUNZIONI emplace, findIf E forEach\nemplace(1, 3, 'b') costruisce"
+         << " la stringa \"bbb\" direttamente in seconda posizione:" << words;
+    ArrayList<string>::Position longWord =
+        words.findIf([](const string &w) { return w.size() > 6; });
+    cout << "prima parola con piu' di 6 lettere (findIf): "
+         << words.read(longWord) << "\n";
+    words.forEach([](string &w) { w += "!"; });
+    cout << "forEach aggiunge '!' a ogni parola senza copiarle:" << words;
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
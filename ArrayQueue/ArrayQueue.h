@@ -1,5 +1,12 @@
 // By Fabio Nardelli
-// coda FIFO implementata mediante vettore circolare
+// coda FIFO implementata mediante vettore circolare.
+// La capacita' del vettore e' sempre una potenza di 2, per cui la posizione
+// di un elemento si ottiene con una maschera di bit invece che con il resto
+// della divisione. Quando il vettore e' pieno, enqueue ne alloca uno di
+// capacita' doppia e vi copia la coda "srotolata" (la testa in posizione 0).
+// enqueueN e dequeueN inseriscono e rimuovono piu' elementi alla volta: gli
+// elementi occupano al piu' due intervalli contigui del vettore, per cui per
+// i tipi banalmente copiabili bastano al piu' due memcpy.
 
 #ifndef ARRAY_QUEUE_H
 #define ARRAY_QUEUE_H
@@ -7,6 +14,13 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <limits>
+#include "../Utils/Range.h"
 
 template <typename T>
 class ArrayQueue;
@@ -17,8 +31,15 @@ std::ostream &operator<<(std::ostream &, const ArrayQueue<T> &);
 template <typename T>
 class ArrayQueue {
     friend std::ostream &operator<< <>(std::ostream &, const ArrayQueue<T> &);
+    template <typename V> class BasicIterator;
 public:
-    ArrayQueue(int c = defaultCapacity) : head(0), size(0) { create(c); }
+    // iteratori ad accesso casuale, dall'elemento da piu' tempo in coda
+    // al piu' recente
+    typedef BasicIterator<T> iterator;
+    typedef BasicIterator<const T> const_iterator;
+
+    ArrayQueue(int c = defaultCapacity)
+        : head(0), size(0), capacity(defaultCapacity) { create(c); }
     ArrayQueue(const ArrayQueue<T> &); // costruttore per copia
     ~ArrayQueue() { delete [] array; } // distruttore
     ArrayQueue<T> &operator=(const ArrayQueue<T> &);
@@ -29,18 +50,115 @@ public:
     void print() const; // stampa la coda
     void enqueue(T); // inserisce un elemento in coda
     void dequeue(); // elimina l'elemento da piu' tempo in coda
+    // inserisce in coda gli n elementi del vettore indicato
+    void enqueueN(const T *, int n);
+    // rimuove fino a n elementi dalla testa della coda e li sposta nel
+    // vettore indicato. Restituisce il numero di elementi rimossi
+    int dequeueN(T *, int n);
     T top() const; // legge l'elemento da piu' tempo in coda
     // operatore di uguaglianza
     bool operator==(const ArrayQueue<T> &) const;
 
+    // iteratori compatibili con la libreria standard: ibegin() indica
+    // l'elemento di testa, iend() la posizione successiva all'ultimo
+    iterator ibegin() { return iterator(array, capacity - 1, head, 0); }
+    iterator iend() { return iterator(array, capacity - 1, head, size); }
+    const_iterator ibegin() const
+        { return const_iterator(array, capacity - 1, head, 0); }
+    const_iterator iend() const
+        { return const_iterator(array, capacity - 1, head, size); }
+    // consente di scandire la coda con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
+
 private:
     T *array; // puntatore per rappresentare l'array circolare che contiene la coda
     int head; // posizione dell'elemento di testa
     int size; // numero di elementi contenuti nell'array, e' la
               // dimensione della coda come appare all'utente
-    int capacity; // dimensione dell'array
+    int capacity; // dimensione dell'array (potenza di 2)
     static const int defaultCapacity = 16; // dimensione di default
+    // capacita' massima: la piu' grande potenza di 2 rappresentabile in un int
+    static const int maxCapacity = std::numeric_limits<int>::max() / 2 + 1;
     void create(int); // funzione di inizializzazione
+
+    // restituisce la posizione nel vettore dell'elemento di indice logico i
+    int slot(int i) const { return (head + i) & (capacity - 1); }
+    // restituisce la piu' piccola potenza di 2 maggiore o uguale a c
+    // (lancia std::length_error se supera maxCapacity)
+    static int roundCapacity(int c);
+    // copiano o spostano n elementi contigui da src a dest: per i tipi
+    // banalmente copiabili usano memcpy
+    static void copySpan(const T *src, int n, T *dest, std::true_type);
+    static void copySpan(const T *src, int n, T *dest, std::false_type);
+    static void copySpan(const T *src, int n, T *dest)
+        { copySpan(src, n, dest, std::is_trivially_copyable<T>()); }
+    static void moveSpan(T *src, int n, T *dest, std::true_type);
+    static void moveSpan(T *src, int n, T *dest, std::false_type);
+    static void moveSpan(T *src, int n, T *dest)
+        { moveSpan(src, n, dest, std::is_trivially_copyable<T>()); }
+    // copia gli elementi di q all'inizio del vettore
+    void copyFrom(const ArrayQueue<T> &);
+    // porta la capacita' ad almeno c elementi, srotolando la coda
+    void grow(int c);
+};
+
+// iteratore ad accesso casuale sul vettore circolare: memorizza l'indice
+// logico dell'elemento (0 = testa) e lo converte nella posizione nel vettore
+// solo quando l'elemento viene letto
+template <typename T>
+template <typename V>
+class ArrayQueue<T>::BasicIterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_cv<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    BasicIterator() : array(0), mask(0), head(0), index(0) { }
+    BasicIterator(V *a, int m, int h, int i)
+        : array(a), mask(m), head(h), index(i) { }
+    // conversione da iteratore a iteratore costante
+    operator BasicIterator<const V>() const
+        { return BasicIterator<const V>(array, mask, head, index); }
+
+    reference operator*() const { return array[(head + index) & mask]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const
+        { return array[(head + index + n) & mask]; }
+
+    BasicIterator &operator++() { ++index; return *this; }
+    BasicIterator operator++(int)
+        { BasicIterator old(*this); ++index; return old; }
+    BasicIterator &operator--() { --index; return *this; }
+    BasicIterator operator--(int)
+        { BasicIterator old(*this); --index; return old; }
+    BasicIterator &operator+=(difference_type n)
+        { index += static_cast<int>(n); return *this; }
+    BasicIterator &operator-=(difference_type n)
+        { index -= static_cast<int>(n); return *this; }
+    BasicIterator operator+(difference_type n) const
+        { BasicIterator it(*this); return it += n; }
+    BasicIterator operator-(difference_type n) const
+        { BasicIterator it(*this); return it -= n; }
+    friend BasicIterator operator+(difference_type n, const BasicIterator &it)
+        { return it + n; }
+    difference_type operator-(const BasicIterator &it) const
+        { return index - it.index; }
+
+    bool operator==(const BasicIterator &it) const { return index == it.index; }
+    bool operator!=(const BasicIterator &it) const { return index != it.index; }
+    bool operator<(const BasicIterator &it) const { return index < it.index; }
+    bool operator>(const BasicIterator &it) const { return index > it.index; }
+    bool operator<=(const BasicIterator &it) const { return index <= it.index; }
+    bool operator>=(const BasicIterator &it) const { return index >= it.index; }
+private:
+    V *array; // vettore circolare
+    int mask; // dimensione del vettore - 1
+    int head; // posizione dell'elemento di testa
+    int index; // indice logico dell'elemento corrente
 };
 
 /*===========================================================================*/
@@ -67,7 +185,7 @@ void ArrayQueue<T>::print() const
     std::cout << "\n [";
 
     for (int i = 0; i < size; ++i) {
-        std::cout << std::setw(3) << array[(i + head) % capacity] << " ";
+        std::cout << std::setw(3) << array[slot(i)] << " ";
         // va a capo ogni 5 elementi, tranne dopo l'ultimo
         if ((i + 1) % 5 == 0 && i != size - 1)
             std::cout << "\n  ";
@@ -75,28 +193,102 @@ void ArrayQueue<T>::print() const
     std::cout << " ]\n";
 } 
 
-// funzione di inizializzazione
+// funzione di inizializzazione: la capacita' viene arrotondata
+// alla potenza di 2 successiva
 template <typename T>
 void ArrayQueue<T>::create(int c) 
 {
     if (c > 0)
-        capacity = c;
+        capacity = roundCapacity(c);
 
     array = new T[capacity];
 }
 
+// restituisce la piu' piccola potenza di 2 maggiore o uguale a c. Oltre
+// maxCapacity il raddoppio di r traboccherebbe
+template <typename T>
+int ArrayQueue<T>::roundCapacity(int c)
+{
+    if (c > maxCapacity)
+        throw std::length_error("Queue capacity overflow!");
+
+    int r = 1;
+    while (r < c)
+        r <<= 1;
+    return r;
+}
+
+// copia per i tipi banalmente copiabili
+template <typename T>
+void ArrayQueue<T>::copySpan(const T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// copia per i tipi generici
+template <typename T>
+void ArrayQueue<T>::copySpan(const T *src, int n, T *dest, std::false_type)
+{
+    std::copy(src, src + n, dest);
+}
+
+// spostamento per i tipi banalmente copiabili
+template <typename T>
+void ArrayQueue<T>::moveSpan(T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// spostamento per i tipi generici
+template <typename T>
+void ArrayQueue<T>::moveSpan(T *src, int n, T *dest, std::false_type)
+{
+    std::move(src, src + n, dest);
+}
+
+// copia gli elementi di q (escludendo quelli cancellati) all'inizio del
+// vettore, che deve avere capacita' sufficiente. Gli elementi di q occupano
+// due intervalli: dalla testa alla fine del vettore e dall'inizio del vettore
+template <typename T>
+void ArrayQueue<T>::copyFrom(const ArrayQueue<T> &q)
+{
+    int first = std::min(q.size, q.capacity - q.head);
+    copySpan(q.array + q.head, first, array);
+    copySpan(q.array, q.size - first, array + first);
+    size = q.size;
+    head = 0;
+}
+
+// alloca un vettore di capacita' pari alla potenza di 2 successiva a c
+// e vi sposta gli elementi, con la testa in posizione 0
+template <typename T>
+void ArrayQueue<T>::grow(int c)
+{
+    int newCapacity = roundCapacity(c);
+    T *temp = new T[newCapacity];
+    try {
+        int first = std::min(size, capacity - head);
+        moveSpan(array + head, first, temp);
+        moveSpan(array, size - first, temp + first);
+    } catch (...) {
+        delete [] temp;
+        throw;
+    }
+    delete [] array;
+    array = temp;
+    capacity = newCapacity;
+    head = 0;
+}
+
 // costruttore per copia
 template <typename T>
 ArrayQueue<T>::ArrayQueue(const ArrayQueue<T> &q)
 {
     capacity = q.capacity;
-    size = q.size;
-    head = 0;
     array = new T[capacity];
-
-    // copia gli elementi (escludendo quelli cancellati)
-    for (int i = 0; i < size; ++i)
-        array[i] = q.array[(i + q.head) % capacity];
+    copyFrom(q);
 }
 
 // overload dell'operatore di assegnazione =
@@ -110,30 +302,66 @@ ArrayQueue<T> &ArrayQueue<T>::operator=(const ArrayQueue<T> &q)
             array = new T[capacity];  // a quello da copiare
         }
 
-        size = q.size;
-        head = 0;
-
-        // copia gli elementi (escludendo quelli cancellati)
-        for (int i = 0; i < size; ++i)
-            array[i] = q.array[(i + q.head) % capacity];
+        copyFrom(q);
     }
 
     return *this; // consente (a = b = c)
 }
 
 // inserisce un elemento in coda
+// (se il vettore e' pieno, ne raddoppia la capacita': la potenza di 2
+// successiva a capacity + 1 e' 2 * capacity, calcolata senza traboccare)
 template <typename T>
 void ArrayQueue<T>::enqueue(T item)
 {
-    if (size == capacity) {
-        std::cerr << "Cannot enqueue: Queue is full!\n";
-        return;
-    }
+    if (size == capacity)
+        grow(capacity + 1);
 
-    array[(head + size) % capacity] = item;
+    array[slot(size)] = std::move(item);
     ++size;
 }
 
+// inserisce in coda gli n elementi del vettore items. La parte libera del
+// vettore circolare e' formata da al piu' due intervalli contigui: dalla
+// posizione successiva all'ultimo elemento alla fine del vettore e
+// dall'inizio del vettore alla testa
+template <typename T>
+void ArrayQueue<T>::enqueueN(const T *items, int n)
+{
+    if (n <= 0)
+        return;
+
+    if (n > maxCapacity - size) // size + n traboccherebbe
+        throw std::length_error("Queue capacity overflow!");
+    if (size + n > capacity)
+        grow(size + n);
+
+    int tail = slot(size);
+    int first = std::min(n, capacity - tail);
+    copySpan(items, first, array + tail);
+    copySpan(items + first, n - first, array);
+    size += n;
+}
+
+// rimuove fino a n elementi dalla testa della coda e li sposta in out,
+// in al piu' due blocchi. Restituisce il numero di elementi rimossi
+template <typename T>
+int ArrayQueue<T>::dequeueN(T *out, int n)
+{
+    if (n > size)
+        n = size;
+    if (n <= 0)
+        return 0;
+
+    int first = std::min(n, capacity - head);
+    moveSpan(array + head, first, out);
+    moveSpan(array, n - first, out + first);
+    head = slot(n);
+    size -= n;
+
+    return n;
+}
+
 // rimuove l'elemento in testa alla coda
 template <typename T>
 void ArrayQueue<T>::dequeue()
@@ -143,7 +371,7 @@ void ArrayQueue<T>::dequeue()
         return;
     }
 
-    head = (head + 1) % capacity;
+    head = slot(1);
     --size;
 }
 
@@ -177,8 +405,7 @@ bool ArrayQueue<T>::operator==(const ArrayQueue<T> &q) const
     // controllo esaustivo su ciascun elemento
     for (int i = 0; i < size; ++i) {
 
-        if (array[(i + head) % capacity] !=
-                q.array[(i + q.head) % q.capacity])
+        if (array[slot(i)] != q.array[q.slot(i)])
             return false;
     }
 
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <numeric>
 #include "ArrayQueue.h"
 using std::cout;
 
@@ -56,6 +57,40 @@ int main()
     else
         cout << "false\n";
 
+    // iteratori: range-for e algoritmi della libreria standard
+    ArrayQueue<int> queue4(4);
+    for (int i = 1; i <= 6; ++i) {
+        queue4.enqueue(i);
+        if (i % 2 == 0)
+            queue4.dequeue();
+    }
+    cout << "\nITERATORI\nCrea una coda 'queue4' il cui contenuto si avvolge"
+         << " attorno alla fine del vettore" << queue4 << "Con range-for: ";
+    for (int x : queue4.items())
+        cout << x << " ";
+    cout << "\nSomma con std::accumulate: "
+         << std::accumulate(queue4.ibegin(), queue4.iend(), 0) << "\n";
+
+    // crescita: la coda non e' mai piena
+    ArrayQueue<int> queue5(3); // capacita' arrotondata a 4
+    for (int i = 1; i <= 10; ++i)
+        queue5.enqueue(i);
+    cout << "\nCRESCITA\nCrea una coda 'queue5' di capacita' 3 e vi inserisce"
+         << " 10 elementi: il vettore viene raddoppiato quando e' pieno"
+         << queue5;
+
+    // inserimento e rimozione di piu' elementi alla volta
+    int in[6] = { 11, 12, 13, 14, 15, 16 };
+    int out[8];
+    queue5.enqueueN(in, 6);
+    cout << "\nFUNZIONI enqueueN E dequeueN\nInseriti in 'queue5' gli elementi"
+         << " 11..16 con enqueueN" << queue5;
+    int n = queue5.dequeueN(out, 8);
+    cout << "Rimossi " << n << " elementi con dequeueN:";
+    for (int i = 0; i < n; ++i)
+        cout << " " << out[i];
+    cout << queue5;
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
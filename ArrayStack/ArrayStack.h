@@ -1,5 +1,7 @@
 // By Fabio Nardelli
-// pila LIFO implementata mediante un vettore dinamico
+// pila LIFO implementata mediante un vettore dinamico.
+// Crescita e contrazione del vettore seguono la politica Growth
+// (vedi Utils/GrowthPolicy.h).
 
 #ifndef ARRAY_STACK_H
 #define ARRAY_STACK_H
@@ -7,22 +9,23 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
+#include "../Utils/GrowthPolicy.h"
 
-template <typename T>
+template <typename T, typename Growth = DefaultGrowth>
 class ArrayStack;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const ArrayStack<T> &);
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &, const ArrayStack<T, Growth> &);
 
-template <typename T>
+template <typename T, typename Growth>
 class ArrayStack {
-    friend std::ostream &operator<< <>(std::ostream &, const ArrayStack<T> &);
+    friend std::ostream &operator<< <>(std::ostream &, const ArrayStack<T, Growth> &);
 public:
     // costruttore di default
     ArrayStack(int c = defaultCapacity) : size(0) { create(c); }
-    ArrayStack(const ArrayStack<T> &); // costruttore per copia
+    ArrayStack(const ArrayStack<T, Growth> &); // costruttore per copia
     ~ArrayStack() { delete [] array; } // distruttore
-    ArrayStack<T> &operator=(const ArrayStack<T> &);
+    ArrayStack<T, Growth> &operator=(const ArrayStack<T, Growth> &);
 
     // operatori
     // restituisce "true" se la pila e' vuota, "false" altrimenti
@@ -31,7 +34,13 @@ public:
     void push(T); // inserisce un elemento in cima alla pila
     void pop();
     T top() const; // legge il primo elemento (cima) della pila
-    bool operator==(const ArrayStack<T> &) const;
+    bool operator==(const ArrayStack<T, Growth> &) const;
+    // restituisce la capacita' del vettore
+    int getCapacity() const { return capacity; }
+    // porta la capacita' del vettore ad almeno n elementi
+    void reserve(int n) { if (n > capacity) resize(n); }
+    // riduce la capacita' del vettore al numero di elementi contenuti
+    void shrinkToFit() { if (size < capacity) resize(size > 0 ? size : 1); }
 
 private:
     T *array; // puntatore usato per la rappresentazione dell'array che contiene la pila
@@ -40,31 +49,26 @@ private:
     int capacity; // dimensione dell'array
 
     static const int defaultCapacity = 16;
-    static const float minLoadFactor;
 
     void create(int); // crea una pila vuota
+    void resize(int); // modifica la dimensione del vettore
 };
 
-// costante che rappresenta il fattore di carico minimo al di sotto del quale
-// la dimensione del vettore viene dimezzata
-template <typename T>
-const float ArrayStack<T>::minLoadFactor = .25;
-
 /*===========================================================================*/
 /*                           DEFINIZIONI FUNZIONI                            */
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const ArrayStack<T> &s) 
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &output, const ArrayStack<T, Growth> &s)
 {
     s.print();
     return output; // consente cout << a << b << c
 }
 
 // stampa la pila
-template <typename T>
-void ArrayStack<T>::print() const
+template <typename T, typename Growth>
+void ArrayStack<T, Growth>::print() const
 {
     if (isEmpty()) {
         std::cout << "\n Stack is empty!\n";
@@ -82,8 +86,8 @@ void ArrayStack<T>::print() const
 } 
 
 // funzione di inizializzazione
-template <typename T>
-void ArrayStack<T>::create(int c) 
+template <typename T, typename Growth>
+void ArrayStack<T, Growth>::create(int c)
 {
     if (c > 0)
         capacity = c;
@@ -92,8 +96,8 @@ void ArrayStack<T>::create(int c)
 }
 
 // costruttore per copia
-template <typename T>
-ArrayStack<T>::ArrayStack(const ArrayStack<T> &s) 
+template <typename T, typename Growth>
+ArrayStack<T, Growth>::ArrayStack(const ArrayStack<T, Growth> &s)
 {
     capacity = s.capacity;
     size = s.size;
@@ -104,8 +108,8 @@ ArrayStack<T>::ArrayStack(const ArrayStack<T> &s)
 }
 
 // overload dell'operatore di assegnazione =
-template <typename T>
-ArrayStack<T> &ArrayStack<T>::operator=(const ArrayStack<T> &s) 
+template <typename T, typename Growth>
+ArrayStack<T, Growth> &ArrayStack<T, Growth>::operator=(const ArrayStack<T, Growth> &s)
 {
     if (&s != this) { // evita l'autoassegnazione
 
@@ -125,28 +129,35 @@ ArrayStack<T> &ArrayStack<T>::operator=(const ArrayStack<T> &s)
     return *this; // consente il cascading (a = b = c)
 }
 
+// utility function per modificare le dimensioni del vettore. Alloca un
+// nuovo vettore di dimensioni newCapacity e copia il contenuto del vecchio
+// vettore nel nuovo, dopodiche' cancella il vecchio vettore.
+template <typename T, typename Growth>
+void ArrayStack<T, Growth>::resize(int newCapacity)
+{
+    T *temp = new T[newCapacity];
+    for (int i = 0; i < size; ++i)
+        temp[i] = array[i];
+    delete [] array;
+    array = temp;
+    capacity = newCapacity;
+}
+
 // inserisce un elemento in cima alla pila
-template <typename T>
-void ArrayStack<T>::push(T item)
+template <typename T, typename Growth>
+void ArrayStack<T, Growth>::push(T item)
 {
-    if (size < capacity) {  // se c'e' spazio nell'array
-        array[size] = item; // aggiunge semplicemente l'elemento
-    } else { // altrimenti alloca un nuovo array piu' grande
-        capacity *= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = 0; i < size; ++i)
-            temp[i] = array[i];
-        delete [] array;
-        temp[size] = item;
-        array = temp;
-    }
+    // se non c'e' spazio nell'array, alloca un nuovo array piu' grande
+    if (size == capacity)
+        resize(Growth::grow(capacity));
+
+    array[size] = item;
     ++size;
 }
 
 // rimuove l'elemento in cima alla pila
-template <typename T>
-void ArrayStack<T>::pop()
+template <typename T, typename Growth>
+void ArrayStack<T, Growth>::pop()
 {
     if (isEmpty()) {
         std::cerr << "Cannot pop: Stack is empty!\n";
@@ -154,22 +165,15 @@ void ArrayStack<T>::pop()
     }
 
     --size;
-    // se il fattore di carico diventa <= minLoadFactor
-    // dimezza la capacita' dell'array
-    if (static_cast<float>(size) / capacity <= minLoadFactor) {
-        capacity /= 2;
-        T *temp = new T[capacity];
-        // copia gli elementi dal vecchio array al nuovo
-        for (int i = 0; i < size; ++i)
-            temp[i] = array[i];
-        delete [] array;
-        array = temp;
-    }
+    // se il fattore di carico scende alla soglia prevista dalla
+    // politica Growth, contrae l'array
+    if (Growth::shouldShrink(size, capacity, defaultCapacity))
+        resize(Growth::shrink(capacity, defaultCapacity));
 }
 
 // legge il primo elemento
-template <typename T>
-T ArrayStack<T>::top() const
+template <typename T, typename Growth>
+T ArrayStack<T, Growth>::top() const
 {
     if (isEmpty())
         throw std::domain_error("Stack is empty!");
@@ -178,8 +182,8 @@ T ArrayStack<T>::top() const
 }
 
 // overload dell'operatore di uguaglianza ==
-template <typename T>
-bool ArrayStack<T>::operator==(const ArrayStack<T> &s) const
+template <typename T, typename Growth>
+bool ArrayStack<T, Growth>::operator==(const ArrayStack<T, Growth> &s) const
 {
     // se le pile sono entrambe vuote, allora sono uguali
     if (isEmpty() && s.isEmpty())
@@ -58,6 +58,20 @@ int main()
     else
         cout << "false\n";
 
+    // capacita' del vettore: reserve, shrinkToFit e politica NeverShrink
+    ArrayStack<int, NeverShrink> stack4;
+    stack4.reserve(100);
+    cout << "\nFUNZIONI reserve E shrinkToFit\nCrea una pila 'stack4' che non"
+         << " contrae mai il vettore\nDopo reserve(100), capacita': "
+         << stack4.getCapacity();
+    for (int i = 0; i < 50; ++i)
+        stack4.push(i);
+    for (int i = 0; i < 45; ++i)
+        stack4.pop();
+    cout << "\nDopo 50 push e 45 pop, capacita': " << stack4.getCapacity();
+    stack4.shrinkToFit();
+    cout << "\nDopo shrinkToFit, capacita': " << stack4.getCapacity() << stack4;
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
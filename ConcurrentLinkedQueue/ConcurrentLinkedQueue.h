@@ -0,0 +1,580 @@
+// By Fabio Nardelli
+// coda FIFO concorrente senza lock, basata su lista concatenata
+// (algoritmo di Michael e Scott). Piu' thread possono inserire e rimuovere
+// elementi contemporaneamente: head e tail sono puntatori atomici, aggiornati
+// con compare-and-swap, e la lista ha sempre un nodo sentinella in testa
+// (head), privo di valore; il primo elemento della coda e' quello del nodo
+// successivo alla sentinella. Quando un elemento viene rimosso, il suo nodo
+// diventa la nuova sentinella e la vecchia sentinella viene "ritirata".
+// Un nodo ritirato puo' essere ancora letto da altri thread, per cui non
+// viene liberato subito: ogni thread pubblica in due puntatori di pericolo
+// (hazard pointer) i nodi che sta leggendo, e un nodo ritirato viene
+// riutilizzato solo quando nessun puntatore di pericolo lo indica.
+// I nodi riutilizzabili vengono conservati in una lista di nodi liberi
+// condivisa da tutti i thread, da cui enqueue li preleva prima di
+// allocarne di nuovi, per cui anche i produttori che non rimuovono mai
+// elementi riutilizzano i nodi liberati dai consumatori. La lista e' una
+// pila senza lock (pila di Treiber): chi preleva un nodo lo protegge con un
+// puntatore di pericolo, e un nodo protetto non puo' essere riutilizzato e
+// quindi tornare in cima alla pila, per cui il compare-and-swap del
+// prelievo non puo' scambiarlo per un nodo diverso (problema ABA).
+// Il valore di un elemento viene copiato da chi lo legge (tryDequeue,
+// tryTop) e distrutto solo quando il nodo viene riutilizzato.
+// Compilare con -pthread.
+
+#ifndef CONCURRENT_LINKED_QUEUE_H
+#define CONCURRENT_LINKED_QUEUE_H
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+template <typename T>
+class ConcurrentLinkedQueue;
+
+template <typename T>
+std::ostream &operator<<(std::ostream &, const ConcurrentLinkedQueue<T> &);
+
+template <typename T>
+class ConcurrentLinkedQueue {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const ConcurrentLinkedQueue<T> &);
+public:
+    ConcurrentLinkedQueue(); // costruttore di default
+    ~ConcurrentLinkedQueue(); // distruttore
+    // la coda e' condivisa fra piu' thread: non puo' essere copiata
+    ConcurrentLinkedQueue(const ConcurrentLinkedQueue<T> &) = delete;
+    ConcurrentLinkedQueue<T> &operator=(const ConcurrentLinkedQueue<T> &)
+        = delete;
+
+    // operatori
+    // restituisce "true" se la coda e' vuota, "false" altrimenti
+    bool isEmpty() const;
+    // stampa la coda (solo se nessun thread la sta modificando)
+    void print() const;
+    // inserisce un elemento in coda
+    void enqueue(const T &item) { append(newNode(item)); }
+    void enqueue(T &&item) { append(newNode(std::move(item))); }
+    // copia in item l'elemento da piu' tempo in coda e lo rimuove.
+    // Restituisce false, senza modificare item, se la coda e' vuota
+    bool tryDequeue(T &item);
+    // copia in item l'elemento da piu' tempo in coda senza rimuoverlo.
+    // Restituisce false, senza modificare item, se la coda e' vuota
+    bool tryTop(T &item) const;
+
+private:
+    // rappresenta un generico nodo. Il valore e' memoria grezza,
+    // costruita solo per i nodi che contengono un elemento
+    struct Node {
+        std::atomic<Node *> next; // puntatore al nodo successivo
+        bool hasValue; // false per la sentinella iniziale
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        T *value() { return reinterpret_cast<T *>(&storage); }
+    };
+
+    // puntatori di pericolo e nodi ritirati di un thread. I record sono
+    // condivisi da tutte le code con lo stesso tipo di elemento e non
+    // vengono mai liberati prima della fine del programma: quando un
+    // thread termina, il suo record (con i nodi ritirati non ancora
+    // riutilizzabili) passa al primo thread che ne richiede uno
+    struct Record {
+        std::atomic<Node *> hazard[2]; // nodi letti dal thread
+        std::atomic<bool> active; // true se il record e' in uso
+        Record *next; // record successivo nella lista dei record
+        std::vector<Node *> retired; // nodi ritirati dal thread
+    };
+
+    // lista dei record, a cui i record vengono solo aggiunti
+    struct Domain {
+        std::atomic<Record *> records;
+        std::atomic<int> count; // numero di record
+        Domain() : records(0), count(0) { }
+        ~Domain(); // a fine programma libera record e nodi ritirati
+    };
+
+    // record del thread corrente, rilasciato quando il thread termina
+    struct LocalRecord {
+        Record *record;
+        LocalRecord() : record(acquireRecord()) { }
+        ~LocalRecord();
+    };
+
+    // pila dei nodi liberi, condivisa come i record da tutte le code con
+    // lo stesso tipo di elemento
+    struct FreeList {
+        std::atomic<Node *> top; // i nodi liberi sono concatenati tramite next
+        std::atomic<int> count; // numero (approssimato) di nodi liberi
+        FreeList() : top(0), count(0) { }
+        ~FreeList(); // a fine programma libera i nodi
+    };
+
+    // puntatori al nodo sentinella e all'ultimo nodo, su linee di cache
+    // diverse perche' sono modificati da thread diversi
+    alignas(64) std::atomic<Node *> head;
+    alignas(64) std::atomic<Node *> tail;
+
+    // nodi ritirati oltre i quali un thread cerca quelli riutilizzabili
+    static const std::size_t minScan = 64;
+    // nodi liberi oltre i quali i nodi riutilizzabili vengono liberati
+    static const int maxFree = 1024;
+
+    static Domain &domain();
+    static Record *acquireRecord();
+    static Record *localRecord();
+    static FreeList &freeList();
+
+    // alloca (o preleva dalla lista dei nodi liberi) un nodo con il valore
+    // indicato
+    template <typename U>
+    static Node *newNode(U &&);
+    // preleva un nodo dalla lista dei nodi liberi (0 se e' vuota)
+    static Node *popFree();
+    // inserisce nella lista dei nodi liberi gli n nodi concatenati
+    // da first a last
+    static void pushFree(Node *first, Node *last, int n);
+    // distrugge il valore del nodo e lo libera
+    static void destroy(Node *);
+    // legge src e pubblica il valore letto nel puntatore di pericolo hp,
+    // ripetendo finche' src non cambia fra la lettura e la pubblicazione
+    static Node *protect(std::atomic<Node *> &hp,
+        const std::atomic<Node *> &src);
+    // ritira un nodo rimosso dalla lista
+    static void retire(Node *);
+    // riutilizza i nodi ritirati dal thread corrente non indicati
+    // da alcun puntatore di pericolo
+    static void scan(Record *);
+
+    // aggiunge un nodo in fondo alla lista
+    void append(Node *);
+};
+
+// definizione della costante minScan, necessaria perche' std::max la
+// riceve per riferimento
+template <typename T>
+const std::size_t ConcurrentLinkedQueue<T>::minScan;
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T>
+std::ostream &operator<<(std::ostream &output,
+    const ConcurrentLinkedQueue<T> &q)
+{
+    q.print();
+    return output; // consente cout << a << b << c
+}
+
+// costruttore di default: crea la sentinella
+template <typename T>
+ConcurrentLinkedQueue<T>::ConcurrentLinkedQueue()
+{
+    Node *sentinel = new Node;
+    sentinel->next.store(0, std::memory_order_relaxed);
+    sentinel->hasValue = false;
+    head.store(sentinel, std::memory_order_relaxed);
+    tail.store(sentinel, std::memory_order_relaxed);
+}
+
+// distruttore: libera tutti i nodi, sentinella compresa. Nessun thread
+// deve usare la coda durante la distruzione
+template <typename T>
+ConcurrentLinkedQueue<T>::~ConcurrentLinkedQueue()
+{
+    Node *node = head.load(std::memory_order_acquire);
+    while (node != 0) {
+        Node *next = node->next.load(std::memory_order_relaxed);
+        destroy(node);
+        node = next;
+    }
+}
+
+// distruttore del dominio: libera tutti i record e i nodi ritirati
+template <typename T>
+ConcurrentLinkedQueue<T>::Domain::~Domain()
+{
+    Record *r = records.load(std::memory_order_acquire);
+    while (r != 0) {
+        Record *next = r->next;
+        for (std::size_t i = 0; i < r->retired.size(); ++i)
+            destroy(r->retired[i]);
+        delete r;
+        r = next;
+    }
+}
+
+// distruttore del record locale: cerca i nodi riutilizzabili e rende
+// il record disponibile agli altri thread
+template <typename T>
+ConcurrentLinkedQueue<T>::LocalRecord::~LocalRecord()
+{
+    record->hazard[0].store(0, std::memory_order_release);
+    record->hazard[1].store(0, std::memory_order_release);
+    scan(record);
+    record->active.store(false, std::memory_order_release);
+}
+
+// distruttore della lista dei nodi liberi (i valori sono gia' distrutti)
+template <typename T>
+ConcurrentLinkedQueue<T>::FreeList::~FreeList()
+{
+    Node *node = top.load(std::memory_order_acquire);
+    while (node != 0) {
+        Node *next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+// restituisce il dominio dei puntatori di pericolo per il tipo T
+template <typename T>
+typename ConcurrentLinkedQueue<T>::Domain &ConcurrentLinkedQueue<T>::domain()
+{
+    static Domain d;
+    return d;
+}
+
+// restituisce un record libero, riutilizzandone uno inattivo se possibile
+template <typename T>
+typename ConcurrentLinkedQueue<T>::Record *
+    ConcurrentLinkedQueue<T>::acquireRecord()
+{
+    Domain &d = domain();
+    for (Record *r = d.records.load(std::memory_order_acquire); r != 0;
+            r = r->next) {
+        bool inactive = false;
+        if (!r->active.load(std::memory_order_relaxed)
+                && r->active.compare_exchange_strong(inactive, true,
+                    std::memory_order_acquire))
+            return r;
+    }
+
+    // nessun record libero: ne aggiunge uno in testa alla lista
+    Record *r = new Record;
+    r->hazard[0].store(0, std::memory_order_relaxed);
+    r->hazard[1].store(0, std::memory_order_relaxed);
+    r->active.store(true, std::memory_order_relaxed);
+    r->next = d.records.load(std::memory_order_relaxed);
+    while (!d.records.compare_exchange_weak(r->next, r,
+            std::memory_order_release, std::memory_order_relaxed))
+        ;
+    d.count.fetch_add(1, std::memory_order_relaxed);
+    return r;
+}
+
+// restituisce il record del thread corrente
+template <typename T>
+typename ConcurrentLinkedQueue<T>::Record *
+    ConcurrentLinkedQueue<T>::localRecord()
+{
+    // il dominio e la lista dei nodi liberi devono essere costruiti prima
+    // del record locale, in modo da essere distrutti dopo di esso (il
+    // distruttore del record inserisce nodi nella lista dei nodi liberi)
+    domain();
+    freeList();
+    static thread_local LocalRecord local;
+    return local.record;
+}
+
+// restituisce la lista dei nodi liberi per il tipo T
+template <typename T>
+typename ConcurrentLinkedQueue<T>::FreeList &
+    ConcurrentLinkedQueue<T>::freeList()
+{
+    static FreeList list;
+    return list;
+}
+
+// restituisce un nodo con il valore indicato, prelevandolo dalla lista
+// dei nodi liberi o, se e' vuota, allocandolo
+template <typename T>
+template <typename U>
+typename ConcurrentLinkedQueue<T>::Node *
+    ConcurrentLinkedQueue<T>::newNode(U &&item)
+{
+    Node *node = popFree();
+    if (node == 0)
+        node = new Node;
+
+    try {
+        new (node->value()) T(std::forward<U>(item));
+    } catch (...) {
+        // un altro thread potrebbe proteggere il nodo, prelevato dalla
+        // lista: non puo' esservi reinserito direttamente, per cui viene
+        // ritirato come un nodo rimosso dalla coda
+        node->hasValue = false;
+        retire(node);
+        throw;
+    }
+    node->hasValue = true;
+    node->next.store(0, std::memory_order_relaxed);
+    return node;
+}
+
+// preleva il nodo in cima alla pila. Il nodo viene protetto prima di
+// leggerne next: finche' e' protetto non puo' essere riutilizzato, per cui
+// se il compare-and-swap riesce next e' ancora il nodo successivo
+template <typename T>
+typename ConcurrentLinkedQueue<T>::Node *ConcurrentLinkedQueue<T>::popFree()
+{
+    FreeList &list = freeList();
+    if (list.top.load(std::memory_order_relaxed) == 0)
+        return 0;
+
+    std::atomic<Node *> &hp = localRecord()->hazard[0];
+    Node *node;
+    for (;;) {
+        node = protect(hp, list.top);
+        if (node == 0)
+            break;
+        Node *next = node->next.load(std::memory_order_relaxed);
+        if (list.top.compare_exchange_weak(node, next,
+                std::memory_order_acquire, std::memory_order_relaxed))
+            break;
+    }
+    hp.store(0, std::memory_order_release);
+
+    if (node != 0)
+        list.count.fetch_sub(1, std::memory_order_relaxed);
+    return node;
+}
+
+// inserisce in cima alla pila una catena di nodi con un solo
+// compare-and-swap
+template <typename T>
+void ConcurrentLinkedQueue<T>::pushFree(Node *first, Node *last, int n)
+{
+    FreeList &list = freeList();
+    Node *top = list.top.load(std::memory_order_relaxed);
+    do
+        last->next.store(top, std::memory_order_relaxed);
+    while (!list.top.compare_exchange_weak(top, first,
+        std::memory_order_release, std::memory_order_relaxed));
+    list.count.fetch_add(n, std::memory_order_relaxed);
+}
+
+// distrugge il valore del nodo e lo libera
+template <typename T>
+void ConcurrentLinkedQueue<T>::destroy(Node *node)
+{
+    if (node->hasValue)
+        node->value()->~T();
+    delete node;
+}
+
+// legge src e lo pubblica nel puntatore di pericolo hp. La seconda lettura
+// garantisce che il nodo fosse ancora raggiungibile quando e' stato
+// pubblicato: da quel momento nessun thread puo' riutilizzarlo
+template <typename T>
+typename ConcurrentLinkedQueue<T>::Node *
+    ConcurrentLinkedQueue<T>::protect(std::atomic<Node *> &hp,
+        const std::atomic<Node *> &src)
+{
+    Node *node = src.load(std::memory_order_relaxed);
+    for (;;) {
+        hp.store(node, std::memory_order_seq_cst);
+        Node *again = src.load(std::memory_order_seq_cst);
+        if (again == node)
+            return node;
+        node = again;
+    }
+}
+
+// ritira un nodo: quando i nodi ritirati dal thread sono abbastanza,
+// cerca quelli che possono essere riutilizzati
+template <typename T>
+void ConcurrentLinkedQueue<T>::retire(Node *node)
+{
+    Record *r = localRecord();
+    r->retired.push_back(node);
+
+    // la soglia cresce con il numero di puntatori di pericolo, in modo
+    // che ogni ricerca riutilizzi in media almeno la meta' dei nodi
+    std::size_t threshold = 4 * static_cast<std::size_t>(
+        domain().count.load(std::memory_order_relaxed));
+    if (r->retired.size() >= std::max(threshold, minScan))
+        scan(r);
+}
+
+// raccoglie i puntatori di pericolo di tutti i thread e riutilizza i
+// nodi ritirati da r che non compaiono fra essi: ne distrugge i valori e
+// li inserisce nella lista dei nodi liberi, oppure li libera se la lista
+// ne contiene gia' maxFree
+template <typename T>
+void ConcurrentLinkedQueue<T>::scan(Record *r)
+{
+    std::vector<Node *> hazards;
+    for (Record *p = domain().records.load(std::memory_order_acquire);
+            p != 0; p = p->next)
+        for (int i = 0; i < 2; ++i) {
+            Node *node = p->hazard[i].load(std::memory_order_seq_cst);
+            if (node != 0)
+                hazards.push_back(node);
+        }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::vector<Node *> &retired = r->retired;
+    std::size_t kept = 0;
+    Node *first = 0, *last = 0; // catena dei nodi da riutilizzare
+    int n = 0, room = maxFree
+        - freeList().count.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < retired.size(); ++i) {
+        Node *node = retired[i];
+        if (std::binary_search(hazards.begin(), hazards.end(), node)) {
+            retired[kept++] = node; // ancora in uso
+        } else if (n < room) {
+            if (node->hasValue)
+                node->value()->~T();
+            node->hasValue = false;
+            node->next.store(first, std::memory_order_relaxed);
+            if (first == 0)
+                last = node;
+            first = node;
+            ++n;
+        } else
+            destroy(node);
+    }
+    retired.resize(kept);
+
+    if (n > 0)
+        pushFree(first, last, n);
+}
+
+// aggiunge un nodo in fondo alla lista. Se tail non indica l'ultimo nodo
+// (un altro thread ha collegato un nodo ma non ha ancora aggiornato tail)
+// lo aggiorna prima di riprovare
+template <typename T>
+void ConcurrentLinkedQueue<T>::append(Node *node)
+{
+    std::atomic<Node *> &hp = localRecord()->hazard[0];
+
+    for (;;) {
+        Node *last = protect(hp, tail);
+        Node *next = last->next.load(std::memory_order_acquire);
+        if (last != tail.load(std::memory_order_acquire))
+            continue;
+
+        if (next == 0) {
+            // collega il nodo dopo l'ultimo, poi sposta tail su di esso
+            // (se fallisce, un altro thread lo ha gia' fatto)
+            if (last->next.compare_exchange_weak(next, node,
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                tail.compare_exchange_strong(last, node,
+                    std::memory_order_release, std::memory_order_relaxed);
+                break;
+            }
+        } else
+            tail.compare_exchange_strong(last, next,
+                std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    hp.store(0, std::memory_order_release);
+}
+
+// rimuove l'elemento da piu' tempo in coda, copiandolo in item.
+// Il valore viene copiato prima di spostare head, perche' dopo lo
+// spostamento un altro thread potrebbe rimuovere il nodo e ritirarlo
+template <typename T>
+bool ConcurrentLinkedQueue<T>::tryDequeue(T &item)
+{
+    Record *r = localRecord();
+
+    for (;;) {
+        Node *first = protect(r->hazard[0], head);
+        Node *last = tail.load(std::memory_order_acquire);
+        Node *next = first->next.load(std::memory_order_acquire);
+        r->hazard[1].store(next, std::memory_order_seq_cst);
+        // se head non e' cambiato, next e' ancora raggiungibile
+        if (first != head.load(std::memory_order_seq_cst))
+            continue;
+
+        if (next == 0) { // coda vuota
+            r->hazard[0].store(0, std::memory_order_release);
+            r->hazard[1].store(0, std::memory_order_release);
+            return false;
+        }
+        if (first == last) {
+            // tail e' rimasto indietro: lo aggiorna e riprova
+            tail.compare_exchange_strong(last, next,
+                std::memory_order_release, std::memory_order_relaxed);
+            continue;
+        }
+
+        T value(*next->value());
+        if (head.compare_exchange_strong(first, next,
+                std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            r->hazard[0].store(0, std::memory_order_release);
+            r->hazard[1].store(0, std::memory_order_release);
+            item = std::move(value);
+            retire(first);
+            return true;
+        }
+    }
+}
+
+// copia in item l'elemento da piu' tempo in coda
+template <typename T>
+bool ConcurrentLinkedQueue<T>::tryTop(T &item) const
+{
+    Record *r = localRecord();
+
+    for (;;) {
+        Node *first = protect(r->hazard[0], head);
+        Node *next = first->next.load(std::memory_order_acquire);
+        r->hazard[1].store(next, std::memory_order_seq_cst);
+        if (first != head.load(std::memory_order_seq_cst))
+            continue;
+
+        bool found = (next != 0);
+        if (found)
+            item = *next->value();
+        r->hazard[0].store(0, std::memory_order_release);
+        r->hazard[1].store(0, std::memory_order_release);
+        return found;
+    }
+}
+
+// restituisce "true" se la coda e' vuota
+template <typename T>
+bool ConcurrentLinkedQueue<T>::isEmpty() const
+{
+    // basta leggere next della sentinella: il nodo deve pero' essere
+    // protetto, perche' nel frattempo potrebbe essere ritirato
+    std::atomic<Node *> &hp = localRecord()->hazard[0];
+    Node *first = protect(hp, head);
+    bool empty = first->next.load(std::memory_order_acquire) == 0;
+    hp.store(0, std::memory_order_release);
+    return empty;
+}
+
+// stampa la coda
+template <typename T>
+void ConcurrentLinkedQueue<T>::print() const
+{
+    Node *node = head.load(std::memory_order_acquire)->next.load(
+        std::memory_order_acquire);
+
+    if (node == 0) {
+        std::cout << "\n Queue is empty!\n";
+        return;
+    }
+
+    std::cout << "\n [";
+
+    for (int i = 1; node != 0; ++i) {
+        std::cout << std::setw(3) << *node->value() << " ";
+        node = node->next.load(std::memory_order_acquire);
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if (i % 5 == 0 && node != 0)
+            std::cout << "\n  ";
+    }
+    std::cout << " ]\n";
+}
+
+#endif
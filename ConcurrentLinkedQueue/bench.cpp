@@ -0,0 +1,154 @@
+// benchmark di ConcurrentLinkedQueue: p produttori inseriscono ciascuno
+// n / p interi e c consumatori li rimuovono. Confronta la coda senza lock
+// con una LinkedQueue protetta da un mutex. Per la coda senza lock conta
+// anche le chiamate all'operatore new (sostituito in questo file) per
+// elemento trasferito, sia senza limiti sia con i produttori che attendono
+// quando la coda contiene maxPending elementi: senza riutilizzo dei nodi
+// sarebbero 1, mentre con la lista dei nodi liberi condivisa i produttori
+// riutilizzano i nodi liberati dai consumatori. Senza limiti, con pochi
+// core i produttori possono riempire la coda prima che i consumatori
+// partano, per cui i nodi da riutilizzare arrivano troppo tardi.
+// Compilare con -pthread.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <new>
+#include "ConcurrentLinkedQueue.h"
+#include "../LinkedQueue/LinkedQueue.h"
+using std::cout;
+
+// numero di chiamate all'operatore new
+static std::atomic<long long> allocations(0);
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size != 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+// avvia i thread produttori e consumatori e restituisce
+// il numero di milioni di elementi trasferiti al secondo
+template <typename P, typename C>
+double throughput(P producer, C consumer, int producers, int consumers, int n)
+{
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (int i = 0; i < producers; ++i)
+        threads.push_back(std::thread(producer, n / producers));
+    for (int i = 0; i < consumers; ++i)
+        threads.push_back(std::thread(consumer));
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return n / std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+// elementi in coda oltre i quali i produttori attendono (se richiesto)
+const int maxPending = 1000;
+
+// misura la coda senza lock e scrive in allocs le chiamate all'operatore
+// new per elemento trasferito. Se bounded e' true, i produttori attendono
+// finche' la coda contiene maxPending elementi
+double lockFree(int producers, int consumers, int n, bool bounded,
+    double &allocs)
+{
+    ConcurrentLinkedQueue<int> q;
+    std::atomic<int> left(n / producers * producers);
+    std::atomic<int> pending(0); // elementi inseriti e non ancora rimossi
+    long long before = allocations.load();
+    double result = throughput([&q, &pending, bounded](int k) {
+        for (int i = 0; i < k; ++i) {
+            while (bounded
+                    && pending.load(std::memory_order_relaxed) >= maxPending)
+                std::this_thread::yield();
+            q.enqueue(i);
+            pending.fetch_add(1, std::memory_order_relaxed);
+        }
+    }, [&q, &left, &pending]() {
+        int x;
+        while (left.load(std::memory_order_relaxed) > 0) {
+            if (q.tryDequeue(x)) {
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                left.fetch_sub(1, std::memory_order_relaxed);
+            } else
+                std::this_thread::yield();
+        }
+    }, producers, consumers, n);
+    allocs = static_cast<double>(allocations.load() - before) / n;
+    return result;
+}
+
+double locked(int producers, int consumers, int n)
+{
+    LinkedQueue<int> q;
+    std::mutex m;
+    std::atomic<int> left(n / producers * producers);
+    return throughput([&q, &m](int k) {
+        for (int i = 0; i < k; ++i) {
+            std::lock_guard<std::mutex> lock(m);
+            q.enqueue(i);
+        }
+    }, [&q, &m, &left]() {
+        while (left.load(std::memory_order_relaxed) > 0) {
+            std::unique_lock<std::mutex> lock(m);
+            if (!q.isEmpty()) {
+                q.dequeue();
+                lock.unlock();
+                left.fetch_sub(1, std::memory_order_relaxed);
+            } else {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    }, producers, consumers, n);
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK ConcurrentLinkedQueue **************\n\n";
+    cout << "elementi trasferiti (milioni/s), core disponibili: "
+         << std::thread::hardware_concurrency() << "\n\n";
+    cout << std::setw(12) << "produttori" << std::setw(12) << "consumatori"
+         << std::setw(12) << "lock-free" << std::setw(12) << "mutex"
+         << std::setw(14) << "new/elemento" << std::setw(14) << "con limite"
+         << "\n";
+
+    const int n = 1 << 21;
+    const int configs[][2] = { { 1, 1 }, { 4, 1 }, { 4, 4 }, { 16, 1 },
+                               { 16, 4 } };
+    for (std::size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); ++i) {
+        int p = configs[i][0], c = configs[i][1];
+        double allocs, boundedAllocs;
+        double rate = lockFree(p, c, n, false, allocs);
+        lockFree(p, c, n, true, boundedAllocs);
+        cout << std::setw(12) << p << std::setw(12) << c
+             << std::fixed << std::setprecision(2)
+             << std::setw(12) << rate
+             << std::setw(12) << locked(p, c, n) << std::setprecision(4)
+             << std::setw(14) << allocs << std::setw(14) << boundedAllocs
+             << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentLinkedQueue.h"
+using std::cout;
+using std::string;
+
+int main()
+{
+    ConcurrentLinkedQueue<int> queue;
+
+    cout << "\n************** TEST CLASSE ConcurrentLinkedQueue **************\n\n";
+
+    // stampa una coda vuota
+    cout << "Crea e tenta di stampare una coda vuota:\n";
+    queue.print();
+
+    // inserisce tre elementi nella coda
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+    cout << "\nFUNZIONE enqueue:\ninserisce un elemento nella coda."
+         << "\nInseriti(nell'ordine) elementi 1, 2 e 3\n" << queue;
+
+    // lettura e rimozione
+    int item = 0;
+    queue.tryTop(item);
+    cout << "\nFUNZIONE tryTop\nL'elemento da piu' tempo in coda e': " << item;
+    queue.tryDequeue(item);
+    cout << "\n\nFUNZIONE tryDequeue\nRimosso elemento " << item << queue;
+    queue.tryDequeue(item);
+    queue.tryDequeue(item);
+    cout << "Rimossi altri due elementi" << queue;
+    cout << "tryDequeue su coda vuota: "
+         << (queue.tryDequeue(item) ? "true" : "false") << "\n";
+
+    // piu' produttori e piu' consumatori
+    const int producers = 4, consumers = 4, count = 100000;
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(consumers, 0);
+    std::vector<int> taken(consumers, 0);
+    for (int p = 0; p < producers; ++p)
+        threads.push_back(std::thread([&queue, p, count]() {
+            for (int i = 0; i < count; ++i)
+                queue.enqueue(p * count + i);
+        }));
+    for (int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&queue, &sums, &taken, c, count]() {
+            int x;
+            while (taken[c] < count) {
+                if (queue.tryDequeue(x)) {
+                    sums[c] += x;
+                    ++taken[c];
+                } else
+                    std::this_thread::yield(); // coda vuota: cede il processore
+            }
+        }));
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    long long sum = 0;
+    for (int c = 0; c < consumers; ++c)
+        sum += sums[c];
+    long long n = (long long)producers * count;
+    cout << "\nPIU' THREAD\n" << producers << " produttori inseriscono "
+         << n << " elementi, " << consumers << " consumatori li rimuovono"
+         << "\nsomma: " << sum << " (attesa " << n * (n - 1) / 2 << ")"
+         << "\ncoda vuota alla fine: " << (queue.isEmpty() ? "true" : "false")
+         << "\n";
+
+    // coda di stringhe
+    ConcurrentLinkedQueue<string> words;
+    words.enqueue("senza");
+    words.enqueue("lock");
+    cout << "\nConcurrentLinkedQueue<string>:" << words;
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+}
\ No newline at end of file
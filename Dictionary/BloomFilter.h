@@ -0,0 +1,199 @@
+// By Fabio Nardelli
+// Filtri di appartenenza approssimata per la classe Dictionary (parametro
+// template Filter). Il filtro viene interrogato prima della lista di
+// trabocco: se risponde che la chiave non puo' essere presente, find,
+// belongs e remove terminano senza scandire la lista. Non ci sono falsi
+// negativi, mentre una piccola frazione delle chiavi assenti supera il
+// filtro (falsi positivi) e viene cercata normalmente.
+//   NoFilter     nessun filtro (default): mayContain restituisce sempre true;
+//   BloomFilter  filtro di Bloom "a blocchi" con contatori: le posizioni di
+//                una chiave cadono tutte nello stesso blocco di 64 byte (una
+//                linea di cache), per cui una ricerca legge una sola linea.
+//                Ogni blocco contiene 128 contatori da 4 bit invece di 128
+//                bit, cosi' le rimozioni possono decrementarli; un contatore
+//                che raggiunge 15 resta fermo a 15 (non viene piu'
+//                decrementato), per cui un trabocco puo' solo aumentare i
+//                falsi positivi.
+// Il filtro viene dimensionato per il numero di liste del dizionario:
+// con capacity liste contiene capacity / 8 blocchi, cioe' 8 contatori per
+// elemento quando il fattore di carico e' massimo (2). Le posizioni sono
+// ricavate dal valore hash della chiave rimescolato con mixInteger: i bit
+// alti scelgono il blocco, gruppi di 7 bit bassi i contatori.
+
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "Hash.h"
+#include "TableMemory.h"
+
+// nessun filtro: tutte le chiavi possono essere presenti
+struct NoFilter {
+    // dimensiona il filtro per una tabella di capacity liste, vuotandolo
+    void create(std::size_t) { }
+    // libera la memoria del filtro
+    void clear() { }
+    // restituisce false se la chiave con valore hash h non e' presente
+    bool mayContain(std::size_t) const { return true; }
+    // registra l'inserimento e la rimozione di una chiave con valore hash h
+    void add(std::size_t) { }
+    void erase(std::size_t) { }
+    void swap(NoFilter &) { }
+};
+
+// filtro di Bloom a blocchi con contatori da 4 bit
+class BloomFilter {
+public:
+    BloomFilter() : buffer(0), blocks(0), blockCount(0), blockBits(0) { }
+    BloomFilter(const BloomFilter &f); // costruttore per copia
+    ~BloomFilter() { clear(); } // distruttore
+    BloomFilter &operator=(BloomFilter f) // operatore = (copia e scambia)
+    {
+        swap(f);
+        return *this;
+    }
+
+    // funzioni del filtro (vedi NoFilter)
+    void create(std::size_t capacity);
+    void clear();
+    bool mayContain(std::size_t h) const;
+    void add(std::size_t h);
+    void erase(std::size_t h);
+    void swap(BloomFilter &f)
+    {
+        std::swap(buffer, f.buffer);
+        std::swap(blocks, f.blocks);
+        std::swap(blockCount, f.blockCount);
+        std::swap(blockBits, f.blockBits);
+    }
+
+private:
+    static const std::size_t blockSize = 64; // byte per blocco
+    static const unsigned hashes = 5; // contatori per chiave
+
+    // blocco di 128 contatori da 4 bit, allineato a una linea di cache
+    struct Block {
+        std::uint64_t words[8]; // 16 contatori per parola
+    };
+
+    void *buffer; // memoria allocata (0 se il filtro non e' stato creato)
+    Block *blocks; // primo blocco, allineato a blockSize
+    std::size_t blockCount; // numero di blocchi (potenza di 2)
+    unsigned blockBits; // log2(blockCount)
+
+    // alloca blockCount blocchi azzerati
+    void allocate();
+    // dimensione in byte della memoria allocata per blockCount blocchi
+    std::size_t bufferSize() const
+        { return blockCount * sizeof(Block) + blockSize; }
+    // restituisce il blocco della chiave con valore hash h e scrive in
+    // x i bit da cui ricavare i suoi contatori
+    Block &blockOf(std::size_t h, std::uint64_t &x) const
+    {
+        x = static_cast<std::uint64_t>(
+            mixInteger(static_cast<std::uint64_t>(h)));
+        return blocks[blockBits > 0 ? x >> (64 - blockBits) : 0];
+    }
+};
+
+/*=== DEFINIZIONI FUNZIONI ===*/
+
+// costruttore per copia
+inline BloomFilter::BloomFilter(const BloomFilter &f)
+    : buffer(0), blocks(0), blockCount(f.blockCount), blockBits(f.blockBits)
+{
+    if (f.buffer != 0) {
+        allocate();
+        std::memcpy(blocks, f.blocks, blockCount * sizeof(Block));
+    }
+}
+
+// alloca i blocchi piu' una linea di cache per allineare il primo blocco.
+// I filtri grandi vengono mappati con mmap (vedi TableMemory.h), che
+// fornisce pagine gia' azzerate senza doverle scrivere
+inline void BloomFilter::allocate()
+{
+    buffer = allocateZeroedTableMemory(bufferSize());
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer);
+    address = (address + blockSize - 1) & ~(blockSize - 1);
+    blocks = reinterpret_cast<Block *>(address);
+}
+
+// crea un filtro vuoto di capacity / 8 blocchi (almeno 1, potenza di 2)
+inline void BloomFilter::create(std::size_t capacity)
+{
+    clear();
+    blockCount = 1;
+    blockBits = 0;
+    while (blockCount < capacity / 8) {
+        blockCount *= 2;
+        ++blockBits;
+    }
+    allocate();
+}
+
+// libera i blocchi
+inline void BloomFilter::clear()
+{
+    freeTableMemory(buffer, bufferSize());
+    buffer = 0;
+    blocks = 0;
+    blockCount = 0;
+    blockBits = 0;
+}
+
+// la chiave puo' essere presente solo se tutti i suoi contatori sono
+// diversi da zero. Un filtro non creato lascia passare tutte le chiavi
+inline bool BloomFilter::mayContain(std::size_t h) const
+{
+    if (blocks == 0)
+        return true;
+
+    std::uint64_t x;
+    const Block &b = blockOf(h, x);
+    for (unsigned i = 0; i < hashes; ++i, x >>= 7) {
+        unsigned c = static_cast<unsigned>(x & 127);
+        if (((b.words[c >> 4] >> ((c & 15) * 4)) & 15) == 0)
+            return false;
+    }
+    return true;
+}
+
+// incrementa i contatori della chiave (quelli a 15 restano a 15)
+inline void BloomFilter::add(std::size_t h)
+{
+    if (blocks == 0)
+        return;
+
+    std::uint64_t x;
+    Block &b = blockOf(h, x);
+    for (unsigned i = 0; i < hashes; ++i, x >>= 7) {
+        unsigned c = static_cast<unsigned>(x & 127);
+        unsigned shift = (c & 15) * 4;
+        if (((b.words[c >> 4] >> shift) & 15) != 15)
+            b.words[c >> 4] += std::uint64_t(1) << shift;
+    }
+}
+
+// decrementa i contatori della chiave, tranne quelli saturati a 15, il cui
+// valore reale non e' piu' noto
+inline void BloomFilter::erase(std::size_t h)
+{
+    if (blocks == 0)
+        return;
+
+    std::uint64_t x;
+    Block &b = blockOf(h, x);
+    for (unsigned i = 0; i < hashes; ++i, x >>= 7) {
+        unsigned c = static_cast<unsigned>(x & 127);
+        unsigned shift = (c & 15) * 4;
+        std::uint64_t count = (b.words[c >> 4] >> shift) & 15;
+        if (count != 0 && count != 15)
+            b.words[c >> 4] -= std::uint64_t(1) << shift;
+    }
+}
+
+#endif
@@ -0,0 +1,294 @@
+// By Fabio Nardelli
+// Dizionario concorrente: le coppie sono distribuite fra piu' shard
+// (frammenti), ciascuno formato da un Dictionary e dal mutex che lo
+// protegge. Lo shard di una chiave e' dato dai bit alti del suo valore hash
+// rimescolato con mixInteger (un funtore Hasher diverso da Hash<K> puo'
+// restituire la chiave stessa per gli interi, i cui bit alti sarebbero quasi
+// sempre nulli). Il Dictionary dello shard sceglie la lista di trabocco con
+// i bit alti di un rimescolamento diverso (una moltiplicazione), per cui le
+// chiavi di uno shard si distribuiscono su tutte le sue liste. Thread che
+// operano su chiavi di shard diversi non si contendono lo stesso lock e ogni
+// shard si ristruttura da solo, bloccando solo le operazioni sulle proprie
+// chiavi (con setRehashStep la ristrutturazione e' anche incrementale).
+// Gli shard sono allineati a una linea di cache, per cui i mutex di shard
+// vicini non condividono la stessa linea (false sharing).
+// find copia il valore trovato, perche' un puntatore all'interno dello shard
+// non sarebbe piu' protetto dal lock dopo la restituzione. getSize, print e
+// forEach bloccano tutti gli shard, sempre nello stesso ordine (per cui non
+// possono verificarsi stalli), e vedono quindi uno stato consistente.
+// Compilare con -pthread.
+
+#ifndef CONCURRENT_DICTIONARY_H
+#define CONCURRENT_DICTIONARY_H
+
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <cstdint>
+#include "Dictionary.h"
+
+template <typename K, typename V, typename Hasher = Hash<K> >
+class ConcurrentDictionary;
+
+template <typename K, typename V, typename Hasher>
+std::ostream &operator<<(std::ostream &,
+    const ConcurrentDictionary<K, V, Hasher> &);
+
+template <typename K, typename V, typename Hasher>
+class ConcurrentDictionary {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const ConcurrentDictionary<K, V, Hasher> &);
+public:
+    // costruttore: il numero di shard viene arrotondato alla potenza di 2
+    // successiva (al massimo maxShards); h e' il funtore hash
+    explicit ConcurrentDictionary(std::size_t shards = defaultShards,
+        const Hasher &h = Hasher());
+    ~ConcurrentDictionary(); // distruttore
+    // il dizionario e' condiviso fra piu' thread: non puo' essere copiato
+    ConcurrentDictionary(const ConcurrentDictionary<K, V, Hasher> &) = delete;
+    ConcurrentDictionary<K, V, Hasher> &operator=(
+        const ConcurrentDictionary<K, V, Hasher> &) = delete;
+
+    // restituisce true se il dizionario e' vuoto, false altrimenti
+    bool isEmpty() const { return getSize() == 0; }
+    // restituisce true se la chiave indicata e' presente nel dizionario
+    bool belongs(const K &) const;
+    // inserisce la coppia chiave-valore indicata nel dizionario, o ne
+    // modifica il valore se la chiave e' gia' presente
+    void insert(const K &, const V &);
+    void insert(K &&, V &&);
+    // rimuove la coppia con la chiave indicata. Restituisce false
+    // se la chiave non e' presente
+    bool remove(const K &);
+    // copia in value il valore corrispondente alla chiave indicata.
+    // Restituisce false, senza modificare value, se la chiave non e' presente
+    bool find(const K &, V &value) const;
+    // restituisce il numero di elementi contenuti nel dizionario
+    std::size_t getSize() const;
+    // restituisce il numero di shard
+    std::size_t getShards() const { return shardCount; }
+    // imposta il numero di liste spostate per operazione durante la
+    // ristrutturazione di uno shard (vedi Dictionary::setRehashStep)
+    void setRehashStep(std::size_t);
+    // stampa il dizionario
+    void print() const;
+    // chiama f(chiave, valore) su ciascuna coppia del dizionario, tenendo
+    // bloccati tutti gli shard: f non deve accedere al dizionario
+    template <typename F>
+    void forEach(F f) const;
+
+private:
+    static const std::size_t cacheLine = 64; // dimensione di una linea di cache
+    static const std::size_t defaultShards = 64;
+    static const std::size_t maxShards = 1 << 16;
+
+    // uno shard occupa un numero intero di linee di cache
+    struct alignas(cacheLine) Shard {
+        mutable std::mutex lock;
+        Dictionary<K, V, Hasher> table;
+
+        explicit Shard(const Hasher &h) : table(0, h) { }
+    };
+
+    void *buffer; // memoria allocata per gli shard
+    Shard *shards; // primo shard, allineato a una linea di cache
+    std::size_t shardCount; // numero di shard (potenza di 2)
+    unsigned shardBits; // log2(shardCount)
+    Hasher hasher; // funtore hash, copiato anche in ciascuno shard
+
+    // restituisce lo shard della chiave indicata
+    Shard &shardOf(const K &key) const
+    {
+        // rimescola il valore hash e ne prende i 32 bit alti, quindi
+        // i primi shardBits di questi
+        unsigned long long x = static_cast<unsigned long long>(
+            mixInteger(static_cast<unsigned long long>(hasher(key))));
+        return shards[(x >> 32) >> (32 - shardBits)];
+    }
+    // blocca tutti gli shard, in ordine, e alla distruzione sblocca quelli
+    // bloccati, anche se un'eccezione interrompe l'operazione in corso
+    class AllShardsLock {
+    public:
+        explicit AllShardsLock(const ConcurrentDictionary<K, V, Hasher> &d);
+        ~AllShardsLock();
+        AllShardsLock(const AllShardsLock &) = delete;
+        AllShardsLock &operator=(const AllShardsLock &) = delete;
+    private:
+        const Shard *shards;
+        std::size_t locked; // numero di shard bloccati
+    };
+};
+
+/*=== DEFINIZIONI FUNZIONI ===*/
+
+// costruttore
+template <typename K, typename V, typename Hasher>
+ConcurrentDictionary<K, V, Hasher>::ConcurrentDictionary(std::size_t n,
+    const Hasher &h)
+    : shardCount(1), shardBits(0), hasher(h)
+{
+    while (shardCount < n && shardCount < maxShards) {
+        shardCount *= 2;
+        ++shardBits;
+    }
+
+    // alloca una linea di cache in piu' per poter allineare il primo shard
+    buffer = ::operator new(shardCount * sizeof(Shard) + cacheLine);
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer);
+    address = (address + cacheLine - 1) & ~(cacheLine - 1);
+    shards = reinterpret_cast<Shard *>(address);
+    for (std::size_t i = 0; i < shardCount; ++i)
+        new (&shards[i]) Shard(hasher);
+}
+
+// distruttore
+template <typename K, typename V, typename Hasher>
+ConcurrentDictionary<K, V, Hasher>::~ConcurrentDictionary()
+{
+    for (std::size_t i = 0; i < shardCount; ++i)
+        shards[i].~Shard();
+    ::operator delete(buffer);
+}
+
+// overload operatore <<
+template <typename K, typename V, typename Hasher>
+std::ostream &operator<<(std::ostream &output,
+    const ConcurrentDictionary<K, V, Hasher> &d)
+{
+    d.print();
+    return output;
+}
+
+// restituisce true se la chiave e' presente. Usa Dictionary::find, che
+// (a differenza di belongs) non segnala errori se lo shard e' vuoto
+template <typename K, typename V, typename Hasher>
+bool ConcurrentDictionary<K, V, Hasher>::belongs(const K &key) const
+{
+    Shard &s = shardOf(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    return s.table.find(key) != 0;
+}
+
+// inserisce la coppia chiave-valore nello shard della chiave
+template <typename K, typename V, typename Hasher>
+void ConcurrentDictionary<K, V, Hasher>::insert(const K &key, const V &value)
+{
+    Shard &s = shardOf(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.table.insert(key, value);
+}
+
+// come sopra, ma sposta chiave e valore
+template <typename K, typename V, typename Hasher>
+void ConcurrentDictionary<K, V, Hasher>::insert(K &&key, V &&value)
+{
+    Shard &s = shardOf(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.table.insert(std::move(key), std::move(value));
+}
+
+// rimuove la coppia con la chiave indicata, se presente
+template <typename K, typename V, typename Hasher>
+bool ConcurrentDictionary<K, V, Hasher>::remove(const K &key)
+{
+    Shard &s = shardOf(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    if (s.table.find(key) == 0)
+        return false;
+    s.table.remove(key);
+    return true;
+}
+
+// copia in value il valore della chiave indicata, se presente
+template <typename K, typename V, typename Hasher>
+bool ConcurrentDictionary<K, V, Hasher>::find(const K &key, V &value) const
+{
+    Shard &s = shardOf(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    const V *found = s.table.find(key);
+    if (found == 0)
+        return false;
+    value = *found;
+    return true;
+}
+
+// restituisce il numero di elementi, sommando le dimensioni degli shard
+// mentre sono tutti bloccati
+template <typename K, typename V, typename Hasher>
+std::size_t ConcurrentDictionary<K, V, Hasher>::getSize() const
+{
+    AllShardsLock guard(*this);
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < shardCount; ++i)
+        size += shards[i].table.getSize();
+
+    return size;
+}
+
+// imposta il passo di ristrutturazione di tutti gli shard
+template <typename K, typename V, typename Hasher>
+void ConcurrentDictionary<K, V, Hasher>::setRehashStep(std::size_t step)
+{
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        shards[i].table.setRehashStep(step);
+    }
+}
+
+// stampa le coppie chiave-valore del dizionario
+template <typename K, typename V, typename Hasher>
+void ConcurrentDictionary<K, V, Hasher>::print() const
+{
+    AllShardsLock guard(*this);
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < shardCount; ++i)
+        size += shards[i].table.getSize();
+
+    if (size == 0) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+    } else {
+        std::cout << "KEYS : VALUES\n";
+        for (std::size_t i = 0; i < shardCount; ++i)
+            shards[i].table.forEach([](const K &key, const V &value) {
+                std::cout << key << " : " << value << "\n";
+            });
+    }
+}
+
+// chiama f su ciascuna coppia chiave-valore del dizionario
+template <typename K, typename V, typename Hasher>
+template <typename F>
+void ConcurrentDictionary<K, V, Hasher>::forEach(F f) const
+{
+    AllShardsLock guard(*this);
+    for (std::size_t i = 0; i < shardCount; ++i)
+        shards[i].table.forEach(f);
+}
+
+// blocca tutti gli shard in ordine di indice: le altre operazioni ne
+// bloccano uno solo, per cui non possono verificarsi stalli. Se un blocco
+// fallisce, il distruttore non viene chiamato: sblocca qui quelli bloccati
+template <typename K, typename V, typename Hasher>
+ConcurrentDictionary<K, V, Hasher>::AllShardsLock::AllShardsLock(
+    const ConcurrentDictionary<K, V, Hasher> &d)
+    : shards(d.shards), locked(0)
+{
+    try {
+        for (; locked < d.shardCount; ++locked)
+            shards[locked].lock.lock();
+    } catch (...) {
+        while (locked > 0)
+            shards[--locked].lock.unlock();
+        throw;
+    }
+}
+
+// sblocca gli shard bloccati dal costruttore, in ordine inverso
+template <typename K, typename V, typename Hasher>
+ConcurrentDictionary<K, V, Hasher>::AllShardsLock::~AllShardsLock()
+{
+    while (locked > 0)
+        shards[--locked].lock.unlock();
+}
+
+#endif
@@ -3,8 +3,53 @@
 // Al superamento delle soglie di fattore di carico maxLoadFactor e minLoadFactor,
 // la tabella voene ristrutturata: nel primo caso viene allocato un vettore di
 // dimensione doppia, nel secondo caso, di dimensione dimezzata, e tutti gli 
-// elementi sono copiati dal vecchio al nuovo vettore ricalcolando i relativi
-// valori hash.
+// elementi sono spostati dal vecchio al nuovo vettore ricalcolando i relativi
+// valori hash (i nodi delle liste vengono ricollegati, non copiati).
+// La dimensione del vettore e' sempre una potenza di 2 (quella indicata al
+// costruttore viene arrotondata per eccesso), per cui l'indice della lista
+// di una chiave si ricava senza divisioni: il valore hash viene moltiplicato
+// per 2^64 / phi (hashing di Fibonacci) e se ne prendono i bit alti, tanti
+// quanti ne servono per indicizzare il vettore. Cosi' l'indice dipende da
+// tutti i bit del valore hash anche per funzioni hash poco distribuite.
+// Con setRehashStep(n), n > 0, la ristrutturazione diventa incrementale:
+// il vecchio vettore viene mantenuto accanto al nuovo e ogni inserimento o
+// rimozione successivo sposta al massimo n liste dal vecchio al nuovo, per
+// cui nessuna operazione deve spostare tutti gli elementi. Finche' la
+// migrazione non e' completa, una chiave si trova nella vecchia tabella se
+// la sua lista non e' ancora stata spostata, altrimenti nella nuova.
+// Ogni operazione sposta almeno n liste, e piu' di n se necessario per
+// completare la migrazione prima di raggiungere la soglia successiva (ad
+// es. dopo un dimezzamento bastano capacity / 16 rimozioni per scendere di
+// nuovo sotto minLoadFactor); in ogni caso una nuova ristrutturazione non
+// inizia finche' la migrazione in corso non e' completa, altrimenti
+// dovrebbe completarla in una sola operazione.
+// I due vettori sono allocati senza costruire le liste: le liste del nuovo
+// vettore vengono costruite quando vi si spostano quelle del vecchio che le
+// alimentano e le liste del vecchio vengono distrutte appena svuotate, per
+// cui anche allocazione e deallocazione dei vettori hanno costo costante.
+// insertBatch e il costruttore da un intervallo di coppie dimensionano la
+// tabella una sola volta per tutto l'intervallo e inseriscono le coppie a
+// blocchi: prima calcolano i valori hash dell'intero blocco, poi, durante
+// gli inserimenti, caricano in anticipo le liste di trabocco delle coppie
+// successive, per cui gli accessi alla tabella (quasi sempre mancati nella
+// cache per tabelle grandi) si sovrappongono invece di susseguirsi.
+// findBatch cerca un gruppo di chiavi allo stesso modo: mentre risolve una
+// chiave, la tabella, la sentinella e il primo nodo delle chiavi successive
+// sono gia' in caricamento.
+// save scrive il dizionario in un file snapshot, che MappedDictionary mappa
+// in memoria per servire le ricerche senza ricostruire la tabella (vedi
+// Snapshot.h e MappedDictionary.h).
+// Il parametro Stats sceglie se raccogliere statistiche sulle operazioni
+// (vedi DictionaryStats.h): con NoStats, il default, non costano nulla;
+// stats() restituisce un'istantanea di contatori e lunghezze delle liste.
+// Il parametro Filter aggiunge un filtro di appartenenza approssimata
+// davanti alla tabella (vedi BloomFilter.h): con BloomFilter, find, belongs
+// e remove di una chiave assente terminano quasi sempre dopo aver letto una
+// sola linea di cache del filtro, senza scandire la lista di trabocco.
+// Durante una ristrutturazione incrementale il filtro della vecchia tabella
+// resta quello interrogato, mentre un secondo filtro, dimensionato per la
+// nuova, viene riempito man mano che le liste vengono spostate e lo
+// sostituisce a migrazione completata.
 
 #ifndef DICTIONARY_H
 #define DICTIONARY_H
@@ -12,42 +57,137 @@
 #include <iostream>
 #include <string>
 #include <stdexcept>
+#include <new>
+#include <utility>
+#include <iterator>
 #include "../LinkedList/LinkedList.h"
 #include "Hash.h"
+#include "Snapshot.h"
+#include "DictionaryStats.h"
+#include "BloomFilter.h"
+#include "TableMemory.h"
 
-template <typename K, typename V>
+template <typename K, typename V, typename Hasher = Hash<K>,
+    typename Stats = NoStats, typename Filter = NoFilter>
 class Dictionary;
 
-template <typename K, typename V>
-std::ostream &operator<<(std::ostream &, const Dictionary<K, V> &);
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+std::ostream &operator<<(std::ostream &,
+    const Dictionary<K, V, Hasher, Stats, Filter> &);
 
-template <typename K, typename V>
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
 class Dictionary {
-    friend std::ostream &operator<< <>(std::ostream &, const Dictionary<K, V> &);
+    friend std::ostream &operator<< <>(std::ostream &,
+        const Dictionary<K, V, Hasher, Stats, Filter> &);
 public: 
-    // costruttore di default
-    Dictionary(std::size_t c = defaultCapacity)
-        : size(0) { create(c); }
+    // costruttore di default: c e' il numero iniziale di liste di trabocco
+    // (defaultCapacity se 0, altrimenti arrotondato alla potenza di 2
+    // successiva), h il funtore hash
+    Dictionary(std::size_t c = defaultCapacity, const Hasher &h = Hasher())
+        : size(0), oldTable(0), oldCapacity(0), oldBits(0), migrated(0),
+          rehashStep(0), hasher(h)
+        { create(c); }
+    // costruttore da un intervallo di coppie chiave-valore (vedi insertBatch)
+    template <typename It, typename =
+        typename std::iterator_traits<It>::iterator_category>
+    Dictionary(It first, It last, const Hasher &h = Hasher())
+        : size(0), oldTable(0), oldCapacity(0), oldBits(0), migrated(0),
+          rehashStep(0), hasher(h)
+        { create(defaultCapacity); insertBatch(first, last); }
     // costruttore per copia
-    Dictionary(const Dictionary<K, V> &d); 	
+    Dictionary(const Dictionary<K, V, Hasher, Stats, Filter> &d);
     // distruttore
-    ~Dictionary() { delete [] table; }
+    ~Dictionary() { destroyTables(); }
     // operatore =
-    Dictionary<K, V> &operator=(const Dictionary<K, V> &);
+    Dictionary<K, V, Hasher, Stats, Filter> &operator=(
+        const Dictionary<K, V, Hasher, Stats, Filter> &);
 
     // restituisce true se il dizionario e' vuoto, false altrimenti
     bool isEmpty() const { return size == 0; }
     // restituisce true se la chiave indicata e' presente nel dizionario,
     // false altrimenti
-    bool belongs(const K&) const;
-    // inserisce la coppia chiave-valore indicata nel dizionario
-    void insert(K key, V value);
+    bool belongs(const K &key) const { return contains(key); }
+    // inserisce la coppia chiave-valore indicata nel dizionario. La
+    // seconda versione sposta chiave e valore invece di copiarli
+    void insert(const K &key, const V &value)
+        { emplace(hash(key), key, value); }
+    void insert(K &&key, V &&value)
+        { emplace(hash(key), std::move(key), std::move(value)); }
     // rimuove la coppia chiave-valore indicata dal dizionario
-    void remove(K);
+    void remove(const K &);
     // recupera il valore corrispondente alla chiave indicata
-    const V *find(const K&) const;
+    const V *find(const K &key) const { return lookup(key, hash(key)); }
+    // cerca le n chiavi del vettore keys e scrive in out[i] il puntatore al
+    // valore di keys[i], o 0 se la chiave non e' presente (come find).
+    // Restituisce il numero di chiavi trovate
+    std::size_t findBatch(const K *keys, std::size_t n, const V **out) const;
+
+    // ricerche eterogenee: se il funtore hash dichiara is_transparent (vedi
+    // Hash.h), belongs e find accettano anche chiavi di tipo Q diverso da K
+    // (ad es. const char * per chiavi std::string), senza costruire una K
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    bool belongs(const Q &key) const { return contains(key); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    const V *find(const Q &key) const { return lookup(key, hasher(key)); }
+
+    // valore hash precalcolato: hashOf restituisce il valore hash di una
+    // chiave, che findWithHash e insertWithHash usano invece di ricalcolarlo
+    // (ad es. per cercare la stessa chiave in piu' dizionari con lo stesso
+    // funtore hash). h deve essere il valore restituito da hashOf(key)
+    std::size_t hashOf(const K &key) const { return hash(key); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    std::size_t hashOf(const Q &key) const { return hasher(key); }
+    const V *findWithHash(const K &key, std::size_t h) const
+        { return lookup(key, h); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    const V *findWithHash(const Q &key, std::size_t h) const
+        { return lookup(key, h); }
+    void insertWithHash(const K &key, const V &value, std::size_t h)
+        { emplace(h, key, value); }
+    void insertWithHash(K &&key, V &&value, std::size_t h)
+        { emplace(h, std::move(key), std::move(value)); }
+    // inserisce le coppie dell'intervallo [first, last), i cui elementi
+    // hanno la chiave nel membro first e il valore nel membro second (ad es.
+    // std::pair<K, V>); con std::make_move_iterator chiavi e valori vengono
+    // spostati invece che copiati. Con iteratori forward (almeno) la tabella
+    // viene ristrutturata al piu' una volta, prima degli inserimenti
+    template <typename It>
+    void insertBatch(It first, It last)
+    {
+        insertBatch(first, last,
+            typename std::iterator_traits<It>::iterator_category());
+    }
+    // ristruttura subito la tabella, se necessario, in modo che possa
+    // contenere n elementi senza altre ristrutturazioni (anche con
+    // setRehashStep la migrazione viene completata subito)
+    void reserve(std::size_t n);
+    // scrive il dizionario nel file snapshot indicato (chiavi e valori
+    // devono essere banalmente copiabili o std::string). Restituisce false
+    // in caso di errore
+    bool save(const std::string &path) const
+        { return writeSnapshot<K, V>(path, *this); }
+    // restituisce un'istantanea delle statistiche: fattore di carico e
+    // lunghezze delle liste vengono calcolati scandendo la tabella, i
+    // contatori sono quelli della politica Stats (nulli con NoStats)
+    DictionaryStats stats() const;
+    // azzera i contatori della politica Stats
+    void resetStats() { statistics.reset(); }
     // restituisce il nuero di elementi contenuti nel dizionario
     std::size_t getSize() const { return size; }
+    // restituisce il numero di liste di trabocco della tabella
+    std::size_t getCapacity() const { return capacity; }
+    // imposta il numero di liste spostate a ogni inserimento o rimozione
+    // durante una ristrutturazione; 0 (il default) ristruttura l'intera
+    // tabella in una sola volta, completando l'eventuale migrazione in corso
+    void setRehashStep(std::size_t);
+    // restituisce true se e' in corso una ristrutturazione incrementale
+    bool isRehashing() const { return oldTable != 0; }
     // stampa il dizionario
     void print() const;
     // stampa i valori contenuti nel dizionario
@@ -56,16 +196,28 @@ public:
     void keys() const;
     // restituisce true se almeno una chiave e' mappata al valore indicato
     bool containsValue(const V &) const;
+    // chiama f(chiave, valore) su ciascuna coppia del dizionario, passando
+    // riferimenti costanti, per cui chiavi e valori non vengono copiati
+    template <typename F>
+    void forEach(F f) const;
 private:
 
-    // struct usata per rappresentare una coppia chiave-valore
+    // struct usata per rappresentare una coppia chiave-valore. Chiave e
+    // valore vengono costruiti direttamente nel nodo della lista di trabocco
     struct Pair {
         K key; // chiave
         V value; // valore
+
+        Pair() : key(), value() { }
+        template <typename KK, typename VV>
+        Pair(KK &&k, VV &&v)
+            : key(std::forward<KK>(k)), value(std::forward<VV>(v)) { }
     };
 
     typedef LinkedList<Pair> PairList;
     typedef typename PairList::Position ListPosition;
+    typedef typename PairList::iterator ChainIterator;
+    typedef typename PairList::const_iterator ChainConstIterator;
 
     // vettore di liste di trabocco utilizzato per rappresentare
     // la tabella hash
@@ -73,32 +225,127 @@ private:
     std::size_t size; // numero di elementi contenuti nel vettore
     std::size_t capacity; // dimensione massima del vettore
     // percio' il fattore di carico e' pari a size/capacity
+    unsigned bits; // bit dell'indice di una lista: capacity == 2^bits
+    // durante una ristrutturazione incrementale: vecchio vettore (0 se non
+    // c'e' una ristrutturazione in corso), sua dimensione e numero di liste
+    // gia' spostate nel nuovo vettore (quelle di indice minore)
+    PairList *oldTable;
+    std::size_t oldCapacity;
+    unsigned oldBits;
+    std::size_t migrated;
+    std::size_t rehashStep; // liste spostate per operazione (0 = tutte)
 
     static const std::size_t defaultCapacity = 16;
+    // coppie di cui insertBatch calcola i valori hash in anticipo
+    static const std::size_t batchBlock = 256;
+    // distanza, in inserimenti, fra le fasi del caricamento anticipato
+    static const std::size_t prefetchDistance = 8;
     static const float maxLoadFactor;
     static const float minLoadFactor;
     void create(std::size_t); // funzione di inizializzazione
+    // restituisce la piu' piccola potenza di 2 >= c (almeno 2)
+    static std::size_t roundCapacity(std::size_t c);
+    // restituisce l'indice della lista per il valore hash h in un vettore
+    // di 2^b liste: i b bit alti di h * 2^64 / phi
+    static std::size_t indexOf(std::size_t h, unsigned b)
+    {
+        return static_cast<std::size_t>((static_cast<unsigned long long>(h)
+            * 0x9E3779B97F4A7C15ULL) >> (64 - b));
+    }
+    // distrugge le liste costruite e dealloca i vettori
+    void destroyTables();
+    // alloca un vettore di n liste senza costruirle (vedi TableMemory.h)
+    static PairList *allocateTable(std::size_t n)
+    {
+        return static_cast<PairList *>(
+            allocateTableMemory(n * sizeof(PairList)));
+    }
+    // dealloca un vettore di n liste, gia' distrutte
+    static void deallocateTable(PairList *t, std::size_t n)
+        { freeTableMemory(t, n * sizeof(PairList)); }
     void resize(std::size_t); // modifica la dimensione del vettore
-
-    // funzione "wrapper": permette di chiamare funzioni hash esterne,
-    // a patto che il loro tipo di ritorno sia unsigned int.
-    // Poiche' la dimensione del vettore non e' necessariamente un numero
-    // primo, e' sconsigliabile usare funzioni hash che abbiano questo requisito.
+    // restituisce true se la lista i-esima del vettore e' gia' stata costruita
+    bool isBucketReady(std::size_t i) const;
+    // sposta nel nuovo vettore la lista i-esima del vecchio
+    void migrateBucket(std::size_t i);
+    // sposta al massimo n liste del vecchio vettore, liberandolo
+    // quando la migrazione e' completa
+    void migrate(std::size_t n);
+    // restituisce il numero di liste da spostare nell'operazione corrente
+    std::size_t migrationStep() const;
+    // restituisce la lista di trabocco che contiene (o conterrebbe) le
+    // chiavi con valore hash h
+    PairList &bucket(std::size_t h) const
+    {
+        if (oldTable != 0) {
+            std::size_t i = indexOf(h, oldBits);
+            if (i >= migrated)
+                return oldTable[i];
+        }
+        return table[indexOf(h, bits)];
+    }
+    // restituisce true se durante una ristrutturazione incrementale la
+    // lista delle chiavi con valore hash h e' gia' nel nuovo vettore
+    bool isMigrated(std::size_t h) const
+        { return oldTable != 0 && indexOf(h, oldBits) < migrated; }
+    // carica in anticipo le liste di trabocco dei valori hash successivi
+    // all'i-esimo fra i primi ahead del vettore hashes (vedi insertBatch)
+    void prefetchBuckets(const std::size_t *hashes, std::size_t i,
+        std::size_t ahead) const;
+    // carica in anticipo nella cache la riga che contiene l'indirizzo p
+    static void prefetch(const void *p)
+    {
+#ifdef __GNUC__
+        __builtin_prefetch(p);
+#else
+        (void) p;
+#endif
+    }
+    // insertBatch per iteratori di input (una sola passata) e forward
+    template <typename It>
+    void insertBatch(It first, It last, std::input_iterator_tag);
+    template <typename It>
+    void insertBatch(It first, It last, std::forward_iterator_tag);
+    // chiama f su ciascuna lista di trabocco, di entrambi i vettori
+    // durante una ristrutturazione incrementale
+    template <typename F>
+    void forEachBucket(F f) const;
+    // inserisce una coppia con valore hash h inoltrando chiave e valore
+    // al costruttore di Pair
+    template <typename KK, typename VV>
+    void emplace(std::size_t h, KK &&, VV &&);
+    // implementazione di belongs e find per chiavi di tipo K o Q
+    template <typename Q>
+    bool contains(const Q &) const;
+    template <typename Q>
+    const V *lookup(const Q &, std::size_t h) const;
+
+    Hasher hasher; // funtore hash (di default Hash<K>, vedi Hash.h)
+    // politica di statistica; i contatori appartengono al singolo oggetto,
+    // per cui non vengono copiati ne' assegnati
+    Stats statistics;
+    // filtro di appartenenza approssimata (di default NoFilter) e, durante
+    // una ristrutturazione incrementale, filtro della nuova tabella
+    Filter filter;
+    Filter newFilter;
+
+    // funzione "wrapper": chiama il funtore hash del dizionario.
     // Poiche' il valore intero prodotto puo' essere molto grande,
     // per ricavare un indice valido le funzioni della classe Dictionary
-    // calcolano il modulo tra questo valore e la dimensione del vettore stesso.
-    // Attualmente chiama una funzione presente nel file Hash.h
-    std::size_t hash(const K &k) const { return getHash<K>(k);}
+    // lo riducono con indexOf alla dimensione del vettore stesso.
+    std::size_t hash(const K &k) const { return hasher(k); }
 };
 
 // costante che rappresenta il massimo fattore di carico superato il quale
 // la dimensione del vettore viene raddoppiata
-template <typename K, typename V>
-const float Dictionary<K, V>::maxLoadFactor = 2.0;
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+const float Dictionary<K, V, Hasher, Stats, Filter>::maxLoadFactor = 2.0;
 // costante che rappresenta il fattore di carico minimo al di sotto del quale
 // la dimensione del vettore viene dimezzata
-template <typename K, typename V>
-const float Dictionary<K, V>::minLoadFactor = 0.125;
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+const float Dictionary<K, V, Hasher, Stats, Filter>::minLoadFactor = 0.125;
 
 
 /*===========================================================================*/
@@ -106,295 +353,661 @@ const float Dictionary<K, V>::minLoadFactor = 0.125;
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename K, typename V>
-std::ostream &operator<<(std::ostream &output, const Dictionary<K, V> &d)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+std::ostream &operator<<(std::ostream &output,
+    const Dictionary<K, V, Hasher, Stats, Filter> &d)
 {
     d.print();
     return output;
 }
 
-// costruttore per copia
-template <typename K, typename V>
-Dictionary<K, V>::Dictionary(const Dictionary<K, V> &d)
+// costruttore per copia: copia anche l'eventuale ristrutturazione in corso,
+// costruendo solo le liste costruite in d
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+Dictionary<K, V, Hasher, Stats, Filter>::Dictionary(
+    const Dictionary<K, V, Hasher, Stats, Filter> &d)
+    : size(d.size), capacity(d.capacity), bits(d.bits), oldTable(0),
+      oldCapacity(d.oldCapacity), oldBits(d.oldBits), migrated(d.migrated),
+      rehashStep(d.rehashStep), hasher(d.hasher), filter(d.filter),
+      newFilter(d.newFilter)
 {
-    capacity = d.capacity;
-    size = d.size;
-    table = new PairList[capacity];
+    if (d.oldTable != 0)
+        oldTable = allocateTable(oldCapacity);
+    table = allocateTable(capacity);
 
+    // copia gli elementi
     for (std::size_t i = 0; i < capacity; ++i)
-        table[i] = d.table[i];
+        if (d.isBucketReady(i))
+            new (&table[i]) PairList(d.table[i]);
+    if (oldTable != 0)
+        for (std::size_t i = migrated; i < oldCapacity; ++i)
+            new (&oldTable[i]) PairList(d.oldTable[i]);
 }
 
 // overload operatore di assegnamento =
-template <typename K, typename V>
-Dictionary<K, V> &Dictionary<K, V>::operator=(const Dictionary<K, V> &d)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+Dictionary<K, V, Hasher, Stats, Filter> &
+Dictionary<K, V, Hasher, Stats, Filter>::operator=(
+    const Dictionary<K, V, Hasher, Stats, Filter> &d)
 {
     if (&d != this) { // evita l'autoassegnazione
-        if (capacity != d.capacity) { // se i due array hanno dimensione
-            delete [] table;          // diversa, dealloca quello di sinistra
-            capacity = d.capacity;    // e alloca un nuovo array di capacita'
-                                      // uguale a quello da copiare
-            table = new PairList[capacity];
-        }
-
-        // copia gli elementi
-        for (std::size_t i = 0; i < capacity; ++i)
-            table[i] = d.table[i];
-
-        size = d.size;  // setta il numero di elementi
+        // copia d in un dizionario temporaneo e ne scambia il contenuto con
+        // quello di sinistra, che viene distrutto insieme al temporaneo
+        Dictionary<K, V, Hasher, Stats, Filter> temp(d);
+        std::swap(table, temp.table);
+        std::swap(size, temp.size);
+        std::swap(capacity, temp.capacity);
+        std::swap(bits, temp.bits);
+        std::swap(oldTable, temp.oldTable);
+        std::swap(oldCapacity, temp.oldCapacity);
+        std::swap(oldBits, temp.oldBits);
+        std::swap(migrated, temp.migrated);
+        std::swap(rehashStep, temp.rehashStep);
+        std::swap(hasher, temp.hasher);
+        filter.swap(temp.filter);
+        newFilter.swap(temp.newFilter);
+        // i contatori di statistics restano quelli di questo oggetto
     }
 
     return *this; // consente a = b = c
 }
 
 // alloca memoria per il vettore.
-template <typename K, typename V>
-void Dictionary<K, V>::create(unsigned int c)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::create(std::size_t c)
 {
     // crea un vettore di liste di trabocco di max capacity elementi
-    if (c > 0)
-        capacity = c;
+    capacity = roundCapacity(c > 0 ? c : defaultCapacity);
+    for (bits = 0; (std::size_t(1) << bits) < capacity; ++bits)
+        ;
+
+    table = allocateTable(capacity);
+    for (std::size_t i = 0; i < capacity; ++i)
+        new (&table[i]) PairList;
+    filter.create(capacity);
+}
+
+// restituisce la piu' piccola potenza di 2 >= c. Il minimo e' 2, in modo
+// che indexOf non debba scorrere di 64 bit
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+std::size_t Dictionary<K, V, Hasher, Stats, Filter>::roundCapacity(
+    std::size_t c)
+{
+    std::size_t rounded = 2;
+    while (rounded < c)
+        rounded *= 2;
+    return rounded;
+}
 
-    table = new PairList[capacity];
+// distrugge le liste costruite di entrambi i vettori e li dealloca
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::destroyTables()
+{
+    for (std::size_t i = 0; i < capacity; ++i)
+        if (isBucketReady(i))
+            table[i].~PairList();
+    deallocateTable(table, capacity);
+
+    if (oldTable != 0) {
+        for (std::size_t i = migrated; i < oldCapacity; ++i)
+            oldTable[i].~PairList();
+        deallocateTable(oldTable, oldCapacity);
+    }
+}
+
+// l'indice di una lista e' formato dai bit alti del valore hash
+// rimescolato, per cui durante una ristrutturazione con dimensione doppia
+// la lista i del nuovo vettore riceve elementi solo dalla lista i / 2 del
+// vecchio; con dimensione dimezzata, dalle liste 2i e 2i + 1. Viene quindi
+// costruita quando viene spostata la prima di queste (vedi migrateBucket)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+bool Dictionary<K, V, Hasher, Stats, Filter>::isBucketReady(
+    std::size_t i) const
+{
+    if (oldTable == 0)
+        return true;
+    if (capacity > oldCapacity)
+        return i / 2 < migrated;
+    return 2 * i < migrated;
 }
 
 // verifica se la chiave indicata e' presente nel dizionario
-template <typename K, typename V>
-bool Dictionary<K, V>::belongs(const K &key) const
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename Q>
+bool Dictionary<K, V, Hasher, Stats, Filter>::contains(const Q &key) const
 {
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Cannot find key: Dictionary is empty!\n";
+        statistics.countBelongs(0);
         return false;
     }
 
     // calcola il valore hash per sapere quale lista potrebbe
-    // contenere la chiave
-    std::size_t h = hash(key) % capacity;
-    ListPosition p = table[h].begin();
+    // contenere la chiave, se il filtro non la esclude
+    std::size_t h = hasher(key);
+    if (!filter.mayContain(h)) {
+        statistics.countBelongs(0);
+        return false;
+    }
+    const PairList &list = bucket(h);
 
     // scandisce la lista alla ricerca della chiave
-    while (!table[h].finished(p)) {
-        if (table[h].read(p).key == key)
+    std::size_t probes = 0; // chiavi confrontate
+    for (ChainConstIterator it = list.ibegin(); it != list.iend(); ++it) {
+        ++probes;
+        if (it->key == key) {
+            statistics.countBelongs(probes);
             return true;
-        p = table[h].next(p);
+        }
     }
 
+    statistics.countBelongs(probes);
     return false; // se la chiave non e' presente
 }
 
 // utility function per modificare le dimensioni del vettore. Alloca un
-// nuovo vettore di dimensioni newCapacity e copia il contenuto del vecchio
-// vettore nel nuovo, dopodiche' cancella il vecchio vettore.
-template <typename K, typename V>
-void Dictionary<K, V>::resize(unsigned int newCapacity)
+// nuovo vettore di dimensioni newCapacity (doppia o meta' di quella
+// attuale) e sposta i nodi delle liste del
+// vecchio vettore in quelle del nuovo (senza copiare gli elementi ne'
+// allocare nuovi nodi), dopodiche' cancella il vecchio vettore.
+// Se la ristrutturazione e' incrementale le liste vengono spostate
+// dalle operazioni successive (vedi migrate)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::resize(std::size_t newCapacity)
 {
     if (newCapacity <= 0)
         throw std::invalid_argument("newCapacity must be > 0!");
 
+    // completa l'eventuale ristrutturazione precedente
+    if (oldTable != 0)
+        migrate(oldCapacity);
+
+    statistics.countResize();
+
     // alloca un nuovo vettore di dimensione newCapacity
-    PairList *temp = new PairList[newCapacity];
-
-    // ricalcola i valori hash di ciascun elemento del vettore
-    // originale e copia tutti gli elementi nel nuovo vettore
-    std::size_t h; // indice calcolato dalla funzione hash
-    ListPosition pos;
-    for (std::size_t i = 0; i < capacity; ++i) {
-        if (!table[i].isEmpty()) {
-            pos = table[i].begin();
-            while (!table[i].finished(pos)) {
-                h = hash(table[i].read(pos).key) % (newCapacity);
-                temp[h].pushFront(table[i].read(pos));
-                pos = table[i].next(pos);
-            }
-        }
-    }
-    capacity = newCapacity;
-    delete [] table;
+    PairList *temp = allocateTable(newCapacity);
+    oldTable = table;
+    oldCapacity = capacity;
+    migrated = 0;
+    oldBits = bits;
     table = temp;
+    capacity = newCapacity;
+    bits = capacity > oldCapacity ? bits + 1 : bits - 1;
+    newFilter.create(capacity);
+
+    if (rehashStep == 0)
+        migrate(oldCapacity);
+}
+
+// sposta nel nuovo vettore la lista i-esima del vecchio: costruisce le liste
+// del nuovo vettore che ne riceveranno gli elementi (vedi isBucketReady),
+// ricalcola i valori hash di ciascun elemento e ne sposta il nodo in testa
+// alla nuova lista, dopodiche' distrugge la lista svuotata
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::migrateBucket(std::size_t i)
+{
+    if (capacity > oldCapacity) {
+        new (&table[2 * i]) PairList;
+        new (&table[2 * i + 1]) PairList;
+    } else if (i % 2 == 0) {
+        new (&table[i / 2]) PairList;
+    }
+
+    PairList &list = oldTable[i];
+    std::size_t h, j; // valore hash e indice nel nuovo vettore
+    ListPosition pos = list.begin(), next;
+    while (!list.finished(pos)) {
+        next = list.next(pos);
+        h = hash(list.read(pos).key);
+        newFilter.add(h);
+        j = indexOf(h, bits);
+        table[j].splice(table[j].begin(), list, pos, pos);
+        pos = next;
+    }
+    list.~PairList();
+}
+
+// sposta al massimo n liste del vecchio vettore e, se sono state spostate
+// tutte, cancella il vecchio vettore e ne sostituisce il filtro con quello
+// del nuovo
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::migrate(std::size_t n)
+{
+    std::uint64_t start = statistics.startTimer();
+    for (; n > 0 && migrated < oldCapacity; --n)
+        migrateBucket(migrated++);
+    statistics.stopTimer(start);
+
+    if (migrated == oldCapacity) {
+        deallocateTable(oldTable, oldCapacity);
+        oldTable = 0;
+        oldCapacity = 0;
+        migrated = 0;
+        filter.swap(newFilter);
+        newFilter.clear();
+    }
+}
+
+// liste da spostare per operazione: almeno rehashStep, ma abbastanza da
+// completare la migrazione prima che il fattore di carico possa raggiungere
+// una delle soglie della nuova tabella, che farebbe iniziare la
+// ristrutturazione successiva. Dopo un dimezzamento, ad es., la soglia
+// minLoadFactor e' a capacity / 16 rimozioni, per cui vengono spostate
+// almeno 16 liste per rimozione; dopo un raddoppio basta una lista
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+std::size_t Dictionary<K, V, Hasher, Stats, Filter>::migrationStep() const
+{
+    std::size_t high = static_cast<std::size_t>(maxLoadFactor * capacity);
+    std::size_t low = static_cast<std::size_t>(minLoadFactor * capacity);
+    // operazioni che mancano alla soglia piu' vicina (almeno 1)
+    std::size_t ops = high > size ? high - size : 1;
+    if (size > low && size - low < ops)
+        ops = size - low;
+    std::size_t needed = (oldCapacity - migrated + ops - 1) / ops;
+    return needed > rehashStep ? needed : rehashStep;
+}
+
+// imposta il numero di liste spostate per operazione
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::setRehashStep(std::size_t step)
+{
+    rehashStep = step;
+    if (rehashStep == 0 && oldTable != 0)
+        migrate(oldCapacity);
 }
 
 // inserisce la coppia chiave-valore indicata nella tabella
-// se e' gia' presente la stessa chiave, sovrascrive il valore associato
-template <typename K, typename V>
-void Dictionary<K, V>::insert(K key, V val)
+// se e' gia' presente la stessa chiave, sovrascrive il valore associato.
+// Chiave e valore vengono copiati o spostati una sola volta, direttamente
+// nel nodo della lista (o, se la chiave e' gia' presente, nel valore)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename KK, typename VV>
+void Dictionary<K, V, Hasher, Stats, Filter>::emplace(std::size_t h,
+    KK &&key, VV &&val)
 {
-    // calcola il valore hash per determinare la lista di trabocco
+    // prosegue l'eventuale ristrutturazione incrementale
+    if (oldTable != 0)
+        migrate(migrationStep());
+
+    // il valore hash determina la lista di trabocco
     // in cui inserire l'elemento
-    std::size_t h = hash(key) % capacity;
-    Pair element;
-    element.key = key;
-    element.value = val;
+    PairList &list = bucket(h);
 
     // poiche' non sono ammessi duplicati di una stessa chiave,
     // cerca la chiave per vedere se e' gia' presente
-    ListPosition p = table[h].begin();
-    while (!table[h].finished(p)) {
-        if (table[h].read(p).key == key) {
-            // in tal caso sovrascrive l'elemento associato e termina
-            table[h].write(p, element);
+    std::size_t probes = 0; // chiavi confrontate
+    for (ChainIterator it = list.ibegin(); it != list.iend(); ++it) {
+        ++probes;
+        if (it->key == key) {
+            // in tal caso sovrascrive il valore associato e termina
+            it->value = std::forward<VV>(val);
+            statistics.countInsert(probes);
             return;
         }
-        p = table[h].next(p);
     }
+    statistics.countInsert(probes);
 
     // altrimenti aggiunge semplicemente l'elemento in testa alla lista
     // (in questo modo la ricerca dell'elemento inserito per ultimo nella
     // lista ha tempo costante)
-    table[h].pushFront(element);
+    list.emplaceFront(std::forward<KK>(key), std::forward<VV>(val));
     ++size;
+    filter.add(h);
+    if (isMigrated(h))
+        newFilter.add(h);
 
     // se il fattore di carico supera la soglia maxLoadFactor, raddoppia
-    // le dimensioni del vettore
-    if (static_cast<float>(size) / capacity > maxLoadFactor)
+    // le dimensioni del vettore (dopo l'eventuale migrazione in corso)
+    if (oldTable == 0 && static_cast<float>(size) / capacity > maxLoadFactor)
         resize(capacity * 2);
 }
 
+// inserisce le coppie di un intervallo che puo' essere letto una sola
+// volta: il numero di coppie non e' noto in anticipo, per cui vengono
+// inserite una alla volta
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename It>
+void Dictionary<K, V, Hasher, Stats, Filter>::insertBatch(It first, It last,
+    std::input_iterator_tag)
+{
+    for (; first != last; ++first)
+        emplace(hash((*first).first), (*first).first, (*first).second);
+}
+
+// inserisce le coppie di un intervallo che puo' essere letto piu' volte.
+// Dopo aver dimensionato la tabella per tutte le coppie, le inserisce a
+// blocchi di batchBlock: per ciascun blocco calcola prima tutti i valori
+// hash (un ciclo senza dipendenze fra le iterazioni), poi inserisce le
+// coppie caricando in anticipo, in tre fasi distanti prefetchDistance
+// inserimenti, la lista di trabocco (nel vettore), la sua sentinella e il
+// primo nodo della lista, che emplace legge per cercare duplicati. Ogni
+// fase legge solo dati caricati dalla fase precedente. I valori hash delle
+// prime 3 * prefetchDistance coppie del blocco successivo vengono calcolati
+// in anticipo, per cui il caricamento anticipato prosegue anche a cavallo
+// fra due blocchi
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename It>
+void Dictionary<K, V, Hasher, Stats, Filter>::insertBatch(It first, It last,
+    std::forward_iterator_tag)
+{
+    reserve(size + static_cast<std::size_t>(std::distance(first, last)));
+
+    const std::size_t d = prefetchDistance;
+    std::size_t hashes[batchBlock + 3 * d];
+    while (first != last) {
+        // calcola i valori hash delle coppie del blocco (al massimo
+        // batchBlock) e delle 3 * d successive
+        std::size_t n = 0, ahead = 0;
+        for (It it = first; ahead < batchBlock + 3 * d && it != last; ++it) {
+            hashes[ahead++] = hash((*it).first);
+            if (n < batchBlock)
+                ++n;
+        }
+
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            prefetchBuckets(hashes, i, ahead);
+            emplace(hashes[i], (*first).first, (*first).second);
+        }
+    }
+}
+
+// cerca un gruppo di chiavi a blocchi, come insertBatch: calcola i valori
+// hash di un blocco (e delle 3 * prefetchDistance chiavi successive),
+// dopodiche' risolve le chiavi nell'ordine, caricando in anticipo le liste
+// di trabocco di quelle successive. Resta dipendente solo la scansione
+// delle liste oltre il primo nodo, che con il fattore di carico al piu'
+// maxLoadFactor e' breve
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+std::size_t Dictionary<K, V, Hasher, Stats, Filter>::findBatch(const K *keys,
+    std::size_t n, const V **out) const
+{
+    const std::size_t d = prefetchDistance;
+    std::size_t hashes[batchBlock + 3 * d];
+    std::size_t found = 0;
+    for (std::size_t base = 0; base < n; base += batchBlock) {
+        std::size_t ahead = n - base < batchBlock + 3 * d ?
+            n - base : batchBlock + 3 * d;
+        std::size_t count = ahead < batchBlock ? ahead : batchBlock;
+        for (std::size_t i = 0; i < ahead; ++i)
+            hashes[i] = hash(keys[base + i]);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            prefetchBuckets(hashes, i, ahead);
+            out[base + i] = lookup(keys[base + i], hashes[i]);
+            if (out[base + i] != 0)
+                ++found;
+        }
+    }
+
+    return found;
+}
+
+// fasi del caricamento anticipato per la chiave i-esima: lista nel vettore
+// per la chiave i + 3d, sentinella per la i + 2d, primo nodo per la i + d
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::prefetchBuckets(
+    const std::size_t *hashes, std::size_t i, std::size_t ahead) const
+{
+    const std::size_t d = prefetchDistance;
+    if (i + 3 * d < ahead)
+        prefetch(&bucket(hashes[i + 3 * d]));
+    if (i + 2 * d < ahead)
+        prefetch(bucket(hashes[i + 2 * d]).iend().getNode());
+    if (i + d < ahead)
+        prefetch(bucket(hashes[i + d]).begin());
+}
+
+// dimensiona la tabella per n elementi: raddoppia la capacita' finche' il
+// fattore di carico con n elementi non supera maxLoadFactor (con lo stesso
+// confronto di emplace, che quindi non ristruttura fino a n elementi)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::reserve(std::size_t n)
+{
+    std::size_t newCapacity = capacity;
+    while (static_cast<float>(n) / newCapacity > maxLoadFactor)
+        newCapacity *= 2;
+    if (newCapacity == capacity)
+        return;
+
+    if (size == 0) {
+        // tabella vuota: non ci sono nodi da spostare, per cui la sostituisce
+        // direttamente con una tabella della nuova dimensione
+        destroyTables();
+        oldTable = 0;
+        oldCapacity = 0;
+        migrated = 0;
+        newFilter.clear();
+        create(newCapacity);
+    } else {
+        // migrateBucket sposta le liste solo in un vettore di dimensione
+        // doppia, per cui la tabella viene raddoppiata piu' volte
+        while (capacity < newCapacity) {
+            resize(capacity * 2);
+            if (oldTable != 0)
+                migrate(oldCapacity);
+        }
+    }
+}
+
 // rimuove la coppia chiave-valore indicata dalla tabella, se presente
-template <typename K, typename V>
-void Dictionary<K, V>::remove(K key)
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::remove(const K &key)
 {
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Cannot remove item: Dictionary is empty!\n";
         return;
     }
 
+    // prosegue l'eventuale ristrutturazione incrementale
+    if (oldTable != 0)
+        migrate(migrationStep());
+
     // calcola il valore hash per determinare la lista di trabocco
-    // che potrebbe contenere l'elemento
-    std::size_t h = hash(key) % capacity;
-    ListPosition p = table[h].begin();
+    // che potrebbe contenere l'elemento, se il filtro non lo esclude
+    std::size_t h = hash(key);
+    if (!filter.mayContain(h)) {
+        std::cerr << "Cannot remove item: key not found!\n";
+        return;
+    }
+    PairList &list = bucket(h);
+    ListPosition p = list.begin();
 
-    while (!table[h].finished(p)) {
-        if (table[h].read(p).key == key) {
-            table[h].remove(p);
+    while (!list.finished(p)) {
+        if (list.read(p).key == key) {
+            list.remove(p);
             --size;
-            // se il fattore di carico scende sotto la soglia minLoadFactor, dimezza
-            // le dimensioni del vettore
-            if (static_cast<float>(size) / capacity < minLoadFactor)
+            filter.erase(h);
+            if (isMigrated(h))
+                newFilter.erase(h);
+            // se il fattore di carico scende sotto la soglia minLoadFactor,
+            // dimezza le dimensioni del vettore (ma non sotto defaultCapacity)
+            // dopo l'eventuale migrazione in corso
+            if (oldTable == 0 && capacity > defaultCapacity
+                    && static_cast<float>(size) / capacity < minLoadFactor)
                 resize(capacity / 2);
 
             return;
         }
-        p = table[h].next(p);
+        p = list.next(p);
     }
     // se l'elemento non e' presente
     std::cerr << "Cannot remove item: key not found!\n";
 }
 
-// recupera il valore corrispondente alla chiave indicata
-template <typename K, typename V>
-const V *Dictionary<K, V>::find(const K &key) const
+// recupera il valore corrispondente alla chiave indicata, il cui valore
+// hash e' h
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename Q>
+const V *Dictionary<K, V, Hasher, Stats, Filter>::lookup(const Q &key,
+    std::size_t h) const
 {
-    // calcola il valore hash per determinare la lista di trabocco
+    // il filtro esclude (quasi tutte) le chiavi assenti
+    if (!filter.mayContain(h)) {
+        statistics.countFind(0);
+        return 0;
+    }
+
+    // il valore hash determina la lista di trabocco
     // che potrebbe contenere l'elemento
-    std::size_t h = hash(key) % capacity;
-    ListPosition p = table[h].begin();
-    if (!table[h].isEmpty()) {
-
-        // scandisce la lista alla ricerca dell'elemento
-        while (!table[h].finished(p) &&
-                table[h].read(p).key != key) {
-            p = table[h].next(p);
+    const PairList &list = bucket(h);
+
+    // scandisce la lista alla ricerca dell'elemento; se lo trova,
+    // restituisce un puntatore costante all'oggetto
+    std::size_t probes = 0; // chiavi confrontate
+    for (ChainConstIterator it = list.ibegin(); it != list.iend(); ++it) {
+        ++probes;
+        if (it->key == key) {
+            statistics.countFind(probes);
+            return &it->value;
         }
-        // se lo trova, restituisce un puntatore costante
-        // all'oggetto
-        if (table[h].read(p).key == key)
-            return &table[h].read(p).value;
     }
+
     // altrimenti, restituisce NIL
+    statistics.countFind(probes);
     return 0;
 }
 
 // stampa il dizionario
-template <typename K, typename V>
-void Dictionary<K, V>::print() const
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::print() const
 {	
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Dictionary is empty!\n";
         return;
     }
 
-    ListPosition p; // per scandire una lista di trabocco
-    Pair current; // elemento(chiave-valore) corrente
     std::cout << "KEYS : VALUES\n";
-    for (std::size_t i = 0; i < capacity; ++i) {
-        if (!table[i].isEmpty()) {
-            for(p = table[i].begin(); !table[i].finished(p);
-                    p = table[i].next(p)) {
-                current = table[i].read(p);
-                std::cout << current.key << " : " << current.value << "\n";
-            }
-        }
-    }
+    forEach([](const K &key, const V &value) {
+        std::cout << key << " : " << value << "\n";
+    });
 }
 
 // stampa i valori contenuti nel dizionario
-template <typename K, typename V>
-void Dictionary<K, V>::values() const
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::values() const
 {	
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Dictionary is empty!\n";
         return;
     }
 
-    ListPosition p; // per scandire una lista di trabocco
-    V currentValue; // valore corrente
-
-    for (std::size_t i = 0; i < capacity; ++i) {
-        if (!table[i].isEmpty()) {
-            for(p = table[i].begin(); !table[i].finished(p);
-                    p = table[i].next(p)) {
-                currentValue = table[i].read(p).value;
-                std::cout << currentValue << "\n";
-            }
-        }
-    }
+    forEach([](const K &, const V &value) { std::cout << value << "\n"; });
 }
 
 // stampa le chiavi contenute nel dizionario
-template <typename K, typename V>
-void Dictionary<K, V>::keys() const
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+void Dictionary<K, V, Hasher, Stats, Filter>::keys() const
 {	
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Dictionary is empty!\n";
         return;
     }
 
-    ListPosition p; // per scandire una lista di trabocco
-    K currentKey; // chiave corrente
-
-    for (std::size_t i = 0; i < capacity; ++i) {
-        if (!table[i].isEmpty()) {
-            for(p = table[i].begin(); !table[i].finished(p);
-                    p = table[i].next(p)) {
-                currentKey = table[i].read(p).key;
-                std::cout << currentKey << "\n";
-            }
-        }
-    }
+    forEach([](const K &key, const V &) { std::cout << key << "\n"; });
 }
 
 // restituisce true se almeno una chiave e' mappata al valore indicato
-template <typename K, typename V>
-bool Dictionary<K, V>::containsValue(const V &val) const
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+bool Dictionary<K, V, Hasher, Stats, Filter>::containsValue(const V &val) const
 {	
     if (isEmpty()) { // controlla se il dizionario e' vuoto
         std::cerr << "Dictionary is empty!\n";
         return false;
     }
 
-    ListPosition p; // per scandire una lista di trabocco
+    // scandisce le liste di trabocco alla ricerca del valore
+    bool found = false;
+    forEachBucket([&found, &val](const PairList &list) {
+        for (ListPosition p = list.begin(); !found && !list.finished(p);
+                p = list.next(p))
+            if (list.read(p).value == val)
+                found = true;
+    });
 
-    for (std::size_t i = 0; i < capacity; ++i) {
-        if (!table[i].isEmpty()) {
-            for(p = table[i].begin(); !table[i].finished(p);
-                    p = table[i].next(p)) {
-                if	(table[i].read(p).value == val)
-                    return true;
-            }
-        }
-    }
+    return found; // false se il valore non e' contenuto
+}
 
-    return false; // se il valore non e' contenuto
+// restituisce un'istantanea delle statistiche: scandisce le liste di
+// entrambi i vettori per calcolarne le lunghezze, poi vi aggiunge i
+// contatori della politica Stats
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+DictionaryStats Dictionary<K, V, Hasher, Stats, Filter>::stats() const
+{
+    DictionaryStats s;
+    s.size = size;
+    s.capacity = capacity;
+    s.loadFactor = static_cast<double>(size) / capacity;
+    s.rehashing = isRehashing();
+
+    std::size_t nonEmpty = 0; // liste non vuote
+    forEachBucket([&s, &nonEmpty](const PairList &list) {
+        std::size_t length = 0;
+        for (ChainConstIterator it = list.ibegin(); it != list.iend(); ++it)
+            ++length;
+        if (length >= s.chainLengths.size())
+            s.chainLengths.resize(length + 1, 0);
+        ++s.chainLengths[length];
+        if (length > 0)
+            ++nonEmpty;
+    });
+    s.maxChain = s.chainLengths.size() - 1;
+    s.meanChain = nonEmpty > 0 ? static_cast<double>(size) / nonEmpty : 0;
+
+    statistics.copyTo(s);
+    return s;
+}
+
+// chiama f su ciascuna coppia chiave-valore del dizionario
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename F>
+void Dictionary<K, V, Hasher, Stats, Filter>::forEach(F f) const
+{
+    forEachBucket([&f](const PairList &list) {
+        for (const Pair &current : list.items())
+            f(current.key, current.value);
+    });
+}
+
+// chiama f sulle liste del vettore e su quelle non ancora
+// spostate dell'eventuale vecchio vettore
+template <typename K, typename V, typename Hasher, typename Stats,
+    typename Filter>
+template <typename F>
+void Dictionary<K, V, Hasher, Stats, Filter>::forEachBucket(F f) const
+{
+    for (std::size_t i = 0; i < capacity; ++i)
+        if (isBucketReady(i))
+            f(static_cast<const PairList &>(table[i]));
+    if (oldTable != 0)
+        for (std::size_t i = migrated; i < oldCapacity; ++i)
+            f(static_cast<const PairList &>(oldTable[i]));
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+// By Fabio Nardelli
+// Scelta dell'organizzazione della tabella hash tramite una politica:
+//   DictionaryFor<K, V, Chaining>::type        e' Dictionary<K, V>
+//                                               (liste di trabocco);
+//   DictionaryFor<K, V, OpenAddressing>::type  e' FlatDictionary<K, V>
+//                                               (indirizzamento aperto).
+// Le due classi hanno la stessa interfaccia pubblica, per cui il codice che
+// usa il dizionario puo' ricevere la politica come parametro template:
+//   template <typename Layout>
+//   void countWords(typename DictionaryFor<std::string, int, Layout>::type &);
+// Il quarto parametro e' il funtore hash passato alla classe scelta.
+
+#ifndef DICTIONARY_FOR_H
+#define DICTIONARY_FOR_H
+
+#include "Dictionary.h"
+#include "FlatDictionary.h"
+
+// politiche di organizzazione della tabella
+struct Chaining { };
+struct OpenAddressing { };
+
+template <typename K, typename V, typename Layout = Chaining,
+    typename Hasher = Hash<K> >
+struct DictionaryFor {
+    typedef Dictionary<K, V, Hasher> type;
+};
+
+template <typename K, typename V, typename Hasher>
+struct DictionaryFor<K, V, OpenAddressing, Hasher> {
+    typedef FlatDictionary<K, V, Hasher> type;
+};
+
+#endif
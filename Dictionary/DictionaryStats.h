@@ -0,0 +1,156 @@
+// By Fabio Nardelli
+// Politiche di statistica per la classe Dictionary (parametro template
+// Stats). Una politica riceve da Dictionary una notifica per ogni ricerca
+// (find, belongs) e inserimento, con il numero di chiavi confrontate nella
+// lista di trabocco (probe), per ogni ristrutturazione e per il tempo speso
+// a spostare le liste da un vettore all'altro:
+//   NoStats        non conta nulla: le sue funzioni sono vuote, per cui il
+//                  compilatore elimina le notifiche e il loro calcolo;
+//   CountingStats  accumula i contatori (e misura i tempi con
+//                  std::chrono::steady_clock).
+// Dictionary::stats() restituisce una DictionaryStats, che unisce i
+// contatori della politica (nulli con NoStats) alle grandezze ricavate
+// dalla tabella: fattore di carico e lunghezze delle liste di trabocco.
+// L'operatore << stampa una DictionaryStats una grandezza per riga, nella
+// forma "nome valore", facile da leggere per un programma di monitoraggio.
+
+#ifndef DICTIONARY_STATS_H
+#define DICTIONARY_STATS_H
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// istantanea delle statistiche di un dizionario
+struct DictionaryStats {
+    std::size_t size; // numero di elementi
+    std::size_t capacity; // numero di liste di trabocco
+    double loadFactor; // size / capacity
+    bool rehashing; // true durante una ristrutturazione incrementale
+    std::size_t maxChain; // lunghezza della lista piu' lunga
+    double meanChain; // lunghezza media delle liste non vuote
+    // chainLengths[i] e' il numero di liste di lunghezza i
+    std::vector<std::size_t> chainLengths;
+
+    // contatori della politica Stats (nulli con NoStats)
+    std::uint64_t finds; // chiamate a find (anche findWithHash, findBatch)
+    std::uint64_t findProbes; // chiavi confrontate da find
+    std::uint64_t belongsCalls; // chiamate a belongs
+    std::uint64_t belongsProbes; // chiavi confrontate da belongs
+    std::uint64_t inserts; // inserimenti (anche di chiavi gia' presenti)
+    std::uint64_t insertProbes; // chiavi confrontate dagli inserimenti
+    std::uint64_t resizes; // ristrutturazioni iniziate
+    std::uint64_t rehashNanoseconds; // tempo speso a spostare le liste
+
+    DictionaryStats()
+        : size(0), capacity(0), loadFactor(0), rehashing(false), maxChain(0),
+          meanChain(0), finds(0), findProbes(0), belongsCalls(0),
+          belongsProbes(0), inserts(0), insertProbes(0), resizes(0),
+          rehashNanoseconds(0) { }
+
+    // restituisce il numero medio di chiavi confrontate per operazione
+    static double mean(std::uint64_t probes, std::uint64_t operations)
+    {
+        return operations > 0 ? static_cast<double>(probes) / operations : 0;
+    }
+};
+
+// stampa le statistiche, una grandezza per riga
+inline std::ostream &operator<<(std::ostream &output, const DictionaryStats &s)
+{
+    output << "size " << s.size << "\n"
+           << "capacity " << s.capacity << "\n"
+           << "load_factor " << s.loadFactor << "\n"
+           << "rehashing " << (s.rehashing ? 1 : 0) << "\n"
+           << "max_chain " << s.maxChain << "\n"
+           << "mean_chain " << s.meanChain << "\n";
+    for (std::size_t i = 0; i < s.chainLengths.size(); ++i)
+        output << "chains_of_length_" << i << " " << s.chainLengths[i] << "\n";
+    output << "finds " << s.finds << "\n"
+           << "find_probes_mean " << DictionaryStats::mean(s.findProbes,
+               s.finds) << "\n"
+           << "belongs " << s.belongsCalls << "\n"
+           << "belongs_probes_mean " << DictionaryStats::mean(s.belongsProbes,
+               s.belongsCalls) << "\n"
+           << "inserts " << s.inserts << "\n"
+           << "insert_probes_mean " << DictionaryStats::mean(s.insertProbes,
+               s.inserts) << "\n"
+           << "resizes " << s.resizes << "\n"
+           << "rehash_nanoseconds " << s.rehashNanoseconds << "\n";
+    return output;
+}
+
+// politica che non raccoglie statistiche (default di Dictionary)
+struct NoStats {
+    void countFind(std::size_t) const { }
+    void countBelongs(std::size_t) const { }
+    void countInsert(std::size_t) const { }
+    void countResize() const { }
+    // restituisce l'istante iniziale di una misura di tempo
+    std::uint64_t startTimer() const { return 0; }
+    // aggiunge il tempo trascorso da start al tempo di ristrutturazione
+    void stopTimer(std::uint64_t) const { }
+    // copia i contatori in s
+    void copyTo(DictionaryStats &) const { }
+    void reset() { } // azzera i contatori
+};
+
+// politica che conta ricerche, inserimenti e ristrutturazioni. I contatori
+// sono mutable perche' anche le ricerche, che sono costanti, li aggiornano
+class CountingStats {
+public:
+    CountingStats() { reset(); }
+
+    void countFind(std::size_t probes) const
+    {
+        ++finds;
+        findProbes += probes;
+    }
+    void countBelongs(std::size_t probes) const
+    {
+        ++belongsCalls;
+        belongsProbes += probes;
+    }
+    void countInsert(std::size_t probes) const
+    {
+        ++inserts;
+        insertProbes += probes;
+    }
+    void countResize() const { ++resizes; }
+    std::uint64_t startTimer() const { return now(); }
+    void stopTimer(std::uint64_t start) const
+        { rehashNanoseconds += now() - start; }
+    void copyTo(DictionaryStats &s) const
+    {
+        s.finds = finds;
+        s.findProbes = findProbes;
+        s.belongsCalls = belongsCalls;
+        s.belongsProbes = belongsProbes;
+        s.inserts = inserts;
+        s.insertProbes = insertProbes;
+        s.resizes = resizes;
+        s.rehashNanoseconds = rehashNanoseconds;
+    }
+    void reset()
+    {
+        finds = findProbes = belongsCalls = belongsProbes = 0;
+        inserts = insertProbes = resizes = rehashNanoseconds = 0;
+    }
+
+private:
+    mutable std::uint64_t finds, findProbes;
+    mutable std::uint64_t belongsCalls, belongsProbes;
+    mutable std::uint64_t inserts, insertProbes;
+    mutable std::uint64_t resizes, rehashNanoseconds;
+
+    // restituisce l'istante attuale in nanosecondi
+    static std::uint64_t now()
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+#endif
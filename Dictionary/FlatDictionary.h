@@ -0,0 +1,603 @@
+// By Fabio Nardelli
+// Dizionario implementato mediante hash table a indirizzamento aperto in
+// stile "Swiss table": le coppie chiave-valore sono memorizzate direttamente
+// in un vettore di celle (senza nodi allocati uno a uno), affiancato da un
+// vettore di byte di controllo, uno per cella, che vale
+//   empty   (-128) se la cella e' vuota,
+//   deleted (-2)   se la cella conteneva una coppia poi rimossa,
+//   0..127         se la cella e' occupata: sono i 7 bit meno significativi
+//                  del valore hash della chiave (h2).
+// Le celle sono divise in gruppi di 16: i restanti bit dell'hash (h1)
+// indicano il primo gruppo da esaminare, poi si prosegue con una sequenza
+// di sondaggio quadratica sui gruppi. In ciascun gruppo i 16 byte di
+// controllo vengono confrontati con h2 in una sola volta con le istruzioni
+// SSE2 (con un ciclo se non sono disponibili), per cui la chiave viene
+// letta e confrontata solo nelle celle il cui h2 coincide (in media meno
+// di una cella per ricerca). Le celle del gruppo vengono caricate in
+// anticipo insieme ai byte di controllo, per cui una ricerca attende in
+// pratica un solo accesso alla memoria. La ricerca si ferma al primo gruppo
+// che contiene una cella vuota.
+// La tabella viene ristrutturata quando le celle occupate o cancellate
+// superano i 7/8 della capacita' (raddoppiandola se le coppie presenti
+// superano meta' di quella soglia, altrimenti eliminando solo le celle
+// cancellate) e dimezzata quando le coppie scendono sotto 1/8 della
+// capacita'. La capacita' e' sempre una potenza di 2, di almeno 16 celle.
+// L'interfaccia pubblica e' la stessa di Dictionary; i puntatori
+// restituiti da find restano validi fino alla successiva ristrutturazione.
+
+#ifndef FLAT_DICTIONARY_H
+#define FLAT_DICTIONARY_H
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_DICTIONARY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// gruppo di 16 byte di controllo. Le funzioni di confronto restituiscono
+// una maschera con il bit i acceso se il byte i-esimo soddisfa la condizione
+class ControlGroup {
+public:
+    static const int size = 16;
+    static const signed char empty = -128;
+    static const signed char deleted = -2;
+
+#ifdef FLAT_DICTIONARY_SSE2
+    explicit ControlGroup(const signed char *p)
+        : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) { }
+
+    // byte uguali a h2
+    unsigned match(signed char h2) const
+    {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+    }
+    // celle vuote o cancellate: sono i byte con il bit di segno acceso
+    unsigned matchFree() const
+        { return static_cast<unsigned>(_mm_movemask_epi8(bytes)); }
+private:
+    __m128i bytes;
+#else
+    explicit ControlGroup(const signed char *p) : bytes(p) { }
+
+    // byte uguali a h2
+    unsigned match(signed char h2) const
+    {
+        unsigned mask = 0;
+        for (int i = 0; i < size; ++i)
+            if (bytes[i] == h2)
+                mask |= 1u << i;
+        return mask;
+    }
+    // celle vuote o cancellate
+    unsigned matchFree() const
+    {
+        unsigned mask = 0;
+        for (int i = 0; i < size; ++i)
+            if (bytes[i] < 0)
+                mask |= 1u << i;
+        return mask;
+    }
+private:
+    const signed char *bytes;
+#endif
+public:
+    // celle vuote
+    unsigned matchEmpty() const { return match(empty); }
+
+    // restituisce l'indice del bit acceso meno significativo (mask != 0)
+    static int lowestBit(unsigned mask)
+    {
+#ifdef __GNUC__
+        return __builtin_ctz(mask);
+#else
+        int i = 0;
+        while ((mask & 1u) == 0) {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+};
+
+template <typename K, typename V, typename Hasher = Hash<K> >
+class FlatDictionary;
+
+template <typename K, typename V, typename Hasher>
+std::ostream &operator<<(std::ostream &, const FlatDictionary<K, V, Hasher> &);
+
+template <typename K, typename V, typename Hasher>
+class FlatDictionary {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const FlatDictionary<K, V, Hasher> &);
+public:
+    // costruttore di default: c e' il numero iniziale di celle
+    FlatDictionary(std::size_t c = defaultCapacity,
+        const Hasher &h = Hasher());
+    // costruttore per copia
+    FlatDictionary(const FlatDictionary<K, V, Hasher> &d);
+    // distruttore
+    ~FlatDictionary();
+    // operatore =
+    FlatDictionary<K, V, Hasher> &operator=(
+        const FlatDictionary<K, V, Hasher> &);
+
+    // restituisce true se il dizionario e' vuoto, false altrimenti
+    bool isEmpty() const { return size == 0; }
+    // restituisce true se la chiave indicata e' presente nel dizionario,
+    // false altrimenti
+    bool belongs(const K &key) const { return contains(key, hash(key)); }
+    // inserisce la coppia chiave-valore indicata nel dizionario. La
+    // seconda versione sposta chiave e valore invece di copiarli
+    void insert(const K &key, const V &value)
+        { emplace(hash(key), key, value); }
+    void insert(K &&key, V &&value)
+        { emplace(hash(key), std::move(key), std::move(value)); }
+    // rimuove la coppia chiave-valore indicata dal dizionario
+    void remove(const K &);
+    // recupera il valore corrispondente alla chiave indicata
+    const V *find(const K &key) const { return get(key, hash(key)); }
+
+    // ricerche eterogenee e valore hash precalcolato, come in Dictionary
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    bool belongs(const Q &key) const
+        { return contains(key, mix(hasher(key))); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    const V *find(const Q &key) const { return get(key, mix(hasher(key))); }
+    std::size_t hashOf(const K &key) const { return hasher(key); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    std::size_t hashOf(const Q &key) const { return hasher(key); }
+    const V *findWithHash(const K &key, std::size_t h) const
+        { return get(key, mix(h)); }
+    template <typename Q, typename H = Hasher,
+        typename = typename H::is_transparent>
+    const V *findWithHash(const Q &key, std::size_t h) const
+        { return get(key, mix(h)); }
+    void insertWithHash(const K &key, const V &value, std::size_t h)
+        { emplace(mix(h), key, value); }
+    void insertWithHash(K &&key, V &&value, std::size_t h)
+        { emplace(mix(h), std::move(key), std::move(value)); }
+    // restituisce il numero di elementi contenuti nel dizionario
+    std::size_t getSize() const { return size; }
+    // restituisce il numero di celle della tabella
+    std::size_t getCapacity() const { return capacity; }
+    // stampa il dizionario
+    void print() const;
+    // stampa i valori contenuti nel dizionario
+    void values() const;
+    // stampa le chiavi contenute nel dizionario
+    void keys() const;
+    // restituisce true se almeno una chiave e' mappata al valore indicato
+    bool containsValue(const V &) const;
+    // chiama f(chiave, valore) su ciascuna coppia del dizionario, passando
+    // riferimenti costanti, per cui chiavi e valori non vengono copiati
+    template <typename F>
+    void forEach(F f) const;
+private:
+
+    // struct usata per rappresentare una coppia chiave-valore
+    struct Pair {
+        K key; // chiave
+        V value; // valore
+
+        template <typename KK, typename VV>
+        Pair(KK &&k, VV &&v)
+            : key(std::forward<KK>(k)), value(std::forward<VV>(v)) { }
+    };
+
+    signed char *control; // byte di controllo, uno per cella
+    Pair *slots; // celle (memoria grezza: solo quelle occupate sono costruite)
+    std::size_t size; // numero di coppie contenute nella tabella
+    std::size_t capacity; // numero di celle, potenza di 2 multipla di 16
+    std::size_t tombstones; // numero di celle cancellate
+
+    static const std::size_t defaultCapacity = 16;
+
+    // restituisce la piu' piccola potenza di 2 >= c (almeno 16)
+    static std::size_t roundCapacity(std::size_t c);
+    // alloca le celle e i byte di controllo (tutte le celle sono vuote)
+    void allocate(std::size_t c);
+    // distrugge le coppie e libera la memoria
+    void destroy();
+    // sposta le coppie in una nuova tabella di newCapacity celle
+    void rehash(std::size_t newCapacity);
+    // restituisce l'indice della cella che contiene la chiave (di tipo K o
+    // Q, vedi Hash.h) con valore hash rimescolato h, oppure capacity se la
+    // chiave non e' presente
+    template <typename Q>
+    std::size_t lookup(const Q &, std::size_t h) const;
+    // implementazione di belongs e find (h e' il valore hash rimescolato)
+    template <typename Q>
+    bool contains(const Q &, std::size_t h) const;
+    template <typename Q>
+    const V *get(const Q &key, std::size_t h) const
+    {
+        std::size_t i = lookup(key, h);
+        // se la trova restituisce un puntatore costante al valore,
+        // altrimenti restituisce NIL
+        return i != capacity ? &slots[i].value : 0;
+    }
+    // restituisce l'indice della prima cella vuota o cancellata
+    // nella sequenza di sondaggio del valore hash h
+    std::size_t findFree(std::size_t h) const;
+    // inserisce una coppia con valore hash rimescolato h inoltrando
+    // chiave e valore al costruttore di Pair
+    template <typename KK, typename VV>
+    void emplace(std::size_t h, KK &&, VV &&);
+    // carica in anticipo le prime due righe di cache delle celle di un
+    // gruppo, in modo che il loro caricamento proceda in parallelo a
+    // quello dei byte di controllo invece di seguirlo
+    static void prefetch(const Pair *group)
+    {
+#ifdef __GNUC__
+        __builtin_prefetch(group);
+        if (ControlGroup::size * sizeof(Pair) > 64)
+            __builtin_prefetch(reinterpret_cast<const char *>(group) + 64);
+#else
+        (void) group;
+#endif
+    }
+
+    // h1 (bit alti) sceglie il primo gruppo, h2 (7 bit bassi) va nel
+    // byte di controllo
+    static std::size_t h1(std::size_t h) { return h >> 7; }
+    static signed char h2(std::size_t h)
+        { return static_cast<signed char>(h & 0x7F); }
+    Hasher hasher; // funtore hash (di default Hash<K>, vedi Hash.h)
+
+    // rimescola il valore hash h restituito da Hasher. Un funtore Hasher
+    // diverso da Hash<K> puo' restituire valori poco distribuiti (ad es.
+    // l'identita' per gli interi), mentre h1 e h2 richiedono che tutti i bit
+    // dipendano dalla chiave: il valore viene percio' moltiplicato per una
+    // costante dispari, combinando poi con uno xor la meta' alta del
+    // risultato con la meta' bassa
+    static std::size_t mix(std::size_t h)
+    {
+        unsigned long long x = static_cast<unsigned long long>(h)
+            * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(x ^ (x >> 32));
+    }
+    // valore hash rimescolato della chiave
+    std::size_t hash(const K &k) const { return mix(hasher(k)); }
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename K, typename V, typename Hasher>
+std::ostream &operator<<(std::ostream &output,
+    const FlatDictionary<K, V, Hasher> &d)
+{
+    d.print();
+    return output;
+}
+
+// restituisce la piu' piccola potenza di 2 >= c, e almeno un gruppo
+template <typename K, typename V, typename Hasher>
+std::size_t FlatDictionary<K, V, Hasher>::roundCapacity(std::size_t c)
+{
+    std::size_t rounded = ControlGroup::size;
+    while (rounded < c)
+        rounded *= 2;
+    return rounded;
+}
+
+// alloca c celle, tutte vuote. Se l'allocazione fallisce i membri
+// restano invariati
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::allocate(std::size_t c)
+{
+    Pair *newSlots = static_cast<Pair *>(::operator new(c * sizeof(Pair)));
+    try {
+        control = new signed char[c];
+    } catch (...) {
+        ::operator delete(newSlots);
+        throw;
+    }
+    slots = newSlots;
+    for (std::size_t i = 0; i < c; ++i)
+        control[i] = ControlGroup::empty;
+    capacity = c;
+    size = 0;
+    tombstones = 0;
+}
+
+// distrugge le coppie contenute e libera la memoria
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::destroy()
+{
+    if (!std::is_trivially_destructible<Pair>::value)
+        for (std::size_t i = 0; i < capacity && size > 0; ++i)
+            if (control[i] >= 0) {
+                slots[i].~Pair();
+                --size;
+            }
+    delete [] control;
+    ::operator delete(slots);
+}
+
+// costruttore di default
+template <typename K, typename V, typename Hasher>
+FlatDictionary<K, V, Hasher>::FlatDictionary(std::size_t c, const Hasher &h)
+    : hasher(h)
+{
+    allocate(roundCapacity(c));
+}
+
+// costruttore per copia: le coppie vengono copiate nelle stesse celle
+template <typename K, typename V, typename Hasher>
+FlatDictionary<K, V, Hasher>::FlatDictionary(
+    const FlatDictionary<K, V, Hasher> &d)
+    : hasher(d.hasher)
+{
+    allocate(d.capacity);
+    try {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            if (d.control[i] >= 0) {
+                new (slots + i) Pair(d.slots[i]);
+                ++size;
+            }
+            control[i] = d.control[i];
+        }
+    } catch (...) {
+        destroy();
+        throw;
+    }
+    tombstones = d.tombstones;
+}
+
+// distruttore
+template <typename K, typename V, typename Hasher>
+FlatDictionary<K, V, Hasher>::~FlatDictionary()
+{
+    destroy();
+}
+
+// overload operatore di assegnamento =
+template <typename K, typename V, typename Hasher>
+FlatDictionary<K, V, Hasher> &FlatDictionary<K, V, Hasher>::operator=(
+    const FlatDictionary<K, V, Hasher> &d)
+{
+    if (&d != this) { // evita l'autoassegnazione
+        // costruisce prima la copia, in modo che un'eccezione
+        // lasci invariato questo dizionario
+        FlatDictionary<K, V, Hasher> temp(d);
+        std::swap(control, temp.control);
+        std::swap(slots, temp.slots);
+        std::swap(size, temp.size);
+        std::swap(capacity, temp.capacity);
+        std::swap(tombstones, temp.tombstones);
+        std::swap(hasher, temp.hasher);
+    }
+
+    return *this; // consente a = b = c
+}
+
+// sposta tutte le coppie in una nuova tabella di newCapacity celle. Nella
+// nuova tabella non ci sono celle cancellate, per cui basta inserire ogni
+// coppia nella prima cella libera della sua sequenza di sondaggio
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::rehash(std::size_t newCapacity)
+{
+    signed char *oldControl = control;
+    Pair *oldSlots = slots;
+    std::size_t oldCapacity = capacity;
+    std::size_t oldSize = size;
+
+    allocate(newCapacity);
+    for (std::size_t i = 0; i < oldCapacity; ++i) {
+        if (oldControl[i] >= 0) {
+            std::size_t h = hash(oldSlots[i].key);
+            std::size_t j = findFree(h);
+            new (slots + j) Pair(std::move(oldSlots[i]));
+            control[j] = h2(h);
+            oldSlots[i].~Pair();
+        }
+    }
+    size = oldSize;
+
+    delete [] oldControl;
+    ::operator delete(oldSlots);
+}
+
+// restituisce l'indice della cella che contiene la chiave, o capacity
+template <typename K, typename V, typename Hasher>
+template <typename Q>
+std::size_t FlatDictionary<K, V, Hasher>::lookup(const Q &key,
+    std::size_t h) const
+{
+    const std::size_t groupMask = capacity / ControlGroup::size - 1;
+    const signed char tag = h2(h);
+    std::size_t group = h1(h) & groupMask;
+
+    // sondaggio quadratico sui gruppi: poiche' il numero di gruppi e' una
+    // potenza di 2, la sequenza li visita tutti
+    for (std::size_t step = 1; ; ++step) {
+        const std::size_t base = group * ControlGroup::size;
+        prefetch(slots + base);
+        ControlGroup g(control + base);
+        for (unsigned m = g.match(tag); m != 0; m &= m - 1) {
+            std::size_t i = base + ControlGroup::lowestBit(m);
+            if (slots[i].key == key)
+                return i;
+        }
+        // una cella vuota nel gruppo indica che la chiave non e' stata
+        // inserita oltre questo gruppo
+        if (g.matchEmpty() != 0)
+            return capacity;
+        group = (group + step) & groupMask;
+    }
+}
+
+// restituisce la prima cella vuota o cancellata per il valore hash h.
+// Ne esiste sempre almeno una, perche' la tabella non e' mai piena
+template <typename K, typename V, typename Hasher>
+std::size_t FlatDictionary<K, V, Hasher>::findFree(std::size_t h) const
+{
+    const std::size_t groupMask = capacity / ControlGroup::size - 1;
+    std::size_t group = h1(h) & groupMask;
+
+    for (std::size_t step = 1; ; ++step) {
+        const std::size_t base = group * ControlGroup::size;
+        unsigned m = ControlGroup(control + base).matchFree();
+        if (m != 0)
+            return base + ControlGroup::lowestBit(m);
+        group = (group + step) & groupMask;
+    }
+}
+
+// verifica se la chiave indicata e' presente nel dizionario
+template <typename K, typename V, typename Hasher>
+template <typename Q>
+bool FlatDictionary<K, V, Hasher>::contains(const Q &key, std::size_t h) const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Cannot find key: Dictionary is empty!\n";
+        return false;
+    }
+
+    return lookup(key, h) != capacity;
+}
+
+// inserisce la coppia chiave-valore indicata nella tabella
+// se e' gia' presente la stessa chiave, sovrascrive il valore associato
+template <typename K, typename V, typename Hasher>
+template <typename KK, typename VV>
+void FlatDictionary<K, V, Hasher>::emplace(std::size_t h, KK &&key,
+    VV &&val)
+{
+    std::size_t i = lookup(key, h);
+    if (i != capacity) { // chiave gia' presente
+        slots[i].value = std::forward<VV>(val);
+        return;
+    }
+
+    // se le celle occupate o cancellate supererebbero i 7/8 della
+    // capacita', ristruttura la tabella: la raddoppia se e' piena di coppie,
+    // altrimenti si limita a eliminare le celle cancellate
+    if ((size + tombstones + 1) * 8 > capacity * 7)
+        rehash((size + 1) * 16 > capacity * 7 ? capacity * 2 : capacity);
+
+    i = findFree(h);
+    new (slots + i) Pair(std::forward<KK>(key), std::forward<VV>(val));
+    if (control[i] == ControlGroup::deleted)
+        --tombstones;
+    control[i] = h2(h);
+    ++size;
+}
+
+// rimuove la coppia chiave-valore indicata dalla tabella, se presente
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::remove(const K &key)
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Cannot remove item: Dictionary is empty!\n";
+        return;
+    }
+
+    std::size_t i = lookup(key, hash(key));
+    if (i == capacity) { // se l'elemento non e' presente
+        std::cerr << "Cannot remove item: key not found!\n";
+        return;
+    }
+
+    slots[i].~Pair();
+    --size;
+    // se il gruppo contiene una cella vuota nessuna ricerca lo ha mai
+    // oltrepassato, per cui la cella puo' tornare vuota; altrimenti deve
+    // restare segnata come cancellata, per non interrompere le ricerche
+    // delle chiavi inserite nei gruppi successivi
+    const std::size_t base = i & ~static_cast<std::size_t>(ControlGroup::size - 1);
+    if (ControlGroup(control + base).matchEmpty() != 0) {
+        control[i] = ControlGroup::empty;
+    } else {
+        control[i] = ControlGroup::deleted;
+        ++tombstones;
+    }
+
+    // se le coppie scendono sotto 1/8 della capacita', la dimezza
+    if (capacity > defaultCapacity && size * 8 < capacity)
+        rehash(capacity / 2);
+}
+
+// stampa il dizionario
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::print() const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+        return;
+    }
+
+    std::cout << "KEYS : VALUES\n";
+    forEach([](const K &key, const V &value) {
+        std::cout << key << " : " << value << "\n";
+    });
+}
+
+// stampa i valori contenuti nel dizionario
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::values() const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+        return;
+    }
+
+    forEach([](const K &, const V &value) { std::cout << value << "\n"; });
+}
+
+// stampa le chiavi contenute nel dizionario
+template <typename K, typename V, typename Hasher>
+void FlatDictionary<K, V, Hasher>::keys() const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+        return;
+    }
+
+    forEach([](const K &key, const V &) { std::cout << key << "\n"; });
+}
+
+// restituisce true se almeno una chiave e' mappata al valore indicato
+template <typename K, typename V, typename Hasher>
+bool FlatDictionary<K, V, Hasher>::containsValue(const V &val) const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+        return false;
+    }
+
+    for (std::size_t i = 0; i < capacity; ++i)
+        if (control[i] >= 0 && slots[i].value == val)
+            return true;
+
+    return false; // se il valore non e' contenuto
+}
+
+// chiama f su ciascuna coppia chiave-valore del dizionario
+template <typename K, typename V, typename Hasher>
+template <typename F>
+void FlatDictionary<K, V, Hasher>::forEach(F f) const
+{
+    for (std::size_t i = 0; i < capacity; ++i)
+        if (control[i] >= 0)
+            f(static_cast<const K &>(slots[i].key),
+                static_cast<const V &>(slots[i].value));
+}
+
+#endif
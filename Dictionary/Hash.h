@@ -1,54 +1,206 @@
 // By Fabio Nardelli
-// Picola raccolta di funzioni hash per la classe Dictionary (ovviamente possono
-// essere usate da qualunque classe).
+// Piccola raccolta di funzioni hash per la classe Dictionary (ovviamente
+// possono essere usate da qualunque classe).
+// Hash<K> e' il funtore usato di default dai dizionari (parametro template
+// Hasher) e getHash<K>(chiave) ne e' la versione a funzione:
+// - le stringhe (std::string, char *) usano hashBytes, che legge la chiave
+//   8 byte alla volta e ne combina le parole con moltiplicazioni a 128 bit
+//   (schema di wyhash);
+// - gli altri tipi usano std::hash, il cui risultato viene rimescolato da
+//   mixInteger: per gli interi std::hash e' di solito l'identita', per cui
+//   chiavi con gli stessi bit bassi (ad es. multipli di una potenza di 2)
+//   finirebbero nelle stesse liste di trabocco.
+// Per usare un'altra funzione hash basta passare al dizionario un funtore
+// con operator()(const K &) const che restituisca std::size_t.
+// Un funtore che dichiara il tipo is_transparent (come Hash<std::string>)
+// accetta anche tipi diversi da K, purche' confrontabili con K tramite ==
+// e con lo stesso valore hash della chiave equivalente: i dizionari lo
+// usano per le ricerche eterogenee (ad es. find("Pippo") o, in C++17,
+// find(std::string_view) senza costruire una std::string temporanea).
 
 #ifndef HASH_H
 #define HASH_H
 
-#include <cmath>
 #include <string>
 #include <cstring>
+#include <cstdint>
 #include <functional>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
-template <typename K>
-std::size_t getHash(const K &key);
+// costanti usate da hashBytes (le stesse di wyhash)
+const std::uint64_t hashSecret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
 
-// Per i tipi di dato diversi da quelli sotto, usa std::hash
-template <typename K>
-std::size_t getHash(const K &key)
+// calcola il prodotto a 128 bit di a e b, restituendo in a la meta' bassa
+// e in b la meta' alta
+inline void hashMultiply(std::uint64_t &a, std::uint64_t &b)
 {
-    std::hash<K> hashFunction;
-    return hashFunction(key);
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 r = static_cast<uint128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    // prodotto a 128 bit calcolato con quattro prodotti a 64 bit
+    // delle meta' da 32 bit
+    std::uint64_t ha = a >> 32, hb = b >> 32;
+    std::uint64_t la = a & 0xFFFFFFFFULL, lb = b & 0xFFFFFFFFULL;
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t carry = t < rl;
+    std::uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    a = lo;
+#endif
 }
 
-// usa l'algoritmo proposto da Daniel J. Bernstein(noto anche come DJBX33A). 
-template <typename K>
-std::size_t getHash(const std::string &key) 
+// mescola a e b: xor delle due meta' del loro prodotto a 128 bit
+inline std::uint64_t hashMix(std::uint64_t a, std::uint64_t b)
+{
+    hashMultiply(a, b);
+    return a ^ b;
+}
+
+// legge 8, 4 o da 1 a 3 byte (senza vincoli di allineamento)
+inline std::uint64_t hashRead8(const unsigned char *p)
 {
-    std::size_t hash = 5381;
-    std::size_t l = key.length();
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
 
-    // hash << 5 == hash * 2^5, le operazioni bit a bit dovrebbero
-    // garantire prestazioni migliori
-    for (std::size_t i = 0; i < l; ++i)
-        hash = ((hash << 5) + hash) + key[i];
+inline std::uint64_t hashRead4(const unsigned char *p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
 
-    return hash;
+inline std::uint64_t hashRead3(const unsigned char *p, std::size_t k)
+{
+    return (static_cast<std::uint64_t>(p[0]) << 16)
+        | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
 }
 
-// come sopra ma per stringhe C-style(char *)
-template <typename K>
-std::size_t getHash(const char *key) 
+// valore hash di len byte a partire da key. Le chiavi fino a 16 byte
+// vengono lette con al massimo quattro accessi, quelle piu' lunghe
+// 16 byte alla volta (48 per le chiavi oltre i 48 byte, su tre catene
+// indipendenti di moltiplicazioni)
+inline std::size_t hashBytes(const void *key, std::size_t len,
+    std::uint64_t seed = 0)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(key);
+    std::uint64_t a, b;
+
+    seed ^= hashMix(seed ^ hashSecret[0], hashSecret[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            // due letture da 4 byte all'inizio e due alla fine
+            // (sovrapposte se len < 16)
+            std::size_t middle = (len >> 3) << 2;
+            a = (hashRead4(p) << 32) | hashRead4(p + middle);
+            b = (hashRead4(p + len - 4) << 32)
+                | hashRead4(p + len - 4 - middle);
+        } else if (len > 0) {
+            a = hashRead3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+        if (i > 48) {
+            std::uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = hashMix(hashRead8(p) ^ hashSecret[1],
+                    hashRead8(p + 8) ^ seed);
+                seed1 = hashMix(hashRead8(p + 16) ^ hashSecret[2],
+                    hashRead8(p + 24) ^ seed1);
+                seed2 = hashMix(hashRead8(p + 32) ^ hashSecret[3],
+                    hashRead8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (i > 16) {
+            seed = hashMix(hashRead8(p) ^ hashSecret[1],
+                hashRead8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // gli ultimi 16 byte (in parte gia' letti se i < 16)
+        a = hashRead8(p + i - 16);
+        b = hashRead8(p + i - 8);
+    }
+
+    a ^= hashSecret[1];
+    b ^= seed;
+    hashMultiply(a, b);
+    return static_cast<std::size_t>(
+        hashMix(a ^ hashSecret[0] ^ len, b ^ hashSecret[1]));
+}
+
+// rimescola un intero in modo che ogni bit del risultato dipenda da tutti
+// i bit di x (finalizzatore di MurmurHash3: due moltiplicazioni a 64 bit
+// alternate a xor con la meta' alta)
+inline std::size_t mixInteger(std::uint64_t x)
 {
-    std::size_t hash = 5381;
-    std::size_t l = strlen(key);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+}
+
+// funtore hash di default: std::hash rimescolato con mixInteger
+template <typename K>
+struct Hash {
+    std::size_t operator()(const K &key) const
+        { return mixInteger(std::hash<K>()(key)); }
+};
 
-    // hash << 5 == hash * 2^5, le operazioni bit a bit dovrebbero
-    // garantire prestazioni migliori
-    for (std::size_t i = 0; i < l; ++i)
-        hash = ((hash << 5) + hash) + key[i];
+// stringhe: hashBytes sui caratteri. Le stringhe C-style (e le
+// std::string_view) hanno lo stesso valore hash della std::string con
+// gli stessi caratteri, per cui possono essere usate nelle ricerche
+template <>
+struct Hash<std::string> {
+    typedef void is_transparent;
 
-    return hash;
+    std::size_t operator()(const std::string &key) const
+        { return hashBytes(key.data(), key.size()); }
+    std::size_t operator()(const char *key) const
+        { return hashBytes(key, std::strlen(key)); }
+#if __cplusplus >= 201703L
+    std::size_t operator()(std::string_view key) const
+        { return hashBytes(key.data(), key.size()); }
+#endif
+};
+
+// come sopra ma per stringhe C-style(char *)
+template <>
+struct Hash<const char *> {
+    std::size_t operator()(const char *key) const
+        { return hashBytes(key, std::strlen(key)); }
+};
+
+template <>
+struct Hash<char *> {
+    std::size_t operator()(const char *key) const
+        { return hashBytes(key, std::strlen(key)); }
+};
+
+// restituisce il valore hash della chiave calcolato da Hash<K>
+template <typename K>
+std::size_t getHash(const K &key)
+{
+    return Hash<K>()(key);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,300 @@
+// By Fabio Nardelli
+// Dizionario di sola lettura servito direttamente da un file snapshot
+// scritto da Dictionary::save (vedi Snapshot.h per il formato). Il file
+// viene mappato in memoria con mmap, per cui l'apertura non legge ne'
+// costruisce nulla: le pagine vengono caricate dalla prima ricerca che le
+// tocca e i processi che mappano lo stesso file ne condividono le pagine
+// nella page cache del sistema operativo.
+// find copia il valore trovato (come ConcurrentDictionary::find), perche'
+// nel file le std::string non sono memorizzate come oggetti. Ogni accesso
+// a un record verifica che posizioni e lunghezze restino all'interno del
+// file, per cui un file danneggiato non provoca letture fuori dalla
+// mappatura. Il costruttore lancia std::runtime_error se il file non puo'
+// essere aperto o e' stato scritto per tipi o piattaforme diversi.
+// Sulle piattaforme senza mmap il file viene letto per intero in memoria:
+// le ricerche funzionano allo stesso modo, ma l'apertura richiede la
+// lettura del file e la memoria non e' condivisa fra processi.
+
+#ifndef MAPPED_DICTIONARY_H
+#define MAPPED_DICTIONARY_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include "Snapshot.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_DICTIONARY_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+template <typename K, typename V>
+class MappedDictionary;
+
+template <typename K, typename V>
+std::ostream &operator<<(std::ostream &, const MappedDictionary<K, V> &);
+
+template <typename K, typename V>
+class MappedDictionary {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const MappedDictionary<K, V> &);
+public:
+    // costruttore: mappa in memoria il file snapshot indicato
+    explicit MappedDictionary(const std::string &path);
+    // costruttore per spostamento: d non fa piu' riferimento al file
+    MappedDictionary(MappedDictionary<K, V> &&d);
+    ~MappedDictionary() { release(); } // distruttore
+    // la mappatura appartiene a un solo oggetto: non puo' essere copiata
+    MappedDictionary(const MappedDictionary<K, V> &) = delete;
+    MappedDictionary<K, V> &operator=(const MappedDictionary<K, V> &) = delete;
+
+    // restituisce true se il dizionario e' vuoto, false altrimenti
+    bool isEmpty() const { return count == 0; }
+    // restituisce true se la chiave indicata e' presente nel dizionario
+    bool belongs(const K &key) const { return record(key) != 0; }
+    // copia in value il valore corrispondente alla chiave indicata.
+    // Restituisce false, senza modificare value, se la chiave non e' presente
+    bool find(const K &key, V &value) const;
+    // restituisce il numero di elementi contenuti nel dizionario
+    std::size_t getSize() const { return static_cast<std::size_t>(count); }
+    // stampa il dizionario
+    void print() const;
+    // chiama f(chiave, valore) su ciascuna coppia del dizionario, passando
+    // copie di chiave e valore lette dal file
+    template <typename F>
+    void forEach(F f) const;
+
+private:
+    typedef SnapshotField<K> KeyField;
+    typedef SnapshotField<V> ValueField;
+    static const std::size_t recordSize = 8 + KeyField::size
+        + ValueField::size;
+
+    const char *data; // contenuto del file (mappato o letto)
+    std::size_t length; // dimensione del file
+    bool mapped; // true se data e' una mappatura, false se e' stato letto
+    const std::uint64_t *start; // inizi delle liste
+    const char *records; // primo record
+    const char *blob; // area stringhe
+    std::uint64_t count; // numero di record
+    std::uint64_t blobSize; // dimensione dell'area stringhe
+    unsigned bits; // bit dell'indice di una lista
+
+    // verifica l'intestazione e le dimensioni del file e ne ricava le
+    // posizioni delle sezioni. Restituisce false se il file non e' valido
+    bool parse();
+    // restituisce il record della chiave indicata, o 0 se non e' presente
+    const char *record(const K &) const;
+    // rilascia la mappatura (o la memoria in cui e' stato letto il file)
+    void release();
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// restituisce il dizionario mappato dal file snapshot indicato
+template <typename K, typename V>
+MappedDictionary<K, V> openMapped(const std::string &path)
+{
+    return MappedDictionary<K, V>(path);
+}
+
+// overload dell'operatore di inserimento <<
+template <typename K, typename V>
+std::ostream &operator<<(std::ostream &output, const MappedDictionary<K, V> &d)
+{
+    d.print();
+    return output;
+}
+
+// costruttore: mappa il file (o lo legge, se mmap non e' disponibile) e ne
+// verifica l'intestazione
+template <typename K, typename V>
+MappedDictionary<K, V>::MappedDictionary(const std::string &path)
+    : data(0), length(0), mapped(false)
+{
+#ifdef MAPPED_DICTIONARY_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open snapshot: file not found!");
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot open snapshot: invalid file!");
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    void *address = ::mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // la mappatura resta valida anche dopo la chiusura
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Cannot open snapshot: mmap failed!");
+    data = static_cast<const char *>(address);
+    mapped = true;
+#else
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!in)
+        throw std::runtime_error("Cannot open snapshot: file not found!");
+    length = static_cast<std::size_t>(in.tellg());
+    char *buffer = static_cast<char *>(::operator new(length));
+    in.seekg(0);
+    if (!in.read(buffer, static_cast<std::streamsize>(length))) {
+        ::operator delete(buffer);
+        throw std::runtime_error("Cannot open snapshot: read error!");
+    }
+    data = buffer;
+#endif
+
+    if (!parse()) {
+        release();
+        throw std::runtime_error("Cannot open snapshot: incompatible or "
+            "damaged file!");
+    }
+}
+
+// costruttore per spostamento
+template <typename K, typename V>
+MappedDictionary<K, V>::MappedDictionary(MappedDictionary<K, V> &&d)
+    : data(d.data), length(d.length), mapped(d.mapped), start(d.start),
+      records(d.records), blob(d.blob), count(d.count),
+      blobSize(d.blobSize), bits(d.bits)
+{
+    d.data = 0;
+    d.length = 0;
+    d.count = 0;
+}
+
+// verifica che il file sia uno snapshot per chiavi di tipo K e valori di
+// tipo V scritto da una piattaforma compatibile, e che le sue sezioni ne
+// occupino esattamente la dimensione
+template <typename K, typename V>
+bool MappedDictionary<K, V>::parse()
+{
+    SnapshotHeader header;
+    if (length < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, snapshotMagic, sizeof(header.magic)) != 0
+            || header.version != snapshotVersion
+            || header.byteOrder != snapshotByteOrder
+            || header.keyKind != KeyField::kind
+            || header.valueKind != ValueField::kind
+            || header.keySize != KeyField::objectSize
+            || header.valueSize != ValueField::objectSize)
+        return false;
+
+    // il numero di liste e' una potenza di 2 compresa fra 2 e 2^63
+    if (header.buckets < 2 || (header.buckets & (header.buckets - 1)) != 0)
+        return false;
+    for (bits = 0; (std::uint64_t(1) << bits) < header.buckets; ++bits)
+        ;
+
+    // le sezioni devono occupare esattamente il file (i confronti evitano
+    // gli overflow con dimensioni arbitrarie)
+    std::uint64_t rest = length - sizeof(header);
+    if (header.buckets >= rest / 8)
+        return false;
+    rest -= (header.buckets + 1) * 8;
+    if (header.count > rest / recordSize)
+        return false;
+    rest -= header.count * recordSize;
+    if (header.blobSize != rest)
+        return false;
+
+    start = reinterpret_cast<const std::uint64_t *>(data + sizeof(header));
+    records = data + sizeof(header) + (header.buckets + 1) * 8;
+    blob = records + header.count * recordSize;
+    count = header.count;
+    blobSize = header.blobSize;
+    return true;
+}
+
+// rilascia la mappatura o la memoria in cui e' stato letto il file
+template <typename K, typename V>
+void MappedDictionary<K, V>::release()
+{
+    if (data == 0)
+        return;
+#ifdef MAPPED_DICTIONARY_MMAP
+    if (mapped)
+        ::munmap(const_cast<char *>(data), length);
+#endif
+    if (!mapped)
+        ::operator delete(const_cast<char *>(data));
+    data = 0;
+}
+
+// cerca il record della chiave: scandisce la sua lista confrontando prima
+// i valori hash e poi le chiavi
+template <typename K, typename V>
+const char *MappedDictionary<K, V>::record(const K &key) const
+{
+    if (count == 0)
+        return 0;
+
+    std::uint64_t h = KeyField::hash(key);
+    std::size_t i = snapshotBucket(h, bits);
+    std::uint64_t first = start[i], last = start[i + 1];
+    if (first > last || last > count) // file danneggiato
+        return 0;
+
+    for (std::uint64_t r = first; r < last; ++r) {
+        const char *current = records + r * recordSize;
+        std::uint64_t currentHash;
+        std::memcpy(&currentHash, current, 8);
+        if (currentHash == h
+                && KeyField::equals(current + 8, key, blob, blobSize))
+            return current;
+    }
+
+    return 0; // se la chiave non e' presente
+}
+
+// copia in value il valore della chiave indicata, se presente
+template <typename K, typename V>
+bool MappedDictionary<K, V>::find(const K &key, V &value) const
+{
+    const char *found = record(key);
+    return found != 0 && ValueField::load(found + 8 + KeyField::size, value,
+        blob, blobSize);
+}
+
+// stampa le coppie chiave-valore del dizionario
+template <typename K, typename V>
+void MappedDictionary<K, V>::print() const
+{
+    if (isEmpty()) { // controlla se il dizionario e' vuoto
+        std::cerr << "Dictionary is empty!\n";
+        return;
+    }
+
+    std::cout << "KEYS : VALUES\n";
+    forEach([](const K &key, const V &value) {
+        std::cout << key << " : " << value << "\n";
+    });
+}
+
+// chiama f su ciascuna coppia del dizionario, nell'ordine dei record
+// (i record non validi vengono saltati)
+template <typename K, typename V>
+template <typename F>
+void MappedDictionary<K, V>::forEach(F f) const
+{
+    K key;
+    V value;
+    for (std::uint64_t r = 0; r < count; ++r) {
+        const char *current = records + r * recordSize;
+        if (KeyField::load(current + 8, key, blob, blobSize)
+                && ValueField::load(current + 8 + KeyField::size, value,
+                    blob, blobSize))
+            f(static_cast<const K &>(key), static_cast<const V &>(value));
+    }
+}
+
+#endif
@@ -0,0 +1,251 @@
+// By Fabio Nardelli
+// Formato dei file snapshot di un dizionario, scritti da Dictionary::save e
+// letti senza deserializzazione da MappedDictionary. Chiavi e valori devono
+// essere di tipo banalmente copiabile (interi, double, struct senza
+// puntatori...) oppure std::string. Il file e' formato da:
+// - un'intestazione (SnapshotHeader) con numero magico, versione del
+//   formato, ordine dei byte e descrizione dei tipi di chiave e valore;
+// - il vettore degli inizi delle liste (buckets + 1 interi a 64 bit): i
+//   record della lista i sono quelli di indice start[i]..start[i + 1] - 1;
+// - i record, ordinati per lista: valore hash della chiave (64 bit), chiave
+//   e valore. Un campo banalmente copiabile contiene i byte dell'oggetto,
+//   un campo std::string la posizione e la lunghezza dei suoi caratteri
+//   nell'area stringhe; ogni campo occupa un multiplo di 8 byte;
+// - l'area stringhe, con i caratteri di tutte le stringhe.
+// Come in Dictionary, l'indice della lista di una chiave e' dato dai bit
+// alti del valore hash moltiplicato per 2^64 / phi. Il valore hash e'
+// calcolato da hashBytes sui byte della chiave (sui caratteri per le
+// std::string) e non dal funtore del dizionario, il cui risultato potrebbe
+// cambiare fra un programma e l'altro (ad es. std::hash). Per lo stesso
+// motivo le chiavi banalmente copiabili vengono confrontate byte per byte
+// e non devono contenere byte di riempimento (padding).
+// Il file non e' portabile fra piattaforme con diverso ordine dei byte o
+// diverse dimensioni dei tipi: l'intestazione ne tiene traccia, per cui
+// MappedDictionary rifiuta i file scritti da una piattaforma diversa.
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "Hash.h"
+
+// numero magico, versione del formato e valore usato per riconoscere
+// l'ordine dei byte della piattaforma che ha scritto il file
+const char snapshotMagic[8] = { 'D', 'I', 'C', 'T', 'S', 'N', 'A', 'P' };
+const std::uint32_t snapshotVersion = 1;
+const std::uint32_t snapshotByteOrder = 0x01020304;
+
+// intestazione di un file snapshot (64 byte)
+struct SnapshotHeader {
+    char magic[8]; // snapshotMagic
+    std::uint32_t version; // snapshotVersion
+    std::uint32_t byteOrder; // snapshotByteOrder
+    std::uint32_t keyKind; // SnapshotField<K>::kind
+    std::uint32_t valueKind; // SnapshotField<V>::kind
+    std::uint64_t keySize; // sizeof(K), 0 per std::string
+    std::uint64_t valueSize; // sizeof(V), 0 per std::string
+    std::uint64_t count; // numero di record
+    std::uint64_t buckets; // numero di liste (potenza di 2, almeno 2)
+    std::uint64_t blobSize; // dimensione dell'area stringhe
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "unexpected snapshot header size");
+
+// campo di un record per un tipo banalmente copiabile: contiene i byte
+// dell'oggetto, seguiti da byte nulli fino a un multiplo di 8
+template <typename T>
+struct SnapshotField {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "snapshot keys and values must be trivially copyable or std::string");
+
+    static const std::uint32_t kind = 0;
+    static const std::uint64_t objectSize = sizeof(T);
+    static const std::size_t size = (sizeof(T) + 7) / 8 * 8;
+
+    // valore hash, calcolato sui byte dell'oggetto
+    static std::uint64_t hash(const T &x) { return hashBytes(&x, sizeof(T)); }
+    // numero di byte occupati nell'area stringhe
+    static std::uint64_t blobLength(const T &) { return 0; }
+    // scrive x nel campo; offset e' la posizione dei suoi caratteri
+    // nell'area stringhe
+    static void store(char *field, const T &x, std::uint64_t)
+        { std::memcpy(field, &x, sizeof(T)); }
+    // scrive i caratteri di x nell'area stringhe
+    static void storeBlob(std::ostream &, const T &) { }
+    // restituisce true se il campo contiene x
+    static bool equals(const char *field, const T &x, const char *,
+        std::uint64_t)
+        { return std::memcmp(field, &x, sizeof(T)) == 0; }
+    // copia in x il contenuto del campo. Restituisce false se il campo
+    // non e' valido
+    static bool load(const char *field, T &x, const char *, std::uint64_t)
+    {
+        std::memcpy(&x, field, sizeof(T));
+        return true;
+    }
+};
+
+// campo di un record per una std::string: posizione e lunghezza dei
+// caratteri nell'area stringhe (due interi a 64 bit)
+template <>
+struct SnapshotField<std::string> {
+    static const std::uint32_t kind = 1;
+    static const std::uint64_t objectSize = 0;
+    static const std::size_t size = 16;
+
+    static std::uint64_t hash(const std::string &x)
+        { return hashBytes(x.data(), x.size()); }
+    static std::uint64_t blobLength(const std::string &x) { return x.size(); }
+    static void store(char *field, const std::string &x, std::uint64_t offset)
+    {
+        std::uint64_t length = x.size();
+        std::memcpy(field, &offset, 8);
+        std::memcpy(field + 8, &length, 8);
+    }
+    static void storeBlob(std::ostream &out, const std::string &x)
+        { out.write(x.data(), static_cast<std::streamsize>(x.size())); }
+    static bool equals(const char *field, const std::string &x,
+        const char *blob, std::uint64_t blobSize)
+    {
+        const char *chars = find(field, blob, blobSize);
+        std::uint64_t length;
+        std::memcpy(&length, field + 8, 8);
+        return chars != 0 && length == x.size()
+            && std::memcmp(chars, x.data(), x.size()) == 0;
+    }
+    static bool load(const char *field, std::string &x, const char *blob,
+        std::uint64_t blobSize)
+    {
+        const char *chars = find(field, blob, blobSize);
+        if (chars == 0)
+            return false;
+        std::uint64_t length;
+        std::memcpy(&length, field + 8, 8);
+        x.assign(chars, static_cast<std::size_t>(length));
+        return true;
+    }
+
+    // restituisce i caratteri della stringa del campo, o 0 se non sono
+    // compresi nell'area stringhe (file danneggiato)
+    static const char *find(const char *field, const char *blob,
+        std::uint64_t blobSize)
+    {
+        std::uint64_t offset, length;
+        std::memcpy(&offset, field, 8);
+        std::memcpy(&length, field + 8, 8);
+        if (offset > blobSize || length > blobSize - offset)
+            return 0;
+        return blob + offset;
+    }
+};
+
+// restituisce l'indice della lista per il valore hash h in un file con
+// 2^bits liste (vedi Dictionary::indexOf)
+inline std::size_t snapshotBucket(std::uint64_t h, unsigned bits)
+{
+    return static_cast<std::size_t>((h * 0x9E3779B97F4A7C15ULL)
+        >> (64 - bits));
+}
+
+// scrive nel file path lo snapshot del dizionario d, di cui usa solo
+// getSize e forEach. Il file viene scritto con un nome temporaneo e poi
+// rinominato, per cui i processi che hanno gia' mappato il vecchio file
+// continuano a leggerlo intatto. Restituisce false in caso di errore
+template <typename K, typename V, typename D>
+bool writeSnapshot(const std::string &path, const D &d)
+{
+    typedef SnapshotField<K> KeyField;
+    typedef SnapshotField<V> ValueField;
+    const std::size_t recordSize = 8 + KeyField::size + ValueField::size;
+
+    // una lista per ogni record, arrotondando alla potenza di 2 successiva
+    std::uint64_t count = d.getSize();
+    std::uint64_t buckets = 2;
+    unsigned bits = 1;
+    while (buckets < count) {
+        buckets *= 2;
+        ++bits;
+    }
+
+    // conta i record di ciascuna lista, da cui ricava gli inizi delle liste
+    std::vector<std::uint64_t> start(buckets + 1, 0);
+    std::uint64_t blobSize = 0;
+    d.forEach([&](const K &key, const V &value) {
+        ++start[snapshotBucket(KeyField::hash(key), bits) + 1];
+        blobSize += KeyField::blobLength(key) + ValueField::blobLength(value);
+    });
+    for (std::uint64_t i = 0; i < buckets; ++i)
+        start[i + 1] += start[i];
+
+    // scrive ciascun record nel primo posto libero della sua lista; le
+    // stringhe occupano l'area stringhe nell'ordine di visita
+    std::vector<char> records(count * recordSize, 0);
+    std::vector<std::uint64_t> next(start.begin(), start.end() - 1);
+    std::uint64_t offset = 0;
+    d.forEach([&](const K &key, const V &value) {
+        std::uint64_t h = KeyField::hash(key);
+        char *record = records.data()
+            + next[snapshotBucket(h, bits)]++ * recordSize;
+        std::memcpy(record, &h, 8);
+        KeyField::store(record + 8, key, offset);
+        offset += KeyField::blobLength(key);
+        ValueField::store(record + 8 + KeyField::size, value, offset);
+        offset += ValueField::blobLength(value);
+    });
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+    header.version = snapshotVersion;
+    header.byteOrder = snapshotByteOrder;
+    header.keyKind = KeyField::kind;
+    header.valueKind = ValueField::kind;
+    header.keySize = KeyField::objectSize;
+    header.valueSize = ValueField::objectSize;
+    header.count = count;
+    header.buckets = buckets;
+    header.blobSize = blobSize;
+
+    std::string temp = path + ".tmp";
+    std::ofstream out(temp.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot save dictionary: cannot create file!\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(start.data()),
+        static_cast<std::streamsize>(start.size() * 8));
+    out.write(records.data(), static_cast<std::streamsize>(records.size()));
+    // l'area stringhe, visitando le coppie nello stesso ordine di prima
+    d.forEach([&out](const K &key, const V &value) {
+        KeyField::storeBlob(out, key);
+        ValueField::storeBlob(out, value);
+    });
+    out.close();
+    if (!out) {
+        std::remove(temp.c_str());
+        std::cerr << "Cannot save dictionary: write error!\n";
+        return false;
+    }
+
+    // std::rename non sostituisce un file esistente su tutte le
+    // piattaforme: in tal caso cancella prima il vecchio file
+    if (std::rename(temp.c_str(), path.c_str()) != 0
+            && (std::remove(path.c_str()) != 0
+                || std::rename(temp.c_str(), path.c_str()) != 0)) {
+        std::remove(temp.c_str());
+        std::cerr << "Cannot save dictionary: cannot replace file!\n";
+        return false;
+    }
+
+    return true;
+}
+
+#endif
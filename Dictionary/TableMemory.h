@@ -0,0 +1,71 @@
+// By Fabio Nardelli
+// Memoria per i vettori di Dictionary e BloomFilter. Con l'allocatore di
+// glibc una richiesta di almeno 1 KB riunisce prima tutti i blocchi piccoli
+// liberati dall'ultima richiesta simile (ad es. i nodi di milioni di
+// elementi appena rimossi), per cui un solo ::operator new puo' richiedere
+// decine di millisecondi anche se la ristrutturazione e' incrementale, e
+// anche per un vettore piccolo. I vettori di almeno largeTableBytes
+// vengono quindi mappati direttamente con mmap, che non tocca lo heap: le
+// pagine sono azzerate e vengono caricate al primo accesso. In cambio un
+// vettore mappato occupa almeno una pagina (4 KB), per cui i vettori
+// minori restano allocati con ::operator new. Sulle piattaforme senza mmap
+// viene usato sempre l'allocatore di default.
+
+#ifndef TABLE_MEMORY_H
+#define TABLE_MEMORY_H
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TABLE_MEMORY_MMAP 1
+#include <sys/mman.h>
+#endif
+
+// dimensione in byte da cui un vettore viene mappato con mmap
+const std::size_t largeTableBytes = 1024;
+
+// alloca bytes byte non inizializzati (azzerati se mappati)
+inline void *allocateTableMemory(std::size_t bytes)
+{
+#ifdef TABLE_MEMORY_MMAP
+    if (bytes >= largeTableBytes) {
+        void *p = ::mmap(0, bytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return p;
+    }
+#endif
+    return ::operator new(bytes);
+}
+
+// alloca bytes byte azzerati
+inline void *allocateZeroedTableMemory(std::size_t bytes)
+{
+    void *p = allocateTableMemory(bytes);
+#ifdef TABLE_MEMORY_MMAP
+    if (bytes >= largeTableBytes)
+        return p; // le pagine mappate sono gia' azzerate
+#endif
+    std::memset(p, 0, bytes);
+    return p;
+}
+
+// libera la memoria p di bytes byte (la stessa dimensione passata
+// all'allocazione); p puo' essere 0
+inline void freeTableMemory(void *p, std::size_t bytes)
+{
+    if (p == 0)
+        return;
+#ifdef TABLE_MEMORY_MMAP
+    if (bytes >= largeTableBytes) {
+        ::munmap(p, bytes);
+        return;
+    }
+#endif
+    ::operator delete(p);
+}
+
+#endif
@@ -0,0 +1,120 @@
+// benchmark di ConcurrentDictionary contro un Dictionary protetto da un solo
+// mutex. Il dizionario contiene n chiavi intere; t thread eseguono in tutto
+// ops operazioni su chiavi casuali scelte fra 2n (sparse come in
+// benchFlat.cpp, meta' presenti all'inizio): nel carico di lettura il 90%
+// sono ricerche e il resto inserimenti e rimozioni in parti uguali, nel
+// carico di scrittura meta' inserimenti e meta' rimozioni. Il numero di
+// thread raddoppia fino al doppio dei core disponibili; la scalabilita' e'
+// significativa solo finche' i thread non superano i core.
+// Compilare con -pthread.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include "ConcurrentDictionary.h"
+using std::cout;
+
+// Dictionary protetto da un unico mutex, con la stessa interfaccia
+// di ConcurrentDictionary usata dal benchmark
+class LockedDictionary {
+public:
+    void insert(int key, int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        table.insert(key, value);
+    }
+    bool remove(int key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (table.find(key) == 0)
+            return false;
+        table.remove(key);
+        return true;
+    }
+    bool find(int key, int &value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        const int *found = table.find(key);
+        if (found == 0)
+            return false;
+        value = *found;
+        return true;
+    }
+private:
+    std::mutex lock;
+    Dictionary<int, int> table;
+};
+
+// esegue il carico con t thread e restituisce milioni di operazioni
+// al secondo; readPercent e' la percentuale di ricerche
+template <typename D>
+double run(D &d, int threadCount, int ops, int n, int readPercent)
+{
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; ++t)
+        threads.push_back(std::thread([&d, t, threadCount, ops, n,
+                readPercent]() {
+            // generatore xorshift proprio di ciascun thread
+            unsigned state = 2463534242u + 7919u * t;
+            int value = 0;
+            for (int i = 0; i < ops / threadCount; ++i) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                int key = static_cast<int>(state % (2u * n) * 2654435761u);
+                int choice = static_cast<int>((state >> 8) % 100);
+                if (choice < readPercent)
+                    d.find(key, value);
+                else if (choice % 2 == 0)
+                    d.insert(key, i);
+                else
+                    d.remove(key);
+            }
+        }));
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return ops / std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+int main()
+{
+    const int n = 1 << 20, ops = 1 << 22;
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    if (cores < 1)
+        cores = 1;
+
+    cout << "\n************** BENCHMARK ConcurrentDictionary **************\n\n";
+    cout << n << " chiavi, " << ops << " operazioni, " << cores
+         << " core disponibili\nmilioni di operazioni al secondo\n\n";
+    cout << std::setw(8) << "thread" << std::setw(26) << "lettura (90% find)"
+         << std::setw(26) << "scrittura (insert/remove)" << "\n";
+    cout << std::setw(8) << "";
+    for (int i = 0; i < 2; ++i)
+        cout << std::setw(13) << "un mutex" << std::setw(13) << "shard";
+    cout << "\n" << std::fixed << std::setprecision(2);
+
+    for (int t = 1; t <= 2 * cores; t *= 2) {
+        cout << std::setw(8) << t;
+        for (int readPercent = 90; readPercent >= 0; readPercent -= 90) {
+            LockedDictionary locked;
+            ConcurrentDictionary<int, int> sharded;
+            for (int i = 0; i < n; ++i) {
+                int key = static_cast<int>(2u * i * 2654435761u);
+                locked.insert(key, i);
+                sharded.insert(key, i);
+            }
+            cout << std::setw(13) << run(locked, t, ops, n, readPercent)
+                 << std::setw(13) << run(sharded, t, ops, n, readPercent);
+        }
+        cout << "\n";
+    }
+
+    return 0;
+}
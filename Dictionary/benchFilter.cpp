@@ -0,0 +1,137 @@
+// benchmark del filtro di appartenenza approssimata di Dictionary: per ogni
+// dimensione n vengono inserite n chiavi intere casuali e misurate n
+// ricerche di chiavi assenti e n ricerche miste (90% assenti, 10%
+// presenti), con NoFilter (il default) e con BloomFilter. Le dimensioni
+// sono scelte in modo che il fattore di carico finale sia circa 1, 1.5 e 2
+// (il massimo prima del raddoppio). La percentuale di falsi positivi e'
+// quella delle chiavi assenti che superano un BloomFilter dimensionato e
+// riempito come quello del dizionario. Come in benchStats.cpp le misure
+// vengono ripetute nell'ordine NoFilter, BloomFilter, BloomFilter,
+// NoFilter e per ciascun filtro si tiene la minima. Tempi medi per
+// operazione in nanosecondi.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+// somma i valori delle chiavi trovate
+template <typename D>
+long long findAll(const D &d, const std::vector<int> &keys)
+{
+    long long sum = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const int *found = d.find(keys[i]);
+        if (found != 0)
+            sum += *found;
+    }
+    return sum;
+}
+
+// misura inserimenti, ricerche di chiavi assenti e ricerche miste con il
+// filtro Filter, aggiornando i tempi minimi in times[0..2]
+template <typename Filter>
+void run(const std::vector<int> &keys, const std::vector<int> &misses,
+    const std::vector<int> &mixed, double *times)
+{
+    Dictionary<int, int, Hash<int>, NoStats, Filter> d;
+    double insert = timeOps([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            d.insert(keys[i], static_cast<int>(i));
+    }, keys.size());
+    double miss = timeOps([&] { sink = findAll(d, misses); }, misses.size());
+    double mix = timeOps([&] { sink = findAll(d, mixed); }, mixed.size());
+    times[0] = std::min(times[0], insert);
+    times[1] = std::min(times[1], miss);
+    times[2] = std::min(times[2], mix);
+}
+
+// restituisce la percentuale di chiavi assenti che superano un filtro
+// dimensionato per capacity liste e riempito con le chiavi presenti
+double falsePositives(const std::vector<int> &keys,
+    const std::vector<int> &misses, std::size_t capacity)
+{
+    Hash<int> hash;
+    BloomFilter filter;
+    filter.create(capacity);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        filter.add(hash(keys[i]));
+    std::size_t passed = 0;
+    for (std::size_t i = 0; i < misses.size(); ++i)
+        if (filter.mayContain(hash(misses[i])))
+            ++passed;
+    return 100.0 * passed / misses.size();
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK FILTRO **************\n\n";
+    cout << "tempo medio per operazione (ns/op), falsi positivi in %\n\n";
+    cout << std::setw(9) << "n" << std::setw(7) << "carico"
+         << std::setw(8) << "f.p. %" << std::setw(30) << "NoFilter"
+         << std::setw(30) << "BloomFilter" << "\n";
+    cout << std::setw(24) << "";
+    for (int i = 0; i < 2; ++i)
+        cout << std::setw(10) << "inserim." << std::setw(10) << "assenti"
+             << std::setw(10) << "miste";
+    cout << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t m = 1 << 12; m <= 1 << 21; m <<= 3) {
+        const std::size_t sizes[] = { m + 1, m + m / 2, 2 * m };
+        for (int s = 0; s < 3; ++s) {
+            std::size_t n = sizes[s];
+            // chiavi distinte e sparse (vedi benchFlat.cpp): le chiavi
+            // assenti sono quelle di indice n..2n - 1
+            std::vector<int> keys(n), misses(n), mixed(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                keys[i] = static_cast<int>(i * 2654435761u);
+                misses[i] = static_cast<int>((i + n) * 2654435761u);
+            }
+            std::shuffle(keys.begin(), keys.end(), random);
+            std::shuffle(misses.begin(), misses.end(), random);
+            for (std::size_t i = 0; i < n; ++i)
+                mixed[i] = i % 10 == 0 ? keys[i] : misses[i];
+            std::shuffle(mixed.begin(), mixed.end(), random);
+
+            Dictionary<int, int> sizing;
+            for (std::size_t i = 0; i < n; ++i)
+                sizing.insert(keys[i], 0);
+            std::size_t capacity = sizing.getCapacity();
+
+            double times[6] = { 1e9, 1e9, 1e9, 1e9, 1e9, 1e9 };
+            run<NoFilter>(keys, misses, mixed, times);
+            run<BloomFilter>(keys, misses, mixed, times + 3);
+            run<BloomFilter>(keys, misses, mixed, times + 3);
+            run<NoFilter>(keys, misses, mixed, times);
+            cout << std::setw(9) << n << std::fixed << std::setprecision(2)
+                 << std::setw(7) << static_cast<double>(n) / capacity
+                 << std::setw(8) << falsePositives(keys, misses, capacity)
+                 << std::setprecision(1);
+            for (int i = 0; i < 6; ++i)
+                cout << std::setw(10) << times[i];
+            cout << "\n";
+        }
+    }
+
+    return 0;
+}
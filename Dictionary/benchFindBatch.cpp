@@ -0,0 +1,81 @@
+// benchmark della ricerca di gruppi di chiavi in un Dictionary. Per ogni
+// dimensione n vengono inserite n chiavi intere casuali, poi le ricerche
+// vengono eseguite a gruppi di 64, 256 e 1024 chiavi (meta' presenti e meta'
+// assenti, in ordine casuale), una alla volta con find oppure con un'unica
+// chiamata a findBatch, che carica in anticipo le liste di trabocco delle
+// chiavi successive. Tempi medi per chiave in nanosecondi. Anche le
+// chiamate a find di un gruppo sono indipendenti fra loro, per cui il
+// processore ne sovrappone in parte i mancati accessi alla cache: il
+// vantaggio di findBatch e' limitato al numero di accessi alla memoria che
+// il processore riesce a tenere in corso contemporaneamente.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi per chiave
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+int main()
+{
+    cout << "\n*************** BENCHMARK RICERCA A GRUPPI ***************\n\n";
+    cout << "tempo medio per chiave (ns)\n\n";
+    cout << std::setw(10) << "n" << std::setw(8) << "gruppo"
+         << std::setw(12) << "find" << std::setw(12) << "findBatch" << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 16; n <= 1 << 24; n <<= 4) {
+        // chiavi distinte e sparse (vedi benchFlat.cpp): i valori 0..n-1
+        // danno le chiavi inserite e n..2n-1 quelle assenti
+        std::vector<int> queries(2 * n);
+        Dictionary<int, int> d;
+        for (std::size_t i = 0; i < 2 * n; ++i) {
+            queries[i] = static_cast<int>(i * 2654435761u);
+            if (i < n)
+                d.insert(queries[i], static_cast<int>(i));
+        }
+        std::shuffle(queries.begin(), queries.end(), random);
+        std::vector<const int *> out(queries.size());
+
+        for (std::size_t group = 64; group <= 1024; group *= 4) {
+            double findTime = timeOps([&] {
+                long long found = 0;
+                for (std::size_t i = 0; i < queries.size(); i += group)
+                    for (std::size_t j = i; j < i + group; ++j) {
+                        out[j] = d.find(queries[j]);
+                        found += out[j] != 0;
+                    }
+                sink = found;
+            }, queries.size());
+            double batchTime = timeOps([&] {
+                long long found = 0;
+                for (std::size_t i = 0; i < queries.size(); i += group)
+                    found += d.findBatch(&queries[i], group, &out[i]);
+                sink = found;
+            }, queries.size());
+            cout << std::setw(10) << n << std::setw(8) << group
+                 << std::fixed << std::setprecision(1)
+                 << std::setw(12) << findTime << std::setw(12) << batchTime
+                 << "\n";
+        }
+    }
+
+    return 0;
+}
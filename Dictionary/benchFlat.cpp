@@ -0,0 +1,91 @@
+// benchmark di FlatDictionary (indirizzamento aperto) contro Dictionary
+// (liste di trabocco), scelti tramite DictionaryFor. Per ogni dimensione n
+// vengono inserite n chiavi intere casuali, poi vengono misurate n ricerche
+// di chiavi presenti (in ordine casuale) e n ricerche di chiavi assenti.
+// Tempi medi per operazione in nanosecondi.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "DictionaryFor.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+// misura inserimenti, ricerche con successo e ricerche senza successo
+template <typename Layout>
+void run(const std::vector<int> &keys, const std::vector<int> &hits,
+    const std::vector<int> &misses)
+{
+    typename DictionaryFor<int, int, Layout>::type d;
+    double insertTime = timeOps([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            d.insert(keys[i], static_cast<int>(i));
+    }, keys.size());
+    double hitTime = timeOps([&] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            sum += *d.find(hits[i]);
+        sink = sum;
+    }, hits.size());
+    double missTime = timeOps([&] {
+        long long found = 0;
+        for (std::size_t i = 0; i < misses.size(); ++i)
+            found += d.find(misses[i]) != 0;
+        sink = found;
+    }, misses.size());
+    cout << std::setw(12) << insertTime << std::setw(12) << hitTime
+         << std::setw(12) << missTime;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK FlatDictionary **************\n\n";
+    cout << "tempo medio per operazione (ns/op)\n\n";
+    cout << std::setw(10) << "n" << std::setw(36) << "Dictionary (Chaining)"
+         << std::setw(36) << "FlatDictionary (OpenAddressing)" << "\n";
+    cout << std::setw(10) << "";
+    for (int i = 0; i < 2; ++i)
+        cout << std::setw(12) << "inserimento" << std::setw(12) << "trovate"
+             << std::setw(12) << "assenti";
+    cout << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 20; n <= 1 << 24; n <<= 2) {
+        // chiavi distinte e sparse: la moltiplicazione per una costante
+        // dispari e' una biiezione sugli interi a 32 bit, per cui i valori
+        // 0..n-1 danno le chiavi inserite e n..2n-1 quelle assenti
+        std::vector<int> keys(n), misses(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(i * 2654435761u);
+            misses[i] = static_cast<int>((i + n) * 2654435761u);
+        }
+        std::shuffle(keys.begin(), keys.end(), random);
+        std::vector<int> hits(keys);
+        std::shuffle(hits.begin(), hits.end(), random);
+        std::shuffle(misses.begin(), misses.end(), random);
+
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1);
+        run<Chaining>(keys, hits, misses);
+        run<OpenAddressing>(keys, hits, misses);
+        cout << "\n";
+    }
+
+    return 0;
+}
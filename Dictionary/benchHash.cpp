@@ -0,0 +1,187 @@
+// benchmark delle funzioni hash di Hash.h. Misura:
+// - la velocita' di hashBytes sulle stringhe, contro l'algoritmo DJB2 (un
+//   byte alla volta) usato in precedenza e contro std::hash;
+// - il costo di mixInteger rispetto a std::hash (l'identita' per gli interi);
+// - la distribuzione delle lunghezze delle liste di trabocco, simulando una
+//   tabella di Dictionary con fattore di carico 2 (capacita' potenza di 2):
+//   lista piu' lunga, percentuale di liste vuote e numero medio di chiavi
+//   confrontate da una ricerca con successo (idealmente 1 + 2 / 2 = 2);
+// - il tempo di ricerca di un Dictionary con chiavi multiple di 1024, con
+//   il funtore Hash<int> e con un funtore che restituisce la chiave stessa.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include "Dictionary.h"
+using std::cout;
+using std::string;
+
+// evita che il compilatore elimini i cicli di misura
+volatile std::size_t sink;
+
+// DJB2, un byte alla volta (la funzione usata in precedenza da Hash.h)
+struct Djb2Hash {
+    std::size_t operator()(const string &key) const
+    {
+        std::size_t hash = 5381;
+        for (std::size_t i = 0; i < key.length(); ++i)
+            hash = ((hash << 5) + hash) + key[i];
+        return hash;
+    }
+};
+
+// std::hash senza rimescolamento (l'identita' per gli interi)
+template <typename K>
+struct StdHash {
+    std::size_t operator()(const K &key) const { return std::hash<K>()(key); }
+};
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+// ns per valore hash calcolato sulle stringhe indicate
+template <typename H>
+double stringSpeed(const std::vector<string> &keys, int rounds)
+{
+    H hasher;
+    return timeOps([&] {
+        std::size_t sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (std::size_t i = 0; i < keys.size(); ++i)
+                sum += hasher(keys[i]);
+        sink = sum;
+    }, keys.size() * rounds);
+}
+
+// ns per valore hash calcolato sugli interi indicati
+template <typename H>
+double integerSpeed(const std::vector<int> &keys)
+{
+    H hasher;
+    return timeOps([&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            sum += hasher(keys[i]);
+        sink = sum;
+    }, keys.size());
+}
+
+// stampa la distribuzione delle lunghezze delle liste di una tabella
+// di keys.size() / 2 liste
+template <typename K, typename H>
+void distribution(const string &name, const std::vector<K> &keys)
+{
+    H hasher;
+    std::size_t capacity = keys.size() / 2;
+    std::vector<std::size_t> lengths(capacity, 0);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        ++lengths[hasher(keys[i]) % capacity];
+
+    std::size_t longest = 0, empty = 0;
+    double compared = 0; // somma dei confronti delle ricerche con successo
+    for (std::size_t i = 0; i < capacity; ++i) {
+        longest = std::max(longest, lengths[i]);
+        empty += lengths[i] == 0;
+        compared += lengths[i] * (lengths[i] + 1) / 2.0;
+    }
+    cout << std::setw(30) << name << std::setw(12) << longest
+         << std::setw(11) << 100.0 * empty / capacity << "%"
+         << std::setw(12) << compared / keys.size() << "\n";
+}
+
+// ns per ricerca in un Dictionary con il funtore hash H
+template <typename H>
+double dictionaryFind(const std::vector<int> &keys)
+{
+    Dictionary<int, int, H> d;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        d.insert(keys[i], static_cast<int>(i));
+    return timeOps([&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            sum += *d.find(keys[i]);
+        sink = sum;
+    }, keys.size());
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK Hash.h **************\n\n";
+    cout << std::fixed << std::setprecision(2);
+
+    // velocita' sulle stringhe
+    cout << "ns per stringa\n" << std::setw(10) << "lunghezza"
+         << std::setw(12) << "DJB2" << std::setw(12) << "std::hash"
+         << std::setw(12) << "hashBytes" << "\n";
+    const std::size_t lengths[] = { 4, 8, 16, 32, 64, 256, 4096 };
+    for (std::size_t l : lengths) {
+        std::vector<string> keys(1024);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = string(l, 'a');
+            for (std::size_t j = 0; j < l; ++j)
+                keys[i][j] = static_cast<char>('a' + (i * 7 + j * 13) % 26);
+        }
+        int rounds = static_cast<int>(std::max<std::size_t>(1, 20000 / l));
+        cout << std::setw(10) << l
+             << std::setw(12) << stringSpeed<Djb2Hash>(keys, rounds)
+             << std::setw(12) << stringSpeed<StdHash<string> >(keys, rounds)
+             << std::setw(12) << stringSpeed<Hash<string> >(keys, rounds)
+             << "\n";
+    }
+
+    const std::size_t count = 1 << 20;
+    std::vector<int> sequential(count), multiples(count);
+    std::vector<string> words(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sequential[i] = static_cast<int>(i);
+        multiples[i] = static_cast<int>(i * 1024);
+        words[i] = "user" + std::to_string(i);
+    }
+
+    // velocita' sugli interi
+    cout << "\nns per intero\n" << std::setw(22) << "std::hash (identita')"
+         << std::setw(14) << "mixInteger" << "\n"
+         << std::setw(22) << integerSpeed<StdHash<int> >(multiples)
+         << std::setw(14) << integerSpeed<Hash<int> >(multiples) << "\n";
+
+    // distribuzione delle lunghezze delle liste
+    cout << "\n" << count << " chiavi, " << count / 2 << " liste\n"
+         << std::setw(30) << "chiavi / funzione hash" << std::setw(12)
+         << "max lista" << std::setw(12) << "vuote" << std::setw(12)
+         << "confronti" << "\n";
+    distribution<int, StdHash<int> >("0..n-1 / identita'", sequential);
+    distribution<int, Hash<int> >("0..n-1 / mixInteger", sequential);
+    distribution<int, StdHash<int> >("i * 1024 / identita'", multiples);
+    distribution<int, Hash<int> >("i * 1024 / mixInteger", multiples);
+    distribution<string, Djb2Hash>("\"user<i>\" / DJB2", words);
+    distribution<string, StdHash<string> >("\"user<i>\" / std::hash", words);
+    distribution<string, Hash<string> >("\"user<i>\" / hashBytes", words);
+
+    // effetto su Dictionary
+    std::vector<int> keys(1 << 16);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        keys[i] = static_cast<int>(i * 1024);
+    std::mt19937 random(1);
+    std::shuffle(keys.begin(), keys.end(), random);
+    cout << "\nDictionary<int, int, Hasher>, " << keys.size()
+         << " chiavi multiple di 1024, ns per ricerca\n"
+         << std::setw(22) << "std::hash (identita')" << std::setw(14)
+         << "Hash<int>" << "\n"
+         << std::setw(22) << dictionaryFind<StdHash<int> >(keys)
+         << std::setw(14) << dictionaryFind<Hash<int> >(keys) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+// benchmark del calcolo dell'indice della lista di trabocco in Dictionary.
+// Confronta la riduzione del valore hash con il modulo (una divisione
+// intera, usata in precedenza) e con la moltiplicazione per 2^64 / phi
+// seguita da uno scorrimento (hashing di Fibonacci, usata ora), poi misura
+// il tempo medio di una ricerca con successo in Dictionary<int, int> per
+// tabelle di dimensioni crescenti. Il valore di ogni chiave e' la posizione
+// della chiave da cercare dopo, per cui le ricerche non si sovrappongono e
+// viene misurata la loro latenza: nelle tabelle piccole, che stanno in
+// cache, il calcolo dell'indice ne e' una parte importante.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di misura
+volatile std::size_t sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK INDICE Dictionary **************\n\n";
+    cout << std::fixed << std::setprecision(2);
+
+    // riduzione di valori hash casuali; ogni indice dipende dal precedente,
+    // per cui viene misurata la latenza e non solo il throughput
+    std::mt19937_64 random(1);
+    std::vector<unsigned long long> hashes(1 << 16);
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+        hashes[i] = random();
+    const int rounds = 256;
+    cout << "ns per indice (dipendenti)\n" << std::setw(12) << "capacita'"
+         << std::setw(12) << "modulo" << std::setw(12) << "Fibonacci" << "\n";
+    for (unsigned bits = 4; bits <= 24; bits += 10) {
+        std::size_t capacity = std::size_t(1) << bits;
+        // capacita' letta da una variabile volatile: il compilatore non sa
+        // che e' una potenza di 2 (come nel Dictionary originale)
+        volatile std::size_t opaque = capacity;
+        std::size_t divisor = opaque;
+        double modulo = timeOps([&] {
+            std::size_t index = 0;
+            for (int r = 0; r < rounds; ++r)
+                for (std::size_t i = 0; i < hashes.size(); ++i)
+                    index = (hashes[i] ^ index) % divisor;
+            sink = index;
+        }, hashes.size() * rounds);
+        double fibonacci = timeOps([&] {
+            std::size_t index = 0;
+            for (int r = 0; r < rounds; ++r)
+                for (std::size_t i = 0; i < hashes.size(); ++i)
+                    index = static_cast<std::size_t>(((hashes[i] ^ index)
+                        * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+            sink = index;
+        }, hashes.size() * rounds);
+        cout << std::setw(12) << capacity << std::setw(12) << modulo
+             << std::setw(12) << fibonacci << "\n";
+    }
+
+    // ricerche con successo in Dictionary
+    cout << "\nDictionary<int, int>: ns per ricerca con successo (dipendenti)\n"
+         << std::setw(12) << "n" << std::setw(12) << "find" << "\n";
+    std::mt19937 shuffle(1);
+    for (std::size_t n = 1 << 10; n <= 1 << 22; n <<= 4) {
+        // chiavi in ordine casuale; il valore della chiave i-esima e' i + 1,
+        // cioe' la posizione della successiva (0 per l'ultima)
+        std::vector<int> keys(n);
+        for (std::size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<int>(i * 2654435761u);
+        std::shuffle(keys.begin(), keys.end(), shuffle);
+        Dictionary<int, int> d;
+        for (std::size_t i = 0; i < n; ++i)
+            d.insert(keys[i], static_cast<int>((i + 1) % n));
+        std::size_t ops = std::max<std::size_t>(n, 1 << 24);
+        double find = timeOps([&] {
+            int next = 0;
+            for (std::size_t i = 0; i < ops; ++i)
+                next = *d.find(keys[next]);
+            sink = next;
+        }, ops);
+        cout << std::setw(12) << n << std::setw(12) << find << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+// benchmark delle ricerche eterogenee e con valore hash precalcolato in
+// Dictionary<std::string, int>. Le chiavi sono lunghe 24 caratteri, per cui
+// una std::string temporanea alloca memoria. Misura:
+// - find(std::string(p, n)): la chiave viene copiata in una stringa
+//   temporanea, come quando la si ricava da un buffer;
+// - find(const char *): ricerca eterogenea, senza stringa temporanea
+//   (in C++17 lo stesso vale per find(std::string_view));
+// - la ricerca della stessa chiave in quattro dizionari, con find e con
+//   un solo hashOf seguito da quattro findWithHash.
+// Tempi medi per chiave in nanosecondi.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+using std::string;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK RICERCHE Dictionary **************\n\n";
+    cout << std::fixed << std::setprecision(1);
+    cout << std::setw(10) << "n" << std::setw(14) << "temporanea"
+         << std::setw(14) << "const char *" << std::setw(14) << "4 x find"
+         << std::setw(18) << "4 x findWithHash" << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 10; n <= 1 << 20; n <<= 5) {
+        // chiavi di 24 caratteri: "key-" seguito da 20 cifre
+        std::vector<string> keys(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            string digits = std::to_string(i * 2654435761u);
+            keys[i] = "key-" + string(20 - digits.size(), '0') + digits;
+        }
+        Dictionary<string, int> dictionaries[4];
+        for (int d = 0; d < 4; ++d)
+            for (std::size_t i = 0; i < n; ++i)
+                dictionaries[d].insert(keys[i], static_cast<int>(i) + d);
+        std::shuffle(keys.begin(), keys.end(), random);
+        const Dictionary<string, int> &first = dictionaries[0];
+        std::size_t repeat = std::max<std::size_t>(1, (1 << 22) / n);
+
+        double temporary = timeOps([&] {
+            long long sum = 0;
+            for (std::size_t r = 0; r < repeat; ++r)
+                for (std::size_t i = 0; i < n; ++i)
+                    sum += *first.find(string(keys[i].data(), keys[i].size()));
+            sink = sum;
+        }, n * repeat);
+        double pointer = timeOps([&] {
+            long long sum = 0;
+            for (std::size_t r = 0; r < repeat; ++r)
+                for (std::size_t i = 0; i < n; ++i)
+                    sum += *first.find(keys[i].c_str());
+            sink = sum;
+        }, n * repeat);
+        double fourFind = timeOps([&] {
+            long long sum = 0;
+            for (std::size_t r = 0; r < repeat; ++r)
+                for (std::size_t i = 0; i < n; ++i)
+                    for (int d = 0; d < 4; ++d)
+                        sum += *dictionaries[d].find(keys[i]);
+            sink = sum;
+        }, n * repeat);
+        double fourWithHash = timeOps([&] {
+            long long sum = 0;
+            for (std::size_t r = 0; r < repeat; ++r)
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::size_t h = first.hashOf(keys[i]);
+                    for (int d = 0; d < 4; ++d)
+                        sum += *dictionaries[d].findWithHash(keys[i], h);
+                }
+            sink = sum;
+        }, n * repeat);
+
+        cout << std::setw(10) << n << std::setw(14) << temporary
+             << std::setw(14) << pointer << std::setw(14) << fourFind
+             << std::setw(18) << fourWithHash << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+// benchmark della ristrutturazione incrementale di Dictionary. Per ogni
+// dimensione n vengono inserite n chiavi intere casuali e poi rimosse
+// tutte, in un altro ordine, misurando il tempo di ciascun inserimento e di
+// ciascuna rimozione, prima con la ristrutturazione in un'unica volta
+// (setRehashStep(0)) e poi con quella incrementale; vengono riportati tempo
+// medio, percentili e tempo massimo in nanosecondi. I raddoppi e i
+// dimezzamenti della tabella sono pochi (log n), per cui compaiono
+// soprattutto nel tempo massimo, che con la ristrutturazione incrementale
+// scende di ordini di grandezza; in cambio ogni operazione sposta qualche
+// lista e i percentili alti crescono con il numero di liste spostate per
+// operazione. Durante le rimozioni i dimezzamenti si susseguono a distanza
+// di capacity / 16 operazioni, per cui vengono spostate almeno 16 liste per
+// rimozione (vedi Dictionary::migrationStep).
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+
+// restituisce il valore del percentile p (tra 0 e 1) dei tempi ordinati
+double percentile(const std::vector<double> &sorted, double p)
+{
+    return sorted[static_cast<std::size_t>(p * (sorted.size() - 1))];
+}
+
+// stampa la distribuzione dei tempi (ordinati) di un tipo di operazione
+void printTimes(std::size_t n, std::size_t step, const char *operation,
+    const std::vector<double> &times, double total)
+{
+    cout << std::setw(10) << n << std::setw(10) << step
+         << std::setw(13) << operation
+         << std::setw(10) << total / times.size()
+         << std::setw(10) << percentile(times, 0.5)
+         << std::setw(10) << percentile(times, 0.99)
+         << std::setw(10) << percentile(times, 0.999)
+         << std::setw(10) << percentile(times, 0.9999)
+         << std::setw(14) << times.back() << "\n";
+}
+
+// inserisce le chiavi in un dizionario che sposta step liste per operazione,
+// poi le rimuove nell'ordine di removals, e stampa la distribuzione dei
+// tempi di inserimento e di rimozione
+void run(const std::vector<int> &keys, const std::vector<int> &removals,
+    std::size_t step)
+{
+    Dictionary<int, int> d;
+    d.setRehashStep(step);
+    std::vector<double> times(keys.size());
+    double total = 0;
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        d.insert(keys[i], static_cast<int>(i));
+        std::chrono::steady_clock::time_point stop =
+            std::chrono::steady_clock::now();
+        times[i] = std::chrono::duration<double, std::nano>(stop - start)
+            .count();
+        total += times[i];
+    }
+    std::sort(times.begin(), times.end());
+    printTimes(keys.size(), step, "inserimento", times, total);
+
+    total = 0;
+    for (std::size_t i = 0; i < removals.size(); ++i) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        d.remove(removals[i]);
+        std::chrono::steady_clock::time_point stop =
+            std::chrono::steady_clock::now();
+        times[i] = std::chrono::duration<double, std::nano>(stop - start)
+            .count();
+        total += times[i];
+    }
+    std::sort(times.begin(), times.end());
+    printTimes(keys.size(), step, "rimozione", times, total);
+}
+
+int main()
+{
+    cout << "\n*********** BENCHMARK RISTRUTTURAZIONE INCREMENTALE ***********\n\n";
+    cout << "tempi di inserimento e rimozione (ns); step 0 = "
+         << "ristrutturazione in un'unica volta\n\n";
+    cout << std::setw(10) << "n" << std::setw(10) << "step"
+         << std::setw(13) << "operazione" << std::setw(10) << "media"
+         << std::setw(10) << "p50" << std::setw(10) << "p99"
+         << std::setw(10) << "p99.9" << std::setw(10) << "p99.99"
+         << std::setw(14) << "massimo" << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 20; n <= 1 << 24; n <<= 2) {
+        // chiavi distinte e sparse (vedi benchFlat.cpp)
+        std::vector<int> keys(n);
+        for (std::size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<int>(i * 2654435761u);
+        std::shuffle(keys.begin(), keys.end(), random);
+        std::vector<int> removals(keys);
+        std::shuffle(removals.begin(), removals.end(), random);
+
+        cout << std::fixed << std::setprecision(0);
+        run(keys, removals, 0);
+        run(keys, removals, 4);
+        run(keys, removals, 32);
+        cout << "\n";
+    }
+
+    return 0;
+}
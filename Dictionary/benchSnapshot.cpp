@@ -0,0 +1,95 @@
+// benchmark degli snapshot su file. Per ogni dimensione n viene costruito
+// un Dictionary con n chiavi stringa e valori interi (il costo che si paga
+// a ogni riavvio se il dizionario va ricostruito), salvato con save e
+// riaperto con openMapped; vengono poi misurate n ricerche casuali sul
+// dizionario in memoria e su quello mappato. La mappatura non legge il
+// file: le sue pagine sono gia' nella page cache perche' il file e' appena
+// stato scritto, come accade ai processi che aprono uno snapshot gia'
+// mappato da un altro processo.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <cstdio>
+#include "Dictionary.h"
+#include "MappedDictionary.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo impiegato da f in millisecondi
+template <typename F>
+double timeMs(F f)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main()
+{
+    const char *path = "benchSnapshot.snapshot";
+    cout << "\n***************** BENCHMARK SNAPSHOT *****************\n\n";
+    cout << "costruzione, salvataggio e apertura in ms, ricerche in ns\n\n";
+    cout << std::setw(10) << "n" << std::setw(14) << "costruzione"
+         << std::setw(10) << "save" << std::setw(12) << "openMapped"
+         << std::setw(12) << "find" << std::setw(12) << "mappata" << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 18; n <= 1 << 22; n <<= 2) {
+        std::vector<std::pair<std::string, int> > pairs(n);
+        for (std::size_t i = 0; i < n; ++i)
+            pairs[i] = std::make_pair("chiave-" + std::to_string(i * 7919),
+                static_cast<int>(i));
+        std::vector<std::string> queries(n);
+        for (std::size_t i = 0; i < n; ++i)
+            queries[i] = pairs[random() % n].first;
+
+        Dictionary<std::string, int> *d = 0;
+        double buildTime = timeMs([&] {
+            d = new Dictionary<std::string, int>(pairs.begin(), pairs.end());
+        });
+        double saveTime = timeMs([&] { d->save(path); });
+        MappedDictionary<std::string, int> *mapped = 0;
+        double openTime = timeMs([&] {
+            mapped = new MappedDictionary<std::string, int>(path);
+        });
+
+        double findTime = timeMs([&] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                sum += *d->find(queries[i]);
+            sink = sum;
+        });
+        double mappedTime = timeMs([&] {
+            long long sum = 0;
+            int value = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                if (mapped->find(queries[i], value))
+                    sum += value;
+            sink = sum;
+        });
+
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1)
+             << std::setw(14) << buildTime << std::setw(10) << saveTime
+             << std::setw(12) << std::setprecision(3) << openTime
+             << std::setprecision(1)
+             << std::setw(12) << findTime * 1e6 / n
+             << std::setw(12) << mappedTime * 1e6 / n << "\n";
+
+        delete mapped;
+        delete d;
+        std::remove(path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// benchmark del costo delle statistiche di Dictionary: per ogni dimensione
+// n vengono inserite n chiavi intere casuali e misurate n ricerche di
+// chiavi presenti, con la politica NoStats (il default) e con
+// CountingStats. Con NoStats il codice e' lo stesso di un dizionario senza
+// statistiche; CountingStats aggiunge l'aggiornamento di due contatori per
+// operazione e la misura del tempo delle ristrutturazioni. Le misure
+// vengono ripetute nell'ordine NoStats, CountingStats, CountingStats,
+// NoStats e per ciascuna politica si tiene la minima, perche' il secondo
+// dizionario costruito riusa la memoria liberata dal primo e i suoi nodi
+// hanno una disposizione diversa. Tempi medi per operazione in nanosecondi.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Dictionary.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di ricerca
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, std::size_t ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+// misura inserimenti e ricerche con la politica Stats, aggiornando i
+// tempi minimi insertTime e findTime
+template <typename Stats>
+void run(const std::vector<int> &keys, const std::vector<int> &hits,
+    double &insertTime, double &findTime)
+{
+    Dictionary<int, int, Hash<int>, Stats> d;
+    double insert = timeOps([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            d.insert(keys[i], static_cast<int>(i));
+    }, keys.size());
+    double find = timeOps([&] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            sum += *d.find(hits[i]);
+        sink = sum;
+    }, hits.size());
+    insertTime = std::min(insertTime, insert);
+    findTime = std::min(findTime, find);
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK STATISTICHE **************\n\n";
+    cout << "tempo medio per operazione (ns/op)\n\n";
+    cout << std::setw(10) << "n" << std::setw(24) << "NoStats"
+         << std::setw(24) << "CountingStats" << "\n";
+    cout << std::setw(10) << "";
+    for (int i = 0; i < 2; ++i)
+        cout << std::setw(12) << "inserimento" << std::setw(12) << "ricerca";
+    cout << "\n";
+
+    std::mt19937 random(1);
+    for (std::size_t n = 1 << 12; n <= 1 << 22; n <<= 2) {
+        // chiavi distinte e sparse (vedi benchFlat.cpp)
+        std::vector<int> keys(n);
+        for (std::size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<int>(i * 2654435761u);
+        std::shuffle(keys.begin(), keys.end(), random);
+        std::vector<int> hits(keys);
+        std::shuffle(hits.begin(), hits.end(), random);
+
+        double times[4] = { 1e9, 1e9, 1e9, 1e9 };
+        run<NoStats>(keys, hits, times[0], times[1]);
+        run<CountingStats>(keys, hits, times[2], times[3]);
+        run<CountingStats>(keys, hits, times[2], times[3]);
+        run<NoStats>(keys, hits, times[0], times[1]);
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1);
+        for (int i = 0; i < 4; ++i)
+            cout << std::setw(12) << times[i];
+        cout << "\n";
+    }
+
+    return 0;
+}
@@ -1,9 +1,19 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <utility>
+#include <cstdio>
 #include "Dictionary.h"
+#include "MappedDictionary.h"
 using std::cout;
 using std::string;
 
+// funtore hash che usa solo la lunghezza della chiave: le chiavi della
+// stessa lunghezza finiscono nella stessa lista di trabocco
+struct LengthHash {
+    std::size_t operator()(const string &key) const { return key.length(); }
+};
+
 void checkKey(const string &key, const Dictionary<string, int> &dic);
 void printData(const string &key, const Dictionary<string, int> &dic);
 
@@ -102,6 +112,149 @@ int main()
     cout << "\ndopo l'assegnazione dictionary2 = myDictionary:\n\n"
          << dictionary2;
 
+    // visita di tutte le coppie senza copiare chiavi e valori
+    int total = 0;
+    myDictionary.forEach([&total](const string &, const int &value) {
+        total += value;
+    });
+    cout << "\nFUNZIONE forEach\nsomma dei valori di myDictionary: " << total
+         << "\n";
+
+    // ristrutturazione incrementale: ogni inserimento o rimozione sposta
+    // al massimo 2 liste di trabocco dal vecchio al nuovo vettore
+    Dictionary<int, int> incremental;
+    incremental.setRehashStep(2);
+    cout << "\nRISTRUTTURAZIONE INCREMENTALE (2 liste per operazione)\n";
+    int n = 0;
+    while (!incremental.isRehashing()) {
+        incremental.insert(n, n * n);
+        ++n;
+    }
+    cout << "ristrutturazione iniziata dopo " << n << " inserimenti, "
+         << "nuova capacita': " << incremental.getCapacity() << "\n";
+    int missing = 0;
+    for (int i = 0; i < n; ++i)
+        if (!incremental.belongs(i) || *incremental.find(i) != i * i)
+            ++missing;
+    cout << "chiavi non trovate durante la migrazione: " << missing << "\n";
+    int steps = 0;
+    while (incremental.isRehashing()) {
+        incremental.insert(n, n * n);
+        ++n;
+        ++steps;
+    }
+    cout << "migrazione completata dopo altri " << steps << " inserimenti, "
+         << "dim. dizionario: " << incremental.getSize() << "\n";
+
+    // ricerca eterogenea: Hash<string> accetta anche stringhe C-style, per
+    // cui find("Pippo") non costruisce una std::string temporanea
+    const char *name = "Pippo";
+    const int *found = myDictionary.find(name);
+    cout << "\nRICERCA ETEROGENEA\nfind(\"Pippo\") con const char *: "
+         << (found != 0 ? *found : -1) << "\n";
+
+    // valore hash precalcolato: la stessa chiave cercata in due dizionari
+    // con un solo calcolo del valore hash
+    std::size_t h = myDictionary.hashOf("Nonna Papera");
+    const int *first = myDictionary.findWithHash("Nonna Papera", h);
+    const int *second = dictionary2.findWithHash("Nonna Papera", h);
+    cout << "\nVALORE HASH PRECALCOLATO\nchiave \"Nonna Papera\" in "
+         << "myDictionary: " << (first != 0 ? *first : -1)
+         << ", in dictionary2: " << (second != 0 ? *second : -1) << "\n";
+    myDictionary.insertWithHash("Nonna Papera", 24, h);
+    cout << "dopo insertWithHash(\"Nonna Papera\", 24, h): "
+         << *myDictionary.findWithHash("Nonna Papera", h) << "\n";
+
+    // dizionario con un funtore hash diverso da quello di default
+    Dictionary<string, int, LengthHash> byLength;
+    byLength.insert("Pippo", 1);
+    byLength.insert("Pluto", 2);
+    byLength.insert("Qui", 3);
+    byLength.insert("Quo", 4);
+    cout << "\nFUNTORE HASH PERSONALIZZATO (lunghezza della chiave)\n"
+         << "inseriti Pippo, Pluto, Qui, Quo\nchiave \"Pluto\": "
+         << *byLength.find("Pluto") << "\nchiave \"Quo\": "
+         << *byLength.find("Quo") << "\nchiave \"Qua\": "
+         << (byLength.find("Qua") != 0 ? "presente" : "non presente") << "\n";
+
+    // costruzione da un intervallo di coppie e inserimento a blocchi: la
+    // tabella viene dimensionata una sola volta per tutte le coppie
+    std::vector<std::pair<string, int> > snapshot;
+    snapshot.push_back(std::make_pair("Qui", 10));
+    snapshot.push_back(std::make_pair("Quo", 11));
+    snapshot.push_back(std::make_pair("Qua", 12));
+    Dictionary<string, int> nephews(snapshot.begin(), snapshot.end());
+    cout << "\nCOSTRUZIONE DA UN INTERVALLO\nnephews:\n\n" << nephews;
+    std::vector<std::pair<int, int> > squares;
+    for (int i = 0; i < 1000; ++i)
+        squares.push_back(std::make_pair(i, i * i));
+    Dictionary<int, int> bulk;
+    bulk.insertBatch(squares.begin(), squares.end());
+    missing = 0;
+    for (int i = 0; i < 1000; ++i)
+        if (bulk.find(i) == 0 || *bulk.find(i) != i * i)
+            ++missing;
+    cout << "\nINSERIMENTO A BLOCCHI\ninserite 1000 coppie, dim. dizionario: "
+         << bulk.getSize() << ", capacita': " << bulk.getCapacity()
+         << ", chiavi non trovate: " << missing << "\n";
+
+    // ricerca di un gruppo di chiavi: le liste di trabocco delle chiavi
+    // successive vengono caricate in anticipo
+    const string group[] = { "Pippo", "Pluto", "Ascilto", "Nonna Papera" };
+    const int *results[4];
+    std::size_t hits = myDictionary.findBatch(group, 4, results);
+    cout << "\nRICERCA DI UN GRUPPO DI CHIAVI\n";
+    for (int i = 0; i < 4; ++i) {
+        cout << "chiave \"" << group[i] << "\": ";
+        results[i] != 0 ? cout << *results[i] << "\n" : cout << "assente\n";
+    }
+    cout << "chiavi trovate: " << hits << "\n";
+
+    // snapshot: save scrive il dizionario in un file, che MappedDictionary
+    // mappa in memoria e interroga senza ricostruire la tabella
+    cout << "\nSNAPSHOT SU FILE\n";
+    if (myDictionary.save("dictionary.snapshot")) {
+        MappedDictionary<string, int> mapped =
+            openMapped<string, int>("dictionary.snapshot");
+        int value = 0;
+        cout << "dizionario mappato (" << mapped.getSize() << " elementi):\n"
+             << mapped << "chiave \"Pluto\": "
+             << (mapped.find("Pluto", value) ? value : -1)
+             << "\nchiave \"Anacleto\": "
+             << (mapped.belongs("Anacleto") ? "presente" : "non presente")
+             << "\n";
+        std::remove("dictionary.snapshot");
+    }
+
+    // statistiche: con la politica CountingStats il dizionario conta
+    // ricerche, inserimenti, chiavi confrontate e ristrutturazioni
+    Dictionary<int, int, Hash<int>, CountingStats> counted;
+    for (int i = 0; i < 100; ++i)
+        counted.insert(i, i);
+    for (int i = 0; i < 200; ++i)
+        counted.find(i);
+    cout << "\nSTATISTICHE (100 inserimenti, 200 ricerche)\n"
+         << counted.stats();
+
+    // filtro di Bloom: le ricerche di chiavi assenti vengono quasi sempre
+    // respinte dal filtro senza scandire le liste di trabocco
+    Dictionary<int, int, Hash<int>, NoStats, BloomFilter> filtered;
+    for (int i = 0; i < 1000; ++i)
+        filtered.insert(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        filtered.remove(i);
+    missing = 0;
+    int present = 0;
+    for (int i = 0; i < 2000; ++i) {
+        if (filtered.belongs(i))
+            ++present;
+        else if (i < 1000 && i % 2 == 1)
+            ++missing;
+    }
+    cout << "\nFILTRO DI BLOOM (1000 inserimenti, 500 rimozioni)\n"
+         << "chiavi presenti: " << present << ", chiavi dispari non trovate: "
+         << missing << "\n";
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
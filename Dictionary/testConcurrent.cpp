@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentDictionary.h"
+using std::cout;
+using std::string;
+
+int main()
+{
+    ConcurrentDictionary<string, int> dictionary(4);
+
+    cout << "\n************** TEST CLASSE ConcurrentDictionary **************\n\n";
+    cout << "Dizionario con " << dictionary.getShards() << " shard, dim.: "
+         << dictionary.getSize() << "\n";
+
+    // operazioni da un solo thread
+    cout << "\nINSERIMENTO ELEMENTI\n";
+    dictionary.insert("Pippo", 45);
+    dictionary.insert("Pluto", 38);
+    dictionary.insert("Anacleto", 92);
+    dictionary.insert("Pippo", 71);
+    cout << "inseriti Pippo(45), Pluto(38), Anacleto(92), poi Pippo(71)\n"
+         << "Dim. dizionario: " << dictionary.getSize() << "\n" << dictionary;
+
+    int value = 0;
+    cout << "\nFUNZIONE find\nfind(\"Pippo\"): ";
+    dictionary.find("Pippo", value) ? cout << value << "\n"
+        : cout << "non presente\n";
+    cout << "find(\"Eumolpo\"): ";
+    dictionary.find("Eumolpo", value) ? cout << value << "\n"
+        : cout << "non presente\n";
+    cout << "belongs(\"Pluto\"): "
+         << (dictionary.belongs("Pluto") ? "true" : "false") << "\n";
+
+    cout << "\nRIMOZIONE ELEMENTI\nremove(\"Pluto\"): "
+         << (dictionary.remove("Pluto") ? "true" : "false")
+         << "\nremove(\"Paperino\") (non presente): "
+         << (dictionary.remove("Paperino") ? "true" : "false") << "\n"
+         << dictionary;
+
+    // piu' thread inseriscono chiavi distinte, poi ne rimuovono la meta'
+    // mentre altri thread le cercano
+    const int threadCount = 4, count = 20000;
+    ConcurrentDictionary<int, int> numbers;
+    numbers.setRehashStep(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+        threads.push_back(std::thread([&numbers, t, count]() {
+            for (int i = t * count; i < (t + 1) * count; ++i)
+                numbers.insert(i, 2 * i);
+        }));
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    cout << "\nPIU' THREAD\n" << threadCount << " thread hanno inserito "
+         << count << " chiavi ciascuno, dim. dizionario: "
+         << numbers.getSize() << "\n";
+
+    threads.clear();
+    std::vector<int> wrong(threadCount, 0);
+    for (int t = 0; t < threadCount; ++t) {
+        // i thread pari rimuovono le chiavi dispari del proprio intervallo
+        // e quelli dispari cercano le chiavi pari
+        threads.push_back(std::thread([&numbers, &wrong, t, count]() {
+            int found;
+            for (int i = t * count; i < (t + 1) * count; ++i) {
+                if (t % 2 == 0 && i % 2 != 0 && !numbers.remove(i))
+                    ++wrong[t];
+                if (t % 2 != 0 && i % 2 == 0
+                        && (!numbers.find(i, found) || found != 2 * i))
+                    ++wrong[t];
+                if (i % 1024 == 0)
+                    std::this_thread::yield(); // alterna i thread
+            }
+        }));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    int errors = 0;
+    for (int t = 0; t < threadCount; ++t)
+        errors += wrong[t];
+    long long sum = 0;
+    numbers.forEach([&sum](const int &, const int &v) { sum += v; });
+    cout << "rimozioni e ricerche concorrenti, errori: " << errors
+         << "\ndim. dizionario: " << numbers.getSize()
+         << ", somma dei valori: " << sum << "\n";
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+#include "DictionaryFor.h"
+using std::cout;
+using std::string;
+
+// esegue le stesse operazioni su un dizionario con l'organizzazione
+// indicata dalla politica Layout (Chaining o OpenAddressing)
+template <typename Layout>
+void testLayout(const string &name)
+{
+    typedef typename DictionaryFor<string, int, Layout>::type StringDictionary;
+    StringDictionary dictionary;
+
+    cout << "\n--- DictionaryFor<string, int, " << name << "> ---\n";
+    dictionary.insert("Pippo", 45);
+    dictionary.insert("Pluto", 38);
+    dictionary.insert("Anacleto", 92);
+    dictionary.insert("Pippo", 71);
+    cout << "inseriti Pippo(45), Pluto(38), Anacleto(92), poi Pippo(71)\n"
+         << "Dim. dizionario: " << dictionary.getSize() << "\n";
+
+    const int *value = dictionary.find("Pippo");
+    cout << "find(\"Pippo\"): " << (value != 0 ? std::to_string(*value)
+        : string("non presente")) << "\nbelongs(\"Eumolpo\"): "
+         << (dictionary.belongs("Eumolpo") ? "true" : "false")
+         << "\ncontainsValue(38): "
+         << (dictionary.containsValue(38) ? "true" : "false") << "\n";
+
+    // valore hash precalcolato e ricerca con const char *
+    std::size_t h = dictionary.hashOf("Anacleto");
+    dictionary.insertWithHash("Eumolpo", 17, dictionary.hashOf("Eumolpo"));
+    cout << "findWithHash(\"Anacleto\", hashOf(\"Anacleto\")): "
+         << *dictionary.findWithHash("Anacleto", h)
+         << "\ninsertWithHash(\"Eumolpo\", 17), belongs(\"Eumolpo\"): "
+         << (dictionary.belongs("Eumolpo") ? "true" : "false") << "\n";
+
+    dictionary.remove("Pluto");
+    cout << "rimosso Pluto, tentativo di rimuovere Paperino:\n";
+    dictionary.remove("Paperino");
+
+    StringDictionary copy(dictionary);
+    cout << "copia del dizionario:\n" << copy;
+}
+
+int main()
+{
+    cout << "\n************** TEST CLASSE FlatDictionary **************\n";
+
+    // stessa interfaccia, organizzazione scelta dalla politica
+    testLayout<Chaining>("Chaining");
+    testLayout<OpenAddressing>("OpenAddressing");
+
+    // crescita e contrazione della tabella
+    FlatDictionary<int, int> numbers;
+    cout << "\nCRESCITA DELLA TABELLA\ncelle iniziali: "
+         << numbers.getCapacity() << "\n";
+    for (int i = 0; i < 1000; ++i)
+        numbers.insert(i, i * i);
+    cout << "dopo 1000 inserimenti: " << numbers.getSize() << " coppie in "
+         << numbers.getCapacity() << " celle (al massimo 7/8 occupate)\n";
+    for (int i = 0; i < 950; ++i)
+        numbers.remove(i);
+    cout << "dopo 950 rimozioni: " << numbers.getSize() << " coppie in "
+         << numbers.getCapacity() << " celle\n";
+    cout << "find(999): " << *numbers.find(999) << ", find(10): "
+         << (numbers.find(10) != 0 ? "presente" : "non presente") << "\n";
+
+    // visita di tutte le coppie
+    long long sum = 0;
+    numbers.forEach([&sum](const int &, const int &square) { sum += square; });
+    cout << "\nFUNZIONE forEach\nsomma dei quadrati rimasti: " << sum << "\n";
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+
+    return 0;
+}
\ No newline at end of file
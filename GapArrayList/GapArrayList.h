@@ -0,0 +1,504 @@
+// By Fabio Nardelli
+// lista implementata mediante vettore dinamico con "buco" (gap buffer).
+// Gli elementi occupano le due estremita' del vettore, separate da un
+// intervallo di celle libere (il buco) che viene mantenuto nel punto
+// dell'ultima modifica: le posizioni [0, gapStart) e [gapEnd, capacity)
+// contengono gli elementi, le celle [gapStart, gapEnd) sono libere.
+// Inserire o rimuovere un elemento nel punto in cui si trova il buco costa
+// O(1); spostare il buco costa quanto il numero di elementi fra la vecchia e
+// la nuova posizione, per cui una serie di modifiche vicine fra loro costa
+// O(1) ammortizzato per modifica, invece di O(n) come in ArrayList.
+// L'interfaccia e' quella di ArrayList: le posizioni sono indici logici
+// (0 = primo elemento), indipendenti dalla posizione del buco.
+// Come in ArrayList, il vettore e' memoria non inizializzata e crescita e
+// contrazione seguono la politica Growth (vedi Utils/GrowthPolicy.h).
+
+#ifndef GAP_ARRAY_LIST_H
+#define GAP_ARRAY_LIST_H
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <new>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "../Utils/GrowthPolicy.h"
+
+template <typename T, typename Growth = DefaultGrowth>
+class GapArrayList;
+
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &, const GapArrayList<T, Growth> &);
+
+template <typename T, typename Growth>
+class GapArrayList {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const GapArrayList<T, Growth> &);
+public:
+    typedef int Position;
+
+    // costruttore di default
+    GapArrayList(int c = defaultCapacity);
+    GapArrayList(const GapArrayList<T, Growth> &); // costruttore per copia
+    GapArrayList(GapArrayList<T, Growth> &&); // costruttore di spostamento
+    ~GapArrayList(); // distruttore
+    GapArrayList<T, Growth> &operator=(const GapArrayList<T, Growth> &);
+    GapArrayList<T, Growth> &operator=(GapArrayList<T, Growth> &&);
+
+    // operatori
+    // restituisce true se la lista e' vuota, false altrimenti
+    bool isEmpty() const { return size == 0; }
+    // restituisce il numero di elementi contenuti nella lista
+    int getSize() const { return size; }
+    void print() const; // stampa la lista
+    // inserisce un elemento in coda
+    void pushBack(const T &item) { emplaceAt(size, item); }
+    void pushBack(T &&item) { emplaceAt(size, std::move(item)); }
+    // inserisce un elemento in testa
+    void pushFront(const T &item) { emplaceAt(0, item); }
+    void pushFront(T &&item) { emplaceAt(0, std::move(item)); }
+    // inserisce un elemento nella posizione precedente quella indicata
+    void insert(Position, const T &);
+    void insert(Position, T &&);
+    void popBack(); // rimuove l'elemento in coda
+    void popFront(); // rimuove l'elemento in testa
+    // rimuove l'elemento nella posizione indicata
+    void remove(Position);
+    // restituisce la posizione dell'elemento successivo
+    Position next(Position) const;
+    // restituisce la posizione dell'elemento precedente
+    Position previous(Position) const;
+    // cerca la posizione di un elemento
+    Position search(const T &) const;
+    // restituisce la posizione del primo elemento
+    Position begin() const { return 0; }
+    // restituisce la posizione dell'ultimo elemento
+    Position end() const { return (size != 0 ? size - 1 : 0); }
+    // restituisce "true" se la posizione indicata si riferisce
+    // alla fine della lista, "false" altrimenti
+    bool finished(Position pos) const { return pos == size || pos == -1; }
+    const T &read(Position) const; // legge l'elemento nella posizione indicata
+    void write(Position, const T &); // scrive nell'elemento indicato
+    // restituisce la posizione del buco, cioe' la posizione in cui un
+    // inserimento non richiede di spostare elementi
+    Position cursor() const { return gapStart; }
+    // operatore di uguaglianza ==
+    bool operator==(const GapArrayList<T, Growth> &) const;
+
+private:
+    T *array; // vettore che contiene gli elementi e il buco
+    int size; // numero di elementi contenuti nella lista
+    int capacity; // dimensione del vettore
+    int gapStart; // prima cella libera
+    int gapEnd; // prima cella occupata dopo il buco
+
+    static const int defaultCapacity = 16;
+
+    // allocano e deallocano memoria non inizializzata per n elementi
+    static T *allocate(int n)
+        { return static_cast<T *>(::operator new(n * sizeof(T))); }
+    static void deallocate(T *p) { ::operator delete(p); }
+    // sposta n elementi da src a dest (anche sovrapposti): gli elementi
+    // vengono costruiti in dest e distrutti in src
+    static void relocate(T *src, int n, T *dest, std::true_type);
+    static void relocate(T *src, int n, T *dest, std::false_type);
+    static void relocate(T *src, int n, T *dest)
+        { relocate(src, n, dest, std::is_trivially_copyable<T>()); }
+
+    // converte una posizione logica nell'indice della cella del vettore
+    int physical(Position pos) const
+        { return pos < gapStart ? pos : pos + (gapEnd - gapStart); }
+    // sposta il buco in modo che inizi alla posizione logica pos
+    void moveGap(Position pos);
+    // alloca un vettore di dimensione newCapacity e vi sposta gli
+    // elementi, lasciando il buco nella posizione attuale
+    void reallocate(int newCapacity);
+    // distrugge tutti gli elementi e libera il vettore
+    void clear();
+    // costruisce un elemento nella posizione logica indicata
+    template <typename... Args>
+    void emplaceAt(Position, Args &&...);
+    // rimuove l'elemento nella posizione logica indicata
+    void erase(Position);
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &output, const GapArrayList<T, Growth> &l)
+{
+    l.print();
+    return output; // consente cout << a << b << c
+}
+
+// costruttore di default: il buco occupa l'intero vettore
+template <typename T, typename Growth>
+GapArrayList<T, Growth>::GapArrayList(int c)
+    : size(0), capacity(c > 0 ? c : defaultCapacity), gapStart(0)
+{
+    array = allocate(capacity);
+    gapEnd = capacity;
+}
+
+// spostamento per i tipi banalmente copiabili: una sola memmove
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::relocate(T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memmove(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// spostamento per i tipi generici, elemento per elemento. Il verso della
+// copia dipende da quello dello spostamento, in modo da non sovrascrivere
+// elementi non ancora spostati quando i due intervalli si sovrappongono
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::relocate(T *src, int n, T *dest, std::false_type)
+{
+    if (dest < src) {
+        for (int i = 0; i < n; ++i) {
+            new (dest + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    } else {
+        for (int i = n - 1; i >= 0; --i) {
+            new (dest + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+// costruttore per copia: nella copia il buco si trova in fondo al vettore
+template <typename T, typename Growth>
+GapArrayList<T, Growth>::GapArrayList(const GapArrayList<T, Growth> &l)
+    : size(0), capacity(l.capacity), gapStart(0), gapEnd(l.capacity)
+{
+    array = allocate(capacity);
+    try {
+        for (int i = 0; i < l.size; ++i) {
+            new (array + i) T(l.read(i));
+            ++gapStart;
+            ++size;
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// costruttore di spostamento: si appropria del vettore di l, che resta vuota
+template <typename T, typename Growth>
+GapArrayList<T, Growth>::GapArrayList(GapArrayList<T, Growth> &&l)
+    : array(l.array), size(l.size), capacity(l.capacity),
+      gapStart(l.gapStart), gapEnd(l.gapEnd)
+{
+    l.array = 0;
+    l.size = l.capacity = l.gapStart = l.gapEnd = 0;
+}
+
+// distrugge tutti gli elementi e libera il vettore
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::clear()
+{
+    for (int i = 0; i < gapStart; ++i)
+        array[i].~T();
+    for (int i = gapEnd; i < capacity; ++i)
+        array[i].~T();
+    deallocate(array);
+    array = 0;
+    size = capacity = gapStart = gapEnd = 0;
+}
+
+// distruttore
+template <typename T, typename Growth>
+GapArrayList<T, Growth>::~GapArrayList()
+{
+    clear();
+}
+
+// overload dell'operatore di assegnazione =
+template <typename T, typename Growth>
+GapArrayList<T, Growth> &GapArrayList<T, Growth>::operator=(
+    const GapArrayList<T, Growth> &l)
+{
+    if (&l != this) { // evita l'autoassegnazione
+        // costruisce prima la copia, in modo che un'eccezione
+        // lasci invariata questa lista
+        GapArrayList<T, Growth> temp(l);
+        *this = std::move(temp);
+    }
+
+    return *this; // consente (a = b = c)
+}
+
+// overload dell'operatore di assegnazione = per spostamento
+template <typename T, typename Growth>
+GapArrayList<T, Growth> &GapArrayList<T, Growth>::operator=(
+    GapArrayList<T, Growth> &&l)
+{
+    if (&l != this) { // evita l'autoassegnazione
+        std::swap(array, l.array);
+        std::swap(size, l.size);
+        std::swap(capacity, l.capacity);
+        std::swap(gapStart, l.gapStart);
+        std::swap(gapEnd, l.gapEnd);
+    }
+
+    return *this; // consente (a = b = c)
+}
+
+// stampa la lista
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::print() const
+{
+    if (isEmpty()) {
+        std::cout << "\n List is empty!\n";
+        return;
+    }
+    std::cout << "\n [";
+
+    for (int i = 0; i < size; ++i) {
+        std::cout << std::setw(3) << array[physical(i)] << " ";
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if ((i + 1) % 5 == 0 && i != size - 1)
+            std::cout << "\n ";
+    }
+    std::cout << " ]\n";
+}
+
+// sposta il buco alla posizione logica pos. Se pos precede il buco, gli
+// elementi [pos, gapStart) vengono spostati alla fine del buco, altrimenti
+// gli elementi che seguono il buco vengono spostati al suo inizio
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::moveGap(Position pos)
+{
+    // se il buco e' vuoto non c'e' nulla da spostare
+    if (gapStart == gapEnd)
+        gapStart = gapEnd = pos;
+    else if (pos < gapStart) {
+        int n = gapStart - pos;
+        relocate(array + pos, n, array + gapEnd - n);
+        gapStart -= n;
+        gapEnd -= n;
+    } else if (pos > gapStart) {
+        int n = pos - gapStart;
+        relocate(array + gapEnd, n, array + gapStart);
+        gapStart += n;
+        gapEnd += n;
+    }
+}
+
+// alloca un vettore di dimensione newCapacity (>= size) e vi sposta gli
+// elementi. Il buco resta nella stessa posizione logica
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::reallocate(int newCapacity)
+{
+    T *temp = allocate(newCapacity);
+    int tail = capacity - gapEnd; // elementi dopo il buco
+    relocate(array, gapStart, temp);
+    relocate(array + gapEnd, tail, temp + newCapacity - tail);
+    deallocate(array);
+    array = temp;
+    capacity = newCapacity;
+    gapEnd = newCapacity - tail;
+}
+
+// costruisce un elemento nella posizione logica pos, dopo avervi spostato
+// il buco. Se il buco e' vuoto, il vettore viene prima fatto crescere
+template <typename T, typename Growth>
+template <typename... Args>
+void GapArrayList<T, Growth>::emplaceAt(Position pos, Args &&... args)
+{
+    // costruisce prima il nuovo elemento, perche' gli argomenti
+    // potrebbero riferirsi a un elemento della lista stessa
+    T item(std::forward<Args>(args)...);
+
+    if (gapStart == gapEnd)
+        reallocate(Growth::grow(capacity));
+    moveGap(pos);
+    new (array + gapStart) T(std::move(item));
+    ++gapStart;
+    ++size;
+}
+
+// rimuove l'elemento nella posizione logica pos, inglobandolo nel buco.
+// Il buco viene spostato dalla parte che richiede meno spostamenti
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::erase(Position pos)
+{
+    if (pos < gapStart) { // l'elemento diventa l'ultimo prima del buco
+        moveGap(pos + 1);
+        --gapStart;
+        array[gapStart].~T();
+    } else { // l'elemento diventa il primo dopo il buco
+        moveGap(pos);
+        array[gapEnd].~T();
+        ++gapEnd;
+    }
+    --size;
+
+    // se il fattore di carico scende alla soglia prevista dalla politica
+    // Growth, contrae il vettore
+    if (Growth::shouldShrink(size, capacity, defaultCapacity))
+        reallocate(Growth::shrink(capacity, defaultCapacity));
+}
+
+// inserisce un elemento nella posizione indicata. Gli elementi successivi
+// vengono spostati in avanti di un posto
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::insert(Position pos, const T &item)
+{
+    if (((pos < 0 || pos >= size) && size > 0)
+        || (pos < 0 && size == 0)) {
+        std::cerr << "Cannot insert: Position must be 0 - (size - 1)\n";
+        return;
+    }
+
+    // se la lista e' vuota inserisce in prima posizione
+    emplaceAt(size > 0 ? pos : 0, item);
+}
+
+// come sopra, ma sposta l'elemento indicato invece di copiarlo
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::insert(Position pos, T &&item)
+{
+    if (((pos < 0 || pos >= size) && size > 0)
+        || (pos < 0 && size == 0)) {
+        std::cerr << "Cannot insert: Position must be 0 - (size - 1)\n";
+        return;
+    }
+
+    // se la lista e' vuota inserisce in prima posizione
+    emplaceAt(size > 0 ? pos : 0, std::move(item));
+}
+
+// rimuove l'elemento in coda
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::popBack()
+{
+    if (isEmpty()) {
+        std::cerr << "Cannot remove: List is empty!";
+        return;
+    }
+
+    erase(size - 1);
+}
+
+// rimuove l'elemento in testa
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::popFront()
+{
+    if (isEmpty()) {
+        std::cerr << "Cannot pop: List is empty!";
+        return;
+    }
+
+    erase(0);
+}
+
+// rimuove l'elemento alla posizione indicata
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::remove(Position pos)
+{
+    if (isEmpty()) {
+        std::cerr << "Cannot remove: List is empty!";
+        return;
+    }
+    if (pos < 0 || pos >= size) {
+        std::cerr << "Cannot remove: Position must be 0 - (size - 1)\n";
+        return;
+    }
+
+    erase(pos);
+}
+
+// restituisce la posizione dell'elemento successivo
+// (vedi ArrayList::next per il comportamento ai limiti)
+template <typename T, typename Growth>
+typename GapArrayList<T, Growth>::Position
+    GapArrayList<T, Growth>::next(Position pos) const
+{
+    if (pos >= 0 && pos < size)
+        return ++pos;
+    else
+        return pos;
+}
+
+// restituisce la posizione dell'elemento precedente
+// (vedi ArrayList::previous per il comportamento ai limiti)
+template <typename T, typename Growth>
+typename GapArrayList<T, Growth>::Position
+    GapArrayList<T, Growth>::previous(Position pos) const
+{
+    if (pos >= 0 && pos < size)
+        return --pos;
+    else
+        return pos;
+}
+
+// cerca la prima occorrenza di un dato. Se lo trova,
+// restituisce la posizione dell'elemento corrispondente,
+// altrimenti restituisce -1
+template <typename T, typename Growth>
+typename GapArrayList<T, Growth>::Position
+    GapArrayList<T, Growth>::search(const T &item) const
+{
+    // scandisce separatamente le due parti del vettore
+    for (int i = 0; i < gapStart; ++i)
+        if (array[i] == item)
+            return i;
+    for (int i = gapEnd; i < capacity; ++i)
+        if (array[i] == item)
+            return i - (gapEnd - gapStart);
+    return -1;
+}
+
+// legge il dato contenuto nell'elemento indicato
+template <typename T, typename Growth>
+const T &GapArrayList<T, Growth>::read(Position pos) const
+{
+    if (isEmpty())
+        throw std::domain_error("List is empty!");
+
+    if (pos < 0 || pos >= size)
+        throw std::out_of_range("Invalid position! "
+            "Position must be 0 - (size - 1)");
+
+    return array[physical(pos)];
+}
+
+// scrive nell'elemento indicato
+template <typename T, typename Growth>
+void GapArrayList<T, Growth>::write(Position pos, const T &item)
+{
+    if (pos < 0 || pos >= size) {
+        std::cerr << "Invalid position! "
+            << "Position must be 0 - (size - 1)";
+        return;
+    }
+
+    array[physical(pos)] = item;
+}
+
+// overload dell'operatore di uguaglianza ==
+template <typename T, typename Growth>
+bool GapArrayList<T, Growth>::operator==(
+    const GapArrayList<T, Growth> &l) const
+{
+    // se le liste hanno dimensioni diversa, allora sono diverse
+    if (size != l.size)
+        return false;
+
+    // controllo esaustivo su ciascun elemento (i buchi delle due liste
+    // possono trovarsi in posizioni diverse)
+    for (int i = 0; i < size; ++i)
+        if (array[physical(i)] != l.array[l.physical(i)])
+            return false;
+
+    return true; // se l'esecuzione arriva qui, le due liste sono uguali
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <string>
+#include "GapArrayList.h"
+using std::cout;
+using std::string;
+
+int main()
+{
+    GapArrayList<int> list;
+
+    cout << "\n************** TEST CLASSE GapArrayList **************\n\n";
+
+    // stampa una lista vuota
+    cout << "Crea e tenta di stampare una lista vuota:\n";
+    list.print();
+
+    // inserisce elementi con insert, pushFront e pushBack
+    list.insert(list.begin(), 1);
+    list.insert(list.end(), 2);
+    list.pushFront(3);
+    list.pushBack(4);
+    cout << "\nFUNZIONI insert, pushFront E pushBack:\ninserisce 1 (lista "
+         << "vuota), 2 (prima dell'ultimo), 3 (in testa) e 4 (in coda)\n"
+         << list;
+
+    // inserimenti consecutivi nella stessa zona: il buco resta
+    // nel punto di inserimento e non vengono spostati elementi
+    GapArrayList<int>::Position pos = 2;
+    for (int i = 10; i < 20; ++i)
+        list.insert(pos++, i);
+    cout << "\nINSERIMENTI VICINI AL CURSORE:\ninseriti 10..19 a partire "
+         << "dalla posizione 2\n" << list
+         << "posizione del buco (cursor): " << list.cursor() << "\n";
+
+    // rimozioni consecutive all'indietro, come il tasto backspace
+    for (int i = 0; i < 5; ++i)
+        list.remove(--pos);
+    cout << "\nRIMOZIONI VICINE AL CURSORE:\nrimossi 5 elementi prima "
+         << "della posizione " << pos + 5 << "\n" << list
+         << "posizione del buco (cursor): " << list.cursor() << "\n";
+
+    // lettura e scrittura
+    list.write(list.begin(), 100);
+    cout << "\nFUNZIONI read E write:\nscrive 100 in testa\n"
+         << "read(begin()): " << list.read(list.begin())
+         << "\nread(end()): " << list.read(list.end()) << "\n";
+
+    // ricerca
+    cout << "\nFUNZIONE search:\nsearch(12): " << list.search(12)
+         << "\nsearch(4): " << list.search(4)
+         << "\nsearch(99): " << list.search(99) << "\n";
+
+    // scorrimento con next e finished
+    cout << "\nFUNZIONI next E finished:\n";
+    for (pos = list.begin(); !list.finished(pos); pos = list.next(pos))
+        cout << list.read(pos) << " ";
+    cout << "\n";
+
+    // copia e uguaglianza: i buchi possono trovarsi in posizioni diverse
+    GapArrayList<int> list2(list);
+    list2.pushFront(0);
+    list2.popFront();
+    cout << "\nCOSTRUTTORE PER COPIA E OPERATORE ==\nlist2 (copia di list, "
+         << "buco in testa):" << list2 << "list == list2: "
+         << (list == list2 ? "true" : "false") << "\n";
+
+    // rimozioni in testa e in coda
+    list.popFront();
+    list.popBack();
+    cout << "\nFUNZIONI popFront E popBack:\n" << list;
+
+    // lista di stringhe: gli elementi vengono spostati, non copiati
+    GapArrayList<string> words;
+    words.pushBack("gap");
+    words.pushBack("buffer");
+    words.insert(1, string("array"));
+    words.pushFront("una");
+    cout << "\nGapArrayList<string>:\n" << words;
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+}
\ No newline at end of file
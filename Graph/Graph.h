@@ -131,6 +131,9 @@ private:
         W weight; // peso dell'arco entrante nel nodo adiacente
     };
 
+    typedef typename LinkedList<Adjacent>::iterator AdjIterator;
+    typedef typename LinkedList<Adjacent>::const_iterator AdjConstIterator;
+
     // rappresenta un elemento del vettore
     struct NodeElement {
         Node<L> *node; // puntatore a un nodo del grafo
@@ -207,8 +210,9 @@ Graph<L, W> &Graph<L, W>::operator=(const Graph<L, W> &g)
 }
 
 // utility function per modificare le dimensioni del vettore. Alloca un
-// nuovo vettore di dimensioni newCapacity e copia il contenuto del vecchio
-// vettore nel nuovo, dopodiche' cancella il vecchio vettore.
+// nuovo vettore di dimensioni newCapacity e vi sposta il contenuto del
+// vecchio vettore (le liste di adiacenza vengono ricollegate, non copiate),
+// dopodiche' cancella il vecchio vettore.
 template <typename L, typename W>
 void Graph<L, W>::resize(int newCapacity)
 {
@@ -226,7 +230,9 @@ void Graph<L, W>::resize(int newCapacity)
         while (nodes[j].node == 0 && j < size) { ++j; }
 
         if (j < size) {
-            temp[i] = nodes[j];
+            // sposta la lista di adiacenza senza copiarla
+            temp[i].node = nodes[j].node;
+            temp[i].adjList.append(nodes[j].adjList);
             // aggiorna l'id del nodo, in modo che coincida
             // con la nuova posizione nel vettore
             temp[i].node->id = i;
@@ -289,14 +295,10 @@ bool Graph<L, W>::hasEdge(const Node<L> &n1, const Node<L> &n2) const
 
     // scandisce la lista di adiacenza alla ricerca del nodo n2
     // se lo trova, restituisce true...
-    typename LinkedList<Adjacent>::Position pos =
-        nodes[n1.id].adjList.begin();
-
-    while (!nodes[n1.id].adjList.finished(pos)) {
-        if (nodes[n1.id].adjList.read(pos).adjNode->id == n2.id)
+    const LinkedList<Adjacent> &adj = nodes[n1.id].adjList;
+    for (AdjConstIterator it = adj.ibegin(); it != adj.iend(); ++it)
+        if (it->adjNode->id == n2.id)
             return true;
-        pos = nodes[n1.id].adjList.next(pos);
-    }
 
     return false; // ...altrimenti false
 }
@@ -385,13 +387,9 @@ typename Graph<L, W>::NodeList Graph<L, W>::neighbors(const Node<L> &n) const
 
     // altrimenti, restituisce list dopo avervi inserito
     // i nodi presenti nella lista di adiacenza di n
-    typename LinkedList<Adjacent>::Position pos =
-        nodes[n.id].adjList.begin();
-
-    while (!nodes[n.id].adjList.finished(pos)) {
-        list.pushBack(nodes[n.id].adjList.read(pos).adjNode);
-        pos = nodes[n.id].adjList.next(pos);
-    }
+    const LinkedList<Adjacent> &adj = nodes[n.id].adjList;
+    for (AdjConstIterator it = adj.ibegin(); it != adj.iend(); ++it)
+        list.pushBack(it->adjNode);
 
     return list;
 }
@@ -448,16 +446,12 @@ W Graph<L, W>::readEdge(const Node<L> &n1, const Node<L> &n2) const
         throw std::domain_error("One or both nodes not found!\n");
 
     // cerca nella lista di adiacenza di n1 il nodo n2
-    typename LinkedList<Adjacent>::Position pos =
-        nodes[n1.id].adjList.begin();
-
-    while (!nodes[n1.id].adjList.finished(pos)) {
+    const LinkedList<Adjacent> &adj = nodes[n1.id].adjList;
+    for (AdjConstIterator it = adj.ibegin(); it != adj.iend(); ++it) {
 
         // se lo trova, restituisce il peso
-        if (nodes[n1.id].adjList.read(pos).adjNode->id == n2.id)
-            return nodes[n1.id].adjList.read(pos).weight;
-
-        pos = nodes[n1.id].adjList.next(pos);
+        if (it->adjNode->id == n2.id)
+            return it->weight;
     }
 
     // se l'arco non esiste
@@ -475,21 +469,14 @@ void Graph<L, W>::writeEdge(Node<L> &n1, Node<L> &n2, W w)
     }
 
     // cerca nella lista di adiacenza di n1 il nodo n2
-    typename LinkedList<Adjacent>::Position pos =
-        nodes[n1.id].adjList.begin();
-
-    while (!nodes[n1.id].adjList.finished(pos)) {
+    LinkedList<Adjacent> &adj = nodes[n1.id].adjList;
+    for (AdjIterator it = adj.ibegin(); it != adj.iend(); ++it) {
 
         // se lo trova, scrive un peso nell'arco e termina
-        if (nodes[n1.id].adjList.read(pos).adjNode->id == n2.id) {
-            Adjacent t;
-            t.adjNode = nodes[n1.id].adjList.read(pos).adjNode;
-            t.weight = w;
-            nodes[n1.id].adjList.write(pos, t);
+        if (it->adjNode->id == n2.id) {
+            it->weight = w;
             return;
         }
-
-        pos = nodes[n1.id].adjList.next(pos);
     }
 }
 
@@ -0,0 +1,299 @@
+// By Fabio Nardelli
+// lista doppiamente concatenata intrusiva con sentinella. La lista non
+// alloca nodi e non contiene copie degli elementi: i collegamenti si trovano
+// in un membro di tipo ListHook degli oggetti stessi, indicato come
+// parametro template:
+//   struct Task {
+//       int id;
+//       ListHook byPriority; // collegamenti per una prima lista
+//       ListHook byOwner;    // collegamenti per una seconda lista
+//   };
+//   IntrusiveList<Task, &Task::byPriority> queue;
+// Un oggetto puo' appartenere contemporaneamente a tante liste quanti sono
+// i suoi membri ListHook, e puo' essere tolto dalla sua lista in tempo
+// costante conoscendo solo l'oggetto. La lista non possiede gli oggetti:
+// chi li crea deve mantenerli in vita finche' sono nella lista; il
+// distruttore di ListHook toglie comunque l'oggetto dalla lista.
+// Per questo la lista non memorizza il numero di elementi (un oggetto puo'
+// uscire dalla lista senza passare per essa) e getSize() costa O(n).
+
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include "../Utils/Range.h"
+
+// collegamenti di un oggetto a una lista intrusiva. La copia di un oggetto
+// non copia i collegamenti: la copia non appartiene a nessuna lista
+class ListHook {
+    template <typename T, ListHook T::*Hook> friend class IntrusiveList;
+public:
+    ListHook() : next(0), previous(0) { }
+    ListHook(const ListHook &) : next(0), previous(0) { }
+    ListHook &operator=(const ListHook &) { return *this; }
+    ~ListHook() { unlink(); }
+
+    // restituisce "true" se l'oggetto appartiene a una lista
+    bool isLinked() const { return next != 0; }
+    // toglie l'oggetto dalla lista a cui appartiene, se ce n'e' una
+    void unlink()
+    {
+        if (next != 0) {
+            previous->next = next;
+            next->previous = previous;
+            next = previous = 0;
+        }
+    }
+private:
+    ListHook *next; // collegamento successivo (0 = fuori da ogni lista)
+    ListHook *previous; // collegamento precedente
+};
+
+template <typename T, ListHook T::*Hook>
+class IntrusiveList;
+
+template <typename T, ListHook T::*Hook>
+std::ostream &operator<<(std::ostream &, const IntrusiveList<T, Hook> &);
+
+template <typename T, ListHook T::*Hook>
+class IntrusiveList {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const IntrusiveList<T, Hook> &);
+    template <typename V> class BasicIterator;
+public:
+    typedef ListHook * Position;
+    // iteratori bidirezionali
+    typedef BasicIterator<T> iterator;
+    typedef BasicIterator<const T> const_iterator;
+
+    IntrusiveList() { head.next = head.previous = &head; } // costruttore
+    // una lista intrusiva non puo' essere copiata: gli oggetti
+    // hanno un solo collegamento per ciascuna lista
+    IntrusiveList(const IntrusiveList<T, Hook> &) = delete;
+    IntrusiveList<T, Hook> &operator=(const IntrusiveList<T, Hook> &) = delete;
+    ~IntrusiveList() { clear(); } // distruttore
+
+    // operatori
+    // restituisce "true" se la lista e' vuota, "false" altrimenti
+    bool isEmpty() const { return head.next == &head; }
+    // restituisce il numero di elementi contenuti nella lista (O(n))
+    int getSize() const;
+    void print() const; // stampa la lista
+    void pushBack(T &item) { insert(&head, item); } // inserisce in coda
+    void pushFront(T &item) { insert(head.next, item); } // inserisce in testa
+    // inserisce un oggetto nella posizione precedente quella indicata
+    void insert(Position, T &);
+    void popBack(); // toglie l'oggetto in coda
+    void popFront(); // toglie l'oggetto in testa
+    // toglie tutti gli oggetti dalla lista (gli oggetti non vengono distrutti)
+    void clear();
+    // toglie dalla lista l'oggetto nella posizione indicata
+    void remove(Position);
+    // toglie un oggetto dalla lista in tempo costante
+    static void remove(T &item) { (item.*Hook).unlink(); }
+    // restituisce "true" se l'oggetto appartiene a una lista di questo tipo
+    static bool isLinked(const T &item) { return (item.*Hook).isLinked(); }
+    // sposta il puntatore al collegamento successivo
+    Position next(Position pos) const { return pos->next; }
+    // sposta il puntatore al collegamento precedente
+    Position previous(Position pos) const { return pos->previous; }
+    // restituisce la posizione di un oggetto della lista
+    static Position position(T &item) { return &(item.*Hook); }
+    // restituisce la posizione del primo oggetto
+    Position begin() const { return head.next; }
+    // restituisce la posizione dell'ultimo oggetto
+    Position end() const { return head.previous; }
+    // restituisce "true" se la posizione indicata si riferisce
+    // alla fine della lista (sentinella), "false" altrimenti
+    bool finished(Position pos) const { return pos == &head; }
+    // restituisce l'oggetto nella posizione indicata
+    T &read(Position) const;
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo oggetto, iend() la sentinella. Non effettuano controlli
+    iterator ibegin() { return iterator(head.next); }
+    iterator iend() { return iterator(&head); }
+    const_iterator ibegin() const { return const_iterator(head.next); }
+    const_iterator iend() const { return const_iterator(&head); }
+    // consente di scandire la lista con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
+private:
+    // sentinella: la lista e' l'anello di collegamenti che parte da head.
+    // La sentinella e' un membro della lista, che percio' non puo' essere
+    // spostata in memoria mentre contiene oggetti
+    ListHook head;
+
+    // restituisce l'oggetto che contiene il collegamento indicato,
+    // sottraendo all'indirizzo del collegamento la sua distanza
+    // dall'inizio dell'oggetto
+    static T *owner(ListHook *hook)
+    {
+        return reinterpret_cast<T *>(
+            reinterpret_cast<char *>(hook) - hookOffset());
+    }
+    // distanza in byte del membro Hook dall'inizio di T, calcolata una volta
+    // su una zona di memoria delle dimensioni di T (senza costruire T)
+    static std::ptrdiff_t hookOffset()
+    {
+        static const typename std::aligned_storage<sizeof(T),
+            alignof(T)>::type storage = { };
+        static const std::ptrdiff_t offset =
+            reinterpret_cast<const char *>(
+                &(reinterpret_cast<const T *>(&storage)->*Hook))
+            - reinterpret_cast<const char *>(&storage);
+        return offset;
+    }
+};
+
+// iteratore bidirezionale: memorizza il collegamento corrente e
+// restituisce l'oggetto che lo contiene
+template <typename T, ListHook T::*Hook>
+template <typename V>
+class IntrusiveList<T, Hook>::BasicIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_cv<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    BasicIterator() : hook(0) { }
+    explicit BasicIterator(const ListHook *h) : hook(const_cast<ListHook *>(h))
+        { }
+    // conversione da iteratore a iteratore costante
+    operator BasicIterator<const V>() const
+        { return BasicIterator<const V>(hook); }
+
+    reference operator*() const { return *owner(hook); }
+    pointer operator->() const { return owner(hook); }
+
+    BasicIterator &operator++() { hook = hook->next; return *this; }
+    BasicIterator operator++(int)
+        { BasicIterator old(*this); hook = hook->next; return old; }
+    BasicIterator &operator--() { hook = hook->previous; return *this; }
+    BasicIterator operator--(int)
+        { BasicIterator old(*this); hook = hook->previous; return old; }
+
+    bool operator==(const BasicIterator &it) const { return hook == it.hook; }
+    bool operator!=(const BasicIterator &it) const { return hook != it.hook; }
+private:
+    ListHook *hook; // collegamento corrente
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T, ListHook T::*Hook>
+std::ostream &operator<<(std::ostream &output, const IntrusiveList<T, Hook> &l)
+{
+    l.print();
+    return output; // consente cout << a << b << c
+}
+
+// restituisce il numero di elementi contenuti nella lista
+template <typename T, ListHook T::*Hook>
+int IntrusiveList<T, Hook>::getSize() const
+{
+    int size = 0;
+    for (const ListHook *current = head.next; current != &head;
+        current = current->next)
+        ++size;
+    return size;
+}
+
+// stampa la lista
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::print() const
+{
+    if (isEmpty()) {
+        std::cout << "\n List is empty!\n";
+        return;
+    }
+
+    std::cout << "\n [";
+    int i = 0;
+    for (const_iterator it = ibegin(); it != iend(); ++i) {
+        std::cout << std::setw(3) << *it << " ";
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if (++it != iend() && (i + 1) % 5 == 0)
+            std::cout << "\n  ";
+    }
+    std::cout << " ]\n";
+}
+
+// collega un oggetto nella posizione precedente a quella indicata.
+// Un oggetto che appartiene gia' a una lista non viene inserito
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::insert(Position pos, T &item)
+{
+    ListHook &hook = item.*Hook;
+    if (hook.isLinked()) {
+        std::cerr << "Cannot insert: the item is already in a list!\n";
+        return;
+    }
+
+    hook.previous = pos->previous;
+    hook.next = pos;
+    pos->previous->next = &hook;
+    pos->previous = &hook;
+}
+
+// toglie l'oggetto in coda
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::popBack()
+{
+    if (!isEmpty())
+        head.previous->unlink();
+}
+
+// toglie l'oggetto in testa
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::popFront()
+{
+    if (!isEmpty())
+        head.next->unlink();
+}
+
+// toglie l'oggetto nella posizione indicata
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::remove(Position pos)
+{
+    if (!finished(pos))
+        pos->unlink();
+}
+
+// toglie tutti gli oggetti dalla lista, azzerandone i collegamenti
+template <typename T, ListHook T::*Hook>
+void IntrusiveList<T, Hook>::clear()
+{
+    ListHook *current = head.next;
+    while (current != &head) {
+        ListHook *next = current->next;
+        current->next = current->previous = 0;
+        current = next;
+    }
+    head.next = head.previous = &head;
+}
+
+// restituisce l'oggetto nella posizione indicata
+template <typename T, ListHook T::*Hook>
+T &IntrusiveList<T, Hook>::read(Position pos) const
+{
+    if (isEmpty())
+        throw std::domain_error("List is empty!");
+    if (finished(pos))
+        throw std::out_of_range("Invalid position!");
+
+    return *owner(pos);
+}
+
+#endif
@@ -0,0 +1,108 @@
+// benchmark di IntrusiveList contro una LinkedList di puntatori agli stessi
+// oggetti (come LinkedList<Node<L>*> in Graph):
+//   inserimento: n pushBack (LinkedList alloca un nodo per puntatore);
+//   scansione:   somma di un campo degli oggetti (LinkedList legge il nodo
+//                e poi l'oggetto, IntrusiveList solo l'oggetto);
+//   rimozione:   gli n oggetti vengono tolti in ordine casuale
+//                (LinkedList deve cercare la posizione del puntatore, O(n)
+//                per rimozione, IntrusiveList scollega l'oggetto in O(1)).
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "IntrusiveList.h"
+#include "../LinkedList/LinkedList.h"
+using std::cout;
+
+struct Item {
+    int value;
+    ListHook hook;
+};
+
+typedef IntrusiveList<Item, &Item::hook> ItemList;
+
+// evita che il compilatore elimini i cicli di lettura
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, int ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK IntrusiveList **************\n\n";
+    cout << "tempo medio per operazione (ns/op)\n\n";
+    cout << std::setw(10) << "n" << std::setw(12) << "Linked"
+         << std::setw(12) << "Intrusive" << std::setw(12) << "Linked"
+         << std::setw(12) << "Intrusive" << std::setw(12) << "Linked"
+         << std::setw(12) << "Intrusive" << "\n";
+    cout << std::setw(10) << "" << std::setw(24) << "inserimento"
+         << std::setw(24) << "scansione" << std::setw(24) << "rimozione"
+         << "\n";
+
+    std::mt19937 random(1);
+    for (int n = 1 << 10; n <= 1 << 20; n <<= 2) {
+        std::vector<Item> objects(n);
+        for (int i = 0; i < n; ++i)
+            objects[i].value = i;
+        // ordine casuale di rimozione
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), random);
+
+        LinkedList<Item *> linked;
+        ItemList intrusive;
+        double linkedPush = timeOps([&] {
+            for (int i = 0; i < n; ++i)
+                linked.pushBack(&objects[i]);
+        }, n);
+        double intrusivePush = timeOps([&] {
+            for (int i = 0; i < n; ++i)
+                intrusive.pushBack(objects[i]);
+        }, n);
+
+        double linkedScan = timeOps([&] {
+            long long sum = 0;
+            for (Item *item : linked.items())
+                sum += item->value;
+            sink = sum;
+        }, n);
+        double intrusiveScan = timeOps([&] {
+            long long sum = 0;
+            for (const Item &item : intrusive.items())
+                sum += item.value;
+            sink = sum;
+        }, n);
+
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1)
+             << std::setw(12) << linkedPush << std::setw(12) << intrusivePush
+             << std::setw(12) << linkedScan << std::setw(12) << intrusiveScan;
+        // la rimozione da LinkedList costa O(n) per oggetto: oltre 2^14
+        // elementi il tempo di esecuzione diventerebbe eccessivo
+        if (n <= 1 << 14)
+            cout << std::setw(12) << timeOps([&] {
+                for (int i = 0; i < n; ++i)
+                    linked.remove(linked.search(&objects[order[i]]));
+            }, n);
+        else
+            cout << std::setw(12) << "-";
+        cout << std::setw(12) << timeOps([&] {
+            for (int i = 0; i < n; ++i)
+                ItemList::remove(objects[order[i]]);
+        }, n) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include "IntrusiveList.h"
+using std::cout;
+using std::string;
+
+// oggetto che puo' appartenere contemporaneamente a due liste
+struct Task {
+    int id;
+    string owner;
+    ListHook byPriority; // collegamenti per la lista delle priorita'
+    ListHook byOwner; // collegamenti per la lista di un proprietario
+
+    Task(int i, const string &o) : id(i), owner(o) { }
+    bool operator<(const Task &t) const { return id < t.id; }
+};
+
+std::ostream &operator<<(std::ostream &output, const Task &t)
+{
+    return output << t.id;
+}
+
+typedef IntrusiveList<Task, &Task::byPriority> PriorityList;
+typedef IntrusiveList<Task, &Task::byOwner> OwnerList;
+
+int main()
+{
+    PriorityList list;
+
+    cout << "\n************** TEST CLASSE IntrusiveList **************\n\n";
+
+    // stampa una lista vuota
+    cout << "Crea e tenta di stampare una lista vuota:\n";
+    list.print();
+
+    // gli oggetti esistono indipendentemente dalle liste
+    Task tasks[] = { Task(1, "anna"), Task(2, "bruno"), Task(3, "anna"),
+        Task(4, "bruno"), Task(5, "anna"), Task(6, "anna") };
+
+    list.insert(list.begin(), tasks[0]);
+    list.insert(list.end(), tasks[1]);
+    list.pushFront(tasks[2]);
+    list.pushBack(tasks[3]);
+    cout << "\nFUNZIONI insert, pushFront E pushBack:\ncollega 1 (lista "
+         << "vuota), 2 (prima dell'ultimo), 3 (in testa) e 4 (in coda)."
+         << "\nNon viene allocata memoria: i collegamenti sono nei Task\n"
+         << list << "numero di elementi: " << list.getSize() << "\n";
+
+    // un oggetto gia' in una lista non puo' essere inserito di nuovo
+    cout << "\nreinserisce 4, che e' gia' nella lista:\n";
+    list.pushBack(tasks[3]);
+
+    // lo stesso oggetto in due liste diverse
+    OwnerList anna;
+    for (Task &t : tasks)
+        if (t.owner == "anna")
+            anna.pushBack(t);
+    cout << "\nOGGETTI IN PIU' LISTE\nTask di anna (lista collegata tramite "
+         << "il membro byOwner):" << anna;
+    list.pushBack(tasks[4]);
+    cout << "la lista delle priorita' contiene anche il Task 5:" << list;
+
+    // rimozione in tempo costante conoscendo solo l'oggetto
+    PriorityList::remove(tasks[2]);
+    cout << "\nRIMOZIONE DI UN OGGETTO\nremove(Task 3) lo toglie dalla lista "
+         << "delle priorita' senza cercarlo:" << list
+         << "ma resta nella lista di anna:" << anna;
+    anna.remove(anna.begin());
+    list.popBack();
+    cout << "remove(begin()) su anna e popBack() sulle priorita':\nanna:"
+         << anna << "priorita':" << list;
+
+    // lettura e scansione
+    cout << "\nFUNZIONE read E ITERATORI\nprimo elemento: "
+         << list.read(list.begin()).id << ", proprietario: "
+         << list.read(list.begin()).owner << "\n";
+    cout << "Task di anna con un ciclo range-for:";
+    for (const Task &t : anna.items())
+        cout << " " << t.id << "(" << t.owner << ")";
+    cout << "\nTask con id massimo nella lista delle priorita': "
+         << *std::max_element(list.ibegin(), list.iend()) << "\n";
+    try {
+        list.read(list.next(list.end()));
+    } catch (std::out_of_range &e) {
+        cout << "lettura della sentinella: " << e.what() << "\n";
+    }
+
+    // un oggetto distrutto esce automaticamente dalle sue liste
+    {
+        Task temporary(7, "anna");
+        anna.pushBack(temporary);
+        cout << "\nDISTRUZIONE DI UN OGGETTO\nTask 7 in un blocco:" << anna;
+    }
+    cout << "dopo la fine del blocco:" << anna;
+
+    // clear scollega tutti gli oggetti senza distruggerli
+    list.clear();
+    cout << "\nFUNZIONE clear\nlista delle priorita':" << list
+         << "Task 1 collegato: "
+         << (PriorityList::isLinked(tasks[0]) ? "true" : "false") << "\n";
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+
+    return 0;
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 // By Fabio Nardelli
-// lista doppiamente concatenata con sentinella
+// lista doppiamente concatenata con sentinella.
+// I nodi sono allocati dall'allocatore Alloc (vedi Utils/NodePool.h).
 
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
@@ -7,43 +8,81 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
-
-template <typename T>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "../Utils/ListIterator.h"
+#include "../Utils/NodePool.h"
+#include "../Utils/Range.h"
+
+template <typename T, template <typename> class Alloc = HeapAllocator>
 class LinkedList;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const LinkedList<T> &);
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &, const LinkedList<T, Alloc> &);
 
-template <typename T>
+template <typename T, template <typename> class Alloc>
 class LinkedList {
-    friend std::ostream &operator<< <>(std::ostream &, const LinkedList<T> &);
+    friend std::ostream &operator<< <>(std::ostream &,
+        const LinkedList<T, Alloc> &);
 private:
     struct Node;
 public:
     typedef Node * Position;
+    // iteratori bidirezionali
+    typedef ListIterator<Node, T> iterator;
+    typedef ListIterator<Node, const T> const_iterator;
 
     LinkedList() { create(); } // costruttore di default
-    LinkedList(const LinkedList<T> &); // costruttore per copia
+    LinkedList(const LinkedList<T, Alloc> &); // costruttore per copia
     ~LinkedList(); // distruttore
-    LinkedList<T> &operator=(const LinkedList<T> &);
+    LinkedList<T, Alloc> &operator=(const LinkedList<T, Alloc> &);
 
     // operatori
     // restituisce "true" se la lista e' vuota, "false" altrimenti
     bool isEmpty() const { return head == head->next; }
     void print() const; // stampa la lista
-    void pushBack(T); // inserisce un nodo in coda
-    void pushFront(T); // inserisce un nodo in testa
+    // inserisce un nodo in coda
+    void pushBack(const T &item) { emplace(head, item); }
+    void pushBack(T &&item) { emplace(head, std::move(item)); }
+    // inserisce un nodo in testa
+    void pushFront(const T &item) { emplace(head->next, item); }
+    void pushFront(T &&item) { emplace(head->next, std::move(item)); }
     // inserisce un elemento nella posizione precedente quella indicata
-    void insert(Position, T);
+    void insert(Position pos, const T &item) { emplace(pos, item); }
+    void insert(Position pos, T &&item) { emplace(pos, std::move(item)); }
+    // costruiscono un elemento direttamente nel nuovo nodo a partire dagli
+    // argomenti indicati: nella posizione precedente quella indicata,
+    // in coda e in testa
+    template <typename... Args>
+    void emplace(Position, Args &&...);
+    template <typename... Args>
+    void emplaceBack(Args &&... args)
+        { emplace(head, std::forward<Args>(args)...); }
+    template <typename... Args>
+    void emplaceFront(Args &&... args)
+        { emplace(head->next, std::forward<Args>(args)...); }
     void popBack(); // rimuove l'elemento in coda
     void popFront(); // rimuove l'elemento in testa
+    void clear(); // rimuove tutti gli elementi
     // rimuove l'elemento precedente la posizione indicata
     void remove(Position);
     // sposta il puntatore al nodo successivo
     Position next(Position pos) const { return pos->next; }
     // sposta il puntatore al nodo precedente
     Position previous(Position pos) const { return pos->previous; }
-    Position search(T) const;
+    Position search(const T &) const;
+    // restituisce la posizione del primo elemento per cui pred restituisce
+    // "true", oppure 0 se non ce ne sono. pred riceve un riferimento
+    // costante all'elemento, che quindi non viene copiato
+    template <typename Pred>
+    Position findIf(Pred pred) const;
+    // chiama f su ciascun elemento, dal primo all'ultimo, passandogli un
+    // riferimento all'elemento (costante se la lista e' costante)
+    template <typename F>
+    void forEach(F f);
+    template <typename F>
+    void forEach(F f) const;
     // restituisce la posizione del primo nodo
     Position begin() const { return head->next; }
     // restituisce la posizione dell'ultimo nodo
@@ -54,19 +93,56 @@ public:
     // legge il dato contenuto nel nodo indicato
     const T &read(Position) const;
     // scrive nel nodo indicato
-    void write(Position, T);
-    bool operator==(const LinkedList<T> &) const;
+    void write(Position, const T &);
+    void write(Position, T &&);
+    bool operator==(const LinkedList<T, Alloc> &) const;
+    // sposta i nodi di other da first a last (compresi) nella posizione
+    // precedente a pos, senza copiarne i dati. pos non deve essere
+    // compresa fra first e last
+    void splice(Position pos, LinkedList<T, Alloc> &other,
+        Position first, Position last);
+    // sposta tutti i nodi di other in coda alla lista
+    void append(LinkedList<T, Alloc> &other);
+    // ordina la lista in ordine crescente (ordinamento stabile)
+    void sort();
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo nodo, iend() la sentinella. Non effettuano controlli
+    iterator ibegin() { return iterator(head->next); }
+    iterator iend() { return iterator(head); }
+    const_iterator ibegin() const { return const_iterator(head->next); }
+    const_iterator iend() const { return const_iterator(head); }
+    // consente di scandire la lista con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
 private:
 
-    // rappresenta un generico nodo
+    // rappresenta un generico nodo. Il dato viene costruito a partire
+    // dagli argomenti del costruttore (la sentinella lo costruisce
+    // per default)
     struct Node {
         T value; // dato contenuto nel nodo
         Node *next; // puntatore al nodo successivo
         Node *previous; // puntatore al nodo precedente
+
+        template <typename... Args>
+        Node(Args &&... args)
+            : value(std::forward<Args>(args)...), next(0), previous(0) { }
     };
 
     Position head; // puntatore al primo nodo (sentinella) della lista
+    Alloc<Node> alloc; // allocatore dei nodi della lista
     void create(); // crea una lista vuota
+    // alloca un nodo e vi costruisce il dato a partire dagli argomenti
+    template <typename... Args>
+    Position makeNode(Args &&...);
+    // distrugge il dato di un nodo e ne libera la memoria
+    void deleteNode(Position );
+    // distrugge tutti i nodi, sentinella compresa
+    void destroyAll();
+    // fonde due catene ordinate di nodi, concatenate solo tramite next
+    static Position mergeChains(Position, Position);
 };
 
 /*===========================================================================*/
@@ -74,30 +150,29 @@ private:
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const LinkedList<T> &l) 
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &output, const LinkedList<T, Alloc> &l)
 {
     l.print();
     return output; // consente cout << a << b << c
 }
 
 // crea una lista vuota. E' chiamata dal costruttore di default
-template <typename T>
-void LinkedList<T>::create()
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::create()
 {
     // crea una lista vuota, munita di sentinella (nodo head)
-    head = new Node;
+    head = alloc.allocate();
+    new (head) Node;
     head->next = head;
     head->previous = head;
 }
 
 // costruttore per copia
-template <typename T>
-LinkedList<T>::LinkedList(const LinkedList<T> &l) 
+template <typename T, template <typename> class Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList<T, Alloc> &l)
 {
-    head = new Node;
-    head->next = head;
-    head->previous = head;
+    create();
 
     Position current = l.begin();
     while (!l.finished(current)) {
@@ -107,18 +182,74 @@ LinkedList<T>::LinkedList(const LinkedList<T> &l)
 }
 
 // distruttore
-template <typename T>
-LinkedList<T>::~LinkedList() 
+template <typename T, template <typename> class Alloc>
+LinkedList<T, Alloc>::~LinkedList()
+{
+    destroyAll();
+}
+
+// rimuove tutti gli elementi
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::clear()
 {
-    while (!isEmpty())
-        popFront();
+    destroyAll();
+    create();
+}
 
-    delete head;
+// alloca un nodo e vi costruisce il dato a partire dagli argomenti
+template <typename T, template <typename> class Alloc>
+template <typename... Args>
+typename LinkedList<T, Alloc>::Position
+    LinkedList<T, Alloc>::makeNode(Args &&... args)
+{
+    Position node = alloc.allocate();
+    try {
+        new (node) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        alloc.deallocate(node);
+        throw;
+    }
+    return node;
+}
+
+// distrugge il dato di un nodo e ne restituisce la memoria all'allocatore
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::deleteNode(Position node)
+{
+    node->~Node();
+    alloc.deallocate(node);
+}
+
+// distrugge tutti i nodi, sentinella compresa. Se l'allocatore libera in
+// blocco la sua memoria, i nodi non vengono restituiti uno a uno e, se il
+// distruttore di T non fa nulla, non vengono nemmeno visitati
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::destroyAll()
+{
+    Position current = head->next;
+    if (Alloc<Node>::releasesAll) {
+        if (!std::is_trivially_destructible<T>::value) {
+            while (current != head) {
+                Position next = current->next;
+                current->~Node();
+                current = next;
+            }
+            head->~Node();
+        }
+        alloc.release();
+    } else {
+        while (current != head) {
+            Position next = current->next;
+            deleteNode(current);
+            current = next;
+        }
+        deleteNode(head);
+    }
 }
 
 // stampa la lista
-template <typename T>
-void LinkedList<T>::print() const
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::print() const
 {
     if (isEmpty()) {
         std::cout << "\n List is empty!\n";
@@ -140,55 +271,15 @@ void LinkedList<T>::print() const
     std::cout << " ]\n";
 } 
 
-// inserisce un nodo in coda
-template <typename T>
-void LinkedList<T>::pushBack(T item) 
-{
-    // crea un nuovo nodo
-    Position newNode = new Node;
-    newNode->value = item;
-    // collega il nuovo nodo alla lista
-    if (isEmpty()) { // se la lista e' vuota
-        head->next = newNode;
-        head->previous = newNode;
-        newNode->next = head;
-        newNode->previous = head;
-    } else {
-        newNode->previous = head->previous;
-        newNode->next = head;
-        head->previous->next = newNode;
-        head->previous = newNode;
-    }
-}
-
-// inserisce un nodo in testa
-template <typename T>
-void LinkedList<T>::pushFront(T item) 
+// costruisce un elemento in un nuovo nodo e lo collega nella posizione
+// precedente a quella indicata (in coda se pos e' la sentinella). Se la
+// costruzione lancia un'eccezione la lista resta invariata
+template <typename T, template <typename> class Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplace(Position pos, Args &&... args)
 {
     // crea un nuovo nodo
-    Position newNode = new Node;
-    newNode->value = item;
-    // collega il nuovo nodo alla lista
-    if (isEmpty()) { // se la lista e' vuota
-        head->next = newNode;
-        head->previous = newNode;
-        newNode->next = head;
-        newNode->previous = head;
-    } else {
-        newNode->previous = head;
-        newNode->next = head->next;
-        head->next->previous = newNode;
-        head->next = newNode;
-    }
-}
-
-// inserisce un nodo nella posizione precedente a quella indicata
-template <typename T>
-void LinkedList<T>::insert(Position pos, T item) 
-{
-    // crea un nuovo nodo
-    Position newNode = new Node;
-    newNode->value = item;
+    Position newNode = makeNode(std::forward<Args>(args)...);
     // collega il nuovo nodo alla lista
     newNode->previous = pos->previous;
     newNode->next = pos;
@@ -197,45 +288,46 @@ void LinkedList<T>::insert(Position pos, T item)
 }
 
 // rimuove il nodo in coda
-template <typename T>
-void LinkedList<T>::popBack() 
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::popBack()
 {
     if (!isEmpty()) {
         Position current = head->previous;
         head->previous = head->previous->previous;
         head->previous->next = head;
-        delete current;
+        deleteNode(current);
     }
 }
 
 // rimuove il nodo in testa
-template <typename T>
-void LinkedList<T>::popFront() 
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::popFront()
 {
     if (!isEmpty()) {
         Position current = head->next;
         head->next = head->next->next;
         head->next->previous = head;
-        delete current;
+        deleteNode(current);
     }
 }
 
 // rimuove il nodo alla posizione indicata
-template <typename T>
-void LinkedList<T>::remove(Position pos) 
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::remove(Position pos)
 {
     if (!isEmpty() && !finished(pos)) {
         pos->previous->next = pos->next;
         pos->next->previous = pos->previous;
-        delete pos;
+        deleteNode(pos);
     }
 }
 
 // cerca la prima occorrenza di un dato. Se lo trova,
 // restituisce la posizione del nodo corrispondente, 
 // altrimenti restituisce 0
-template <typename T>
-typename LinkedList<T>::Position LinkedList<T>::search(T item) const 
+template <typename T, template <typename> class Alloc>
+typename LinkedList<T, Alloc>::Position
+    LinkedList<T, Alloc>::search(const T &item) const
 {
     // se la lista e' vuota, termina la ricerca
     if (isEmpty())
@@ -252,9 +344,43 @@ typename LinkedList<T>::Position LinkedList<T>::search(T item) const
     return 0;
 }
 
+// restituisce la posizione del primo elemento che soddisfa pred
+template <typename T, template <typename> class Alloc>
+template <typename Pred>
+typename LinkedList<T, Alloc>::Position
+    LinkedList<T, Alloc>::findIf(Pred pred) const
+{
+    for (Position current = head->next; current != head;
+        current = current->next)
+        if (pred(static_cast<const T &>(current->value)))
+            return current;
+
+    return 0;
+}
+
+// chiama f su ciascun elemento della lista
+template <typename T, template <typename> class Alloc>
+template <typename F>
+void LinkedList<T, Alloc>::forEach(F f)
+{
+    for (Position current = head->next; current != head;
+        current = current->next)
+        f(current->value);
+}
+
+// come sopra, ma su una lista costante
+template <typename T, template <typename> class Alloc>
+template <typename F>
+void LinkedList<T, Alloc>::forEach(F f) const
+{
+    for (Position current = head->next; current != head;
+        current = current->next)
+        f(static_cast<const T &>(current->value));
+}
+
 // legge il dato contenuto nel nodo indicato
-template <typename T>
-const T &LinkedList<T>::read(Position pos) const 
+template <typename T, template <typename> class Alloc>
+const T &LinkedList<T, Alloc>::read(Position pos) const
 {
     if (isEmpty())
         throw std::domain_error("List is empty!");
@@ -263,23 +389,30 @@ const T &LinkedList<T>::read(Position pos) const
 }
 
 // scrive nel nodo indicato
-template <typename T>
-void LinkedList<T>::write(Position pos, T item) 
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::write(Position pos, const T &item)
 {
     if (!isEmpty())
         pos->value = item;
 }
 
+// come sopra, ma sposta il dato indicato invece di copiarlo
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::write(Position pos, T &&item)
+{
+    if (!isEmpty())
+        pos->value = std::move(item);
+}
+
 // overload dell'operatore di assegnazione =
-template <typename T>
-LinkedList<T> &LinkedList<T>::operator=(const LinkedList<T> &l) 
+template <typename T, template <typename> class Alloc>
+LinkedList<T, Alloc> &LinkedList<T, Alloc>::operator=(const LinkedList<T, Alloc> &l)
 {
     if (&l != this) { // evita l'auto-assegnazione
 
         // cancella i nodi di questa lista
         //Positioncurrent = head->next;
-        while (!isEmpty())
-            popFront();
+        clear();
 
         // copia la lista l in questa lista
         Position current = l.begin();
@@ -292,9 +425,122 @@ LinkedList<T> &LinkedList<T>::operator=(const LinkedList<T> &l)
     return *this; // consente a = b = c
 }
 
+// sposta i nodi di other compresi fra first e last nella posizione
+// precedente a pos. I nodi vengono staccati da other e ricollegati in
+// questa lista in tempo costante; se pero' l'allocatore non consente di
+// passare un nodo da un contenitore all'altro (ad esempio PoolAllocator,
+// in cui ogni lista ha la propria area di memoria), i dati vengono
+// spostati in nuovi nodi di questa lista
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::splice(Position pos, LinkedList<T, Alloc> &other,
+    Position first, Position last)
+{
+    if (other.isEmpty() || other.finished(first) || other.finished(last))
+        return;
+
+    if (Alloc<Node>::stateless || &other == this) {
+        // stacca la catena da other
+        first->previous->next = last->next;
+        last->next->previous = first->previous;
+        // e la collega prima di pos
+        first->previous = pos->previous;
+        last->next = pos;
+        pos->previous->next = first;
+        pos->previous = last;
+    } else {
+        Position current = first;
+        bool done = false;
+        while (!done) {
+            Position next = current->next;
+            done = (current == last);
+            insert(pos, std::move(current->value));
+            other.remove(current);
+            current = next;
+        }
+    }
+}
+
+// sposta tutti i nodi di other in coda alla lista (prima della sentinella)
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::append(LinkedList<T, Alloc> &other)
+{
+    if (&other != this)
+        splice(head, other, other.begin(), other.end());
+}
+
+// fonde due catene ordinate di nodi terminate da 0. A parita' di valore
+// precede il nodo della prima catena, per cui la fusione e' stabile
+template <typename T, template <typename> class Alloc>
+typename LinkedList<T, Alloc>::Position
+    LinkedList<T, Alloc>::mergeChains(Position a, Position b)
+{
+    Position first = 0;
+    Position *tail = &first; // campo next da collegare
+    while (a != 0 && b != 0) {
+        if (b->value < a->value) {
+            *tail = b;
+            b = b->next;
+        } else {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (a != 0 ? a : b);
+    return first;
+}
+
+// ordina la lista con un merge sort "dal basso": i nodi vengono staccati
+// uno alla volta e fusi in catene ordinate, dove la catena i-esima contiene
+// 2^i nodi (come le cifre di un contatore binario). Non alloca memoria
+// (le catene sono in un vettore di dimensione fissa) e costa O(n log n);
+// al termine vengono ricostruiti i puntatori previous
+template <typename T, template <typename> class Alloc>
+void LinkedList<T, Alloc>::sort()
+{
+    if (head->next == head->previous) // meno di due elementi
+        return;
+
+    const int maxChains = 64;
+    Position chains[maxChains] = { 0 };
+    Position list = head->next;
+    head->previous->next = 0; // termina la catena
+
+    while (list != 0) {
+        Position node = list;
+        list = list->next;
+        node->next = 0;
+        // fonde il nodo con le catene gia' presenti, che contengono
+        // nodi precedenti, finche' non trova una posizione libera
+        int i = 0;
+        for (; i < maxChains - 1 && chains[i] != 0; ++i) {
+            node = mergeChains(chains[i], node);
+            chains[i] = 0;
+        }
+        chains[i] = (chains[i] != 0 ? mergeChains(chains[i], node) : node);
+    }
+
+    // fonde le catene rimaste: quelle di indice maggiore contengono i
+    // nodi precedenti
+    Position result = 0;
+    for (int i = 0; i < maxChains; ++i)
+        if (chains[i] != 0)
+            result = (result != 0 ? mergeChains(chains[i], result) : chains[i]);
+
+    // ricollega i nodi alla sentinella e ricostruisce i puntatori previous
+    Position previous = head;
+    for (Position current = result; current != 0; current = current->next) {
+        current->previous = previous;
+        previous->next = current;
+        previous = current;
+    }
+    previous->next = head;
+    head->previous = previous;
+}
+
 // overload dell'operatore di uguaglianza ==
-template <typename T>
-bool LinkedList<T>::operator==(const LinkedList<T> &l) const 
+template <typename T, template <typename> class Alloc>
+bool LinkedList<T, Alloc>::operator==(const LinkedList<T, Alloc> &l) const
 {
     // se le liste sono entrambe vuote, allora sono uguali
     if (isEmpty() && l.isEmpty())
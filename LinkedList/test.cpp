@@ -1,6 +1,9 @@
 #include <iostream>
+#include <algorithm>
+#include <string>
 #include "LinkedList.h"
 using std::cout;
+using std::string;
 
 int main()
 {
@@ -63,6 +66,62 @@ int main()
     cout << "\nFUNZIONI popFront E popBack\nRimossi primo e ultimo"
          << " elemento\n" << list;
 
+    // iteratori: range-for e algoritmi della libreria standard
+    LinkedList<int> list4;
+    for (int i = 1; i <= 5; ++i)
+        list4.pushBack(i * i);
+    for (int &x : list4.items())
+        x += 1;
+    cout << "\nITERATORI\nCrea una lista 'list4' di quadrati e incrementa"
+         << " ogni elemento con un range-for" << list4;
+    cout << "std::find(17): "
+         << (std::find(list4.ibegin(), list4.iend(), 17) != list4.iend() ?
+             "trovato\n" : "non trovato\n");
+
+    // allocatore a blocchi: i nodi vengono allocati a gruppi e
+    // clear libera tutta la memoria della lista in una volta
+    LinkedList<int, PoolAllocator> list5;
+    for (int i = 1; i <= 8; ++i)
+        list5.pushBack(i * 10);
+    cout << "\nALLOCATORE A BLOCCHI\nCrea una lista 'list5' che usa"
+         << " PoolAllocator" << list5;
+    list5.clear();
+    cout << "Dopo list5.clear():" << list5;
+
+    // spostamento di nodi fra liste e ordinamento
+    LinkedList<int> list6, list7;
+    for (int i = 0; i < 5; ++i) {
+        list6.pushBack(i);
+        list7.pushBack(10 * i);
+    }
+    list6.splice(list6.begin(), list7, list7.next(list7.begin()),
+        list7.previous(list7.end()));
+    cout << "\nFUNZIONI splice E append\nsplice sposta in testa a 'list6' gli"
+         << " elementi di 'list7' dal secondo al penultimo:" << list6
+         << "list7:" << list7;
+    list6.append(list7);
+    cout << "append sposta tutti gli elementi di 'list7' in coda a 'list6':"
+         << list6 << "list7:" << list7;
+    list6.sort();
+    cout << "\nFUNZIONE sort\nordina 'list6' senza allocare memoria:" << list6;
+
+    // costruzione sul posto, ricerca con un predicato e visita
+    LinkedList<string> words;
+    words.emplaceBack(3, 'a');
+    words.emplaceFront("lista");
+    words.emplace(words.end(), "di");
+    words.pushBack(string("parole"));
+    cout << "\nFUNZIONI emplace, emplaceBack E emplaceFront\ncostruiscono "
+         << "le stringhe direttamente nei nodi:" << words;
+    LinkedList<string>::Position longWord = words.findIf(
+        [](const string &w) { return w.size() > 5; });
+    cout << "\nFUNZIONI findIf E forEach\nprima parola con piu' di 5 lettere: "
+         << words.read(longWord) << "\n";
+    std::size_t letters = 0;
+    words.forEach([&letters](const string &w) { letters += w.size(); });
+    cout << "lettere totali (forEach, senza copiare le stringhe): " << letters
+         << "\n";
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
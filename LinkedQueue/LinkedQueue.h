@@ -1,5 +1,6 @@
 // By Fabio Nardelli
-// coda FIFO basata su lista doppiamente concatenata con sentinella
+// coda FIFO basata su lista doppiamente concatenata con sentinella.
+// I nodi sono allocati dall'allocatore Alloc (vedi Utils/NodePool.h).
 
 #ifndef LINKED_QUEUE_H
 #define LINKED_QUEUE_H
@@ -7,21 +8,33 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
-
-template <typename T>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "../Utils/ListIterator.h"
+#include "../Utils/NodePool.h"
+#include "../Utils/Range.h"
+
+template <typename T, template <typename> class Alloc = HeapAllocator>
 class LinkedQueue;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const LinkedQueue<T> &);
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &, const LinkedQueue<T, Alloc> &);
 
-template <typename T>
+template <typename T, template <typename> class Alloc>
 class LinkedQueue {
-    friend std::ostream &operator<< <>(std::ostream &, const LinkedQueue<T> &);
+    friend std::ostream &operator<< <>(std::ostream &,
+        const LinkedQueue<T, Alloc> &);
+    struct Node;
 public:
+    // iteratori bidirezionali, dall'elemento da piu' tempo in coda al piu' recente
+    typedef ListIterator<Node, T> iterator;
+    typedef ListIterator<Node, const T> const_iterator;
+
     LinkedQueue() { create(); } // costruttore di default
-    LinkedQueue(const LinkedQueue<T> &); // costruttore per copia
+    LinkedQueue(const LinkedQueue<T, Alloc> &); // costruttore per copia
     ~LinkedQueue(); // distruttore
-    LinkedQueue<T> &operator=(const LinkedQueue<T> &);
+    LinkedQueue<T, Alloc> &operator=(const LinkedQueue<T, Alloc> &);
 
     // operatori
 
@@ -30,8 +43,20 @@ public:
     void print() const; // stampa la coda
     void enqueue(T); // inserisce un elemento in coda
     void dequeue(); // rimuove l'elemento da piu' tempo in coda
+    void clear(); // rimuove tutti gli elementi
     T top() const; // restituisce l'elemento da piu' tempo in coda
-    bool operator==(const LinkedQueue<T> &) const;
+    bool operator==(const LinkedQueue<T, Alloc> &) const;
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo nodo, iend() la sentinella. Non effettuano controlli
+    iterator ibegin() { return iterator(head->next); }
+    iterator iend() { return iterator(head); }
+    const_iterator ibegin() const { return const_iterator(head->next); }
+    const_iterator iend() const { return const_iterator(head); }
+    // consente di scandire la coda con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
 private:
 
     // rappresenta un generico nodo
@@ -42,7 +67,15 @@ private:
     };
 
     Node *head; // puntatore al primo nodo (sentinella) della coda
+    Alloc<Node> alloc; // allocatore dei nodi della coda
     void create(); // crea una coda vuota
+    // alloca un nodo e vi costruisce il dato indicato
+    template <typename U>
+    Node *makeNode(U &&);
+    // distrugge il dato di un nodo e ne libera la memoria
+    void deleteNode(Node *);
+    // distrugge tutti i nodi, sentinella compresa
+    void destroyAll();
 };
 
 /*===========================================================================*/
@@ -50,30 +83,29 @@ private:
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const LinkedQueue<T> &q) 
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &output, const LinkedQueue<T, Alloc> &q)
 {
     q.print();
     return output; // consente cout << a << b << c
 }
 
 // utility function chiamata dal costruttore di default
-template <typename T>
-void LinkedQueue<T>::create()
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::create()
 {
     // crea una coda vuota, munita di sentinella (nodo head)
-    head = new Node;
+    head = alloc.allocate();
+    new (head) Node;
     head->next = head;
     head->previous = head;
 }
 
 // costruttore per copia
-template <typename T>
-LinkedQueue<T>::LinkedQueue(const LinkedQueue<T> &q) 
+template <typename T, template <typename> class Alloc>
+LinkedQueue<T, Alloc>::LinkedQueue(const LinkedQueue<T, Alloc> &q)
 {
-    head = new Node;
-    head->next = head;
-    head->previous = head;
+    create();
 
     Node *current = q.head->next;
     while (current != q.head) {
@@ -83,18 +115,74 @@ LinkedQueue<T>::LinkedQueue(const LinkedQueue<T> &q)
 }
 
 // distruttore
-template <typename T>
-LinkedQueue<T>::~LinkedQueue() 
+template <typename T, template <typename> class Alloc>
+LinkedQueue<T, Alloc>::~LinkedQueue()
 {
-    while (!isEmpty())
-        dequeue();
+    destroyAll();
+}
 
-    delete head;
+// rimuove tutti gli elementi
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::clear()
+{
+    destroyAll();
+    create();
+}
+
+// alloca un nodo e vi costruisce il dato indicato
+template <typename T, template <typename> class Alloc>
+template <typename U>
+typename LinkedQueue<T, Alloc>::Node *
+    LinkedQueue<T, Alloc>::makeNode(U &&item)
+{
+    Node *node = alloc.allocate();
+    try {
+        new (node) Node{ std::forward<U>(item), 0, 0 };
+    } catch (...) {
+        alloc.deallocate(node);
+        throw;
+    }
+    return node;
+}
+
+// distrugge il dato di un nodo e ne restituisce la memoria all'allocatore
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::deleteNode(Node *node)
+{
+    node->~Node();
+    alloc.deallocate(node);
+}
+
+// distrugge tutti i nodi, sentinella compresa. Se l'allocatore libera in
+// blocco la sua memoria, i nodi non vengono restituiti uno a uno e, se il
+// distruttore di T non fa nulla, non vengono nemmeno visitati
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::destroyAll()
+{
+    Node *current = head->next;
+    if (Alloc<Node>::releasesAll) {
+        if (!std::is_trivially_destructible<T>::value) {
+            while (current != head) {
+                Node *next = current->next;
+                current->~Node();
+                current = next;
+            }
+            head->~Node();
+        }
+        alloc.release();
+    } else {
+        while (current != head) {
+            Node *next = current->next;
+            deleteNode(current);
+            current = next;
+        }
+        deleteNode(head);
+    }
 }
 
 // stampa la coda
-template <typename T>
-void LinkedQueue<T>::print() const
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::print() const
 {
     if (isEmpty()) {
         std::cout << "\n Queue is empty!\n";
@@ -117,12 +205,11 @@ void LinkedQueue<T>::print() const
 } 
 
 // inserisce un nodo in coda
-template <typename T>
-void LinkedQueue<T>::enqueue(T item) 
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::enqueue(T item)
 {
     // crea un nuovo nodo
-    Node *newNode = new Node;
-    newNode->value = item;
+    Node *newNode = makeNode(std::move(item));
     // collega il nuovo nodo alla coda
     if (isEmpty()) { // se la coda e' vuota
         head->next = newNode;
@@ -138,20 +225,20 @@ void LinkedQueue<T>::enqueue(T item)
 }
 
 // rimuove il nodo da piu' tempo in coda (FIFO)
-template <typename T>
-void LinkedQueue<T>::dequeue() 
+template <typename T, template <typename> class Alloc>
+void LinkedQueue<T, Alloc>::dequeue()
 {
     if (!isEmpty()) {
         Node *current = head->next;
         head->next = head->next->next;
         head->next->previous = head;
-        delete current;
+        deleteNode(current);
     }
 }
 
 // legge l'elemento da piu' tempo in coda
-template <typename T>
-T LinkedQueue<T>::top() const {
+template <typename T, template <typename> class Alloc>
+T LinkedQueue<T, Alloc>::top() const {
     if (isEmpty())
         throw std::domain_error("Queue is empty!");
 
@@ -159,14 +246,13 @@ T LinkedQueue<T>::top() const {
 }
 
 // overload dell'operatore di assegnazione =
-template <typename T>
-LinkedQueue<T> &LinkedQueue<T>::operator=(const LinkedQueue<T> &q) 
+template <typename T, template <typename> class Alloc>
+LinkedQueue<T, Alloc> &LinkedQueue<T, Alloc>::operator=(const LinkedQueue<T, Alloc> &q)
 {
     if (&q != this) { // evita l'auto-assegnazione
 
         // cancella i nodi di questa coda
-        while (!isEmpty())
-            dequeue();
+        clear();
 
         // copia la coda q in questa coda
         Node *current = q.head->next;
@@ -180,8 +266,8 @@ LinkedQueue<T> &LinkedQueue<T>::operator=(const LinkedQueue<T> &q)
 }
 
 // overload dell'operatore di uguaglianza ==
-template <typename T>
-bool LinkedQueue<T>::operator==(const LinkedQueue<T> &q) const 
+template <typename T, template <typename> class Alloc>
+bool LinkedQueue<T, Alloc>::operator==(const LinkedQueue<T, Alloc> &q) const
 {
     // se le code sono entrambe vuote, allora sono uguali
     if (isEmpty() && q.isEmpty())
@@ -56,6 +56,12 @@ int main()
     else
         cout << "false\n";
 
+    // iteratori: range-for
+    cout << "\nITERATORI\nElementi di 'queue3' con range-for: ";
+    for (int x : queue3.items())
+        cout << x << " ";
+    cout << "\n";
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
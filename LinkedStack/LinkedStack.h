@@ -1,5 +1,6 @@
 // By Fabio Nardelli
-// coda LIFO basata su una lista doppiamente concatenata con sentinella
+// coda LIFO basata su una lista doppiamente concatenata con sentinella.
+// I nodi sono allocati dall'allocatore Alloc (vedi Utils/NodePool.h).
 
 #ifndef LINKED_STACK_H
 #define LINKED_STACK_H
@@ -7,21 +8,33 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
-
-template <typename T>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "../Utils/ListIterator.h"
+#include "../Utils/NodePool.h"
+#include "../Utils/Range.h"
+
+template <typename T, template <typename> class Alloc = HeapAllocator>
 class LinkedStack;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const LinkedStack<T> &);
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &, const LinkedStack<T, Alloc> &);
 
-template <typename T>
+template <typename T, template <typename> class Alloc>
 class LinkedStack {
-    friend std::ostream &operator<< <>(std::ostream &, const LinkedStack<T> &);
+    friend std::ostream &operator<< <>(std::ostream &,
+        const LinkedStack<T, Alloc> &);
+    struct Node;
 public:
+    // iteratori bidirezionali, dal fondo della pila alla cima
+    typedef ListIterator<Node, T> iterator;
+    typedef ListIterator<Node, const T> const_iterator;
+
     LinkedStack() { create(); } // costruttore di default
-    LinkedStack(const LinkedStack<T> &); // costruttore per copia
+    LinkedStack(const LinkedStack<T, Alloc> &); // costruttore per copia
     ~LinkedStack(); // distruttore
-    LinkedStack<T> &operator=(const LinkedStack<T> &);
+    LinkedStack<T, Alloc> &operator=(const LinkedStack<T, Alloc> &);
 
     // operatori
 
@@ -30,9 +43,21 @@ public:
     void print() const; // stampa la pila
     void push(T); // inserisce un elemento in cima alla pila
     void pop(); // estrae l'elemento in cima alla pila
+    void clear(); // rimuove tutti gli elementi
     T top() const; // legge l'elemento in cima alla pila
     // operatore di uguaglianza
-    bool operator==(const LinkedStack<T> &) const;
+    bool operator==(const LinkedStack<T, Alloc> &) const;
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo nodo, iend() la sentinella. Non effettuano controlli
+    iterator ibegin() { return iterator(head->next); }
+    iterator iend() { return iterator(head); }
+    const_iterator ibegin() const { return const_iterator(head->next); }
+    const_iterator iend() const { return const_iterator(head); }
+    // consente di scandire la pila con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
 private:
 
     // rappresenta un generico nodo
@@ -43,7 +68,15 @@ private:
     };
 
     Node *head; // puntatore al primo nodo (sentinella) della pila
+    Alloc<Node> alloc; // allocatore dei nodi della pila
     void create(); // crea una pila vuota
+    // alloca un nodo e vi costruisce il dato indicato
+    template <typename U>
+    Node *makeNode(U &&);
+    // distrugge il dato di un nodo e ne libera la memoria
+    void deleteNode(Node *);
+    // distrugge tutti i nodi, sentinella compresa
+    void destroyAll();
 };
 
 /*===========================================================================*/
@@ -51,30 +84,29 @@ private:
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const LinkedStack<T> &s) 
+template <typename T, template <typename> class Alloc>
+std::ostream &operator<<(std::ostream &output, const LinkedStack<T, Alloc> &s)
 {
     s.print();
     return output; // consente cout << a << b << c
 }
 
 // utility function chiamata dal costruttore di default
-template <typename T>
-void LinkedStack<T>::create()
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::create()
 {
     // crea una pila vuota, munita di sentinella (nodo head)
-    head = new Node;
+    head = alloc.allocate();
+    new (head) Node;
     head->next = head;
     head->previous = head;
 }
 
 // costruttore per copia
-template <typename T>
-LinkedStack<T>::LinkedStack(const LinkedStack<T> &s) 
+template <typename T, template <typename> class Alloc>
+LinkedStack<T, Alloc>::LinkedStack(const LinkedStack<T, Alloc> &s)
 {
-    head = new Node;
-    head->next = head;
-    head->previous = head;
+    create();
 
     Node *current = s.head->next;
     while (current != s.head) {
@@ -84,18 +116,74 @@ LinkedStack<T>::LinkedStack(const LinkedStack<T> &s)
 }
 
 // distruttore
-template <typename T>
-LinkedStack<T>::~LinkedStack() 
+template <typename T, template <typename> class Alloc>
+LinkedStack<T, Alloc>::~LinkedStack()
 {
-    while (!isEmpty())
-        pop();
+    destroyAll();
+}
 
-    delete head;
+// rimuove tutti gli elementi
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::clear()
+{
+    destroyAll();
+    create();
+}
+
+// alloca un nodo e vi costruisce il dato indicato
+template <typename T, template <typename> class Alloc>
+template <typename U>
+typename LinkedStack<T, Alloc>::Node *
+    LinkedStack<T, Alloc>::makeNode(U &&item)
+{
+    Node *node = alloc.allocate();
+    try {
+        new (node) Node{ std::forward<U>(item), 0, 0 };
+    } catch (...) {
+        alloc.deallocate(node);
+        throw;
+    }
+    return node;
+}
+
+// distrugge il dato di un nodo e ne restituisce la memoria all'allocatore
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::deleteNode(Node *node)
+{
+    node->~Node();
+    alloc.deallocate(node);
+}
+
+// distrugge tutti i nodi, sentinella compresa. Se l'allocatore libera in
+// blocco la sua memoria, i nodi non vengono restituiti uno a uno e, se il
+// distruttore di T non fa nulla, non vengono nemmeno visitati
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::destroyAll()
+{
+    Node *current = head->next;
+    if (Alloc<Node>::releasesAll) {
+        if (!std::is_trivially_destructible<T>::value) {
+            while (current != head) {
+                Node *next = current->next;
+                current->~Node();
+                current = next;
+            }
+            head->~Node();
+        }
+        alloc.release();
+    } else {
+        while (current != head) {
+            Node *next = current->next;
+            deleteNode(current);
+            current = next;
+        }
+        deleteNode(head);
+    }
 }
 
 // stampa la pila
-template <typename T>
-void LinkedStack<T>::print() const
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::print() const
 {
     if (isEmpty()) {
         std::cout << "\n Stack is empty!\n";
@@ -118,12 +206,11 @@ void LinkedStack<T>::print() const
 } 
 
 // inserisce un nodo in cima alla pila
-template <typename T>
-void LinkedStack<T>::push(T item)
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::push(T item)
 {
     // crea un nuovo nodo
-    Node *newNode = new Node;
-    newNode->value = item;
+    Node *newNode = makeNode(std::move(item));
     // collega il nuovo nodo alla pila
     if (isEmpty()) { // se la pila e' vuota
         head->next = newNode;
@@ -139,20 +226,20 @@ void LinkedStack<T>::push(T item)
 }
 
 // rimuove il nodo in cima alla pila
-template <typename T>
-void LinkedStack<T>::pop()
+template <typename T, template <typename> class Alloc>
+void LinkedStack<T, Alloc>::pop()
 {
     if (!isEmpty()) {
         Node *current = head->previous;
         head->previous = head->previous->previous;
         head->previous->next = head;
-        delete current;
+        deleteNode(current);
     }
 }
 
 // legge il primo elemento della pila
-template <typename T>
-T LinkedStack<T>::top() const
+template <typename T, template <typename> class Alloc>
+T LinkedStack<T, Alloc>::top() const
 {
     if (isEmpty())
         throw std::domain_error("Stack is empty!");
@@ -161,14 +248,13 @@ T LinkedStack<T>::top() const
 }
 
 // overload dell'operatore di assegnazione =
-template <typename T>
-LinkedStack<T> &LinkedStack<T>::operator=(const LinkedStack<T> &s) 
+template <typename T, template <typename> class Alloc>
+LinkedStack<T, Alloc> &LinkedStack<T, Alloc>::operator=(const LinkedStack<T, Alloc> &s)
 {
     if (&s != this) { // evita l'auto-assegnazione
 
         // cancella i nodi di questa pila
-        while (!isEmpty())
-            pop();
+        clear();
 
         // copia la pila s in questa pila
         Node *current = s.head->next;
@@ -182,8 +268,8 @@ LinkedStack<T> &LinkedStack<T>::operator=(const LinkedStack<T> &s)
 }
 
 // overload dell'operatore di uguaglianza ==
-template <typename T>
-bool LinkedStack<T>::operator==(const LinkedStack<T> &s) const 
+template <typename T, template <typename> class Alloc>
+bool LinkedStack<T, Alloc>::operator==(const LinkedStack<T, Alloc> &s) const
 {
     // se le pile sono entrambe vuote, allora sono uguali
     if (isEmpty() && s.isEmpty())
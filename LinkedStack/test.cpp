@@ -58,6 +58,14 @@ int main()
     else
         cout << "false\n";
 
+    // iteratori: range-for
+    stack3.push(46);
+    cout << "\nITERATORI\nElementi di 'stack3' (dal fondo alla cima)"
+         << " con range-for: ";
+    for (int x : stack3.items())
+        cout << x << " ";
+    cout << "\n";
+
     // mantiene aperto il terminale
     int x;
     cout << "\npremere un tasto per continuare...";
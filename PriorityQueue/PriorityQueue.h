@@ -1,5 +1,7 @@
 // By Fabio Nardelli
-// coda con priorita' di tipo min-priority-queue basata su heap 
+// coda con priorita' di tipo min-priority-queue basata su heap.
+// Crescita e contrazione del vettore seguono la politica Growth
+// (vedi Utils/GrowthPolicy.h).
 
 #ifndef PRIORITY_QUEUE_H
 #define PRIORITY_QUEUE_H
@@ -7,25 +9,26 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
+#include "../Utils/GrowthPolicy.h"
 
-template <typename T>
+template <typename T, typename Growth = DefaultGrowth>
 class PriorityQueue;
 
-template <typename T>
-std::ostream &operator<<(std::ostream &, const PriorityQueue<T> &);
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &, const PriorityQueue<T, Growth> &);
 
-template <typename T>
+template <typename T, typename Growth>
 class PriorityQueue {
-    friend std::ostream &operator<< <>(std::ostream &, const PriorityQueue<T> &);
+    friend std::ostream &operator<< <>(std::ostream &, const PriorityQueue<T, Growth> &);
 public:
     // costruttore di default
     PriorityQueue(int c = defaultCapacity) : size(0) { create(c); }
     // costruttore per copia
-    PriorityQueue(const PriorityQueue<T> &);
+    PriorityQueue(const PriorityQueue<T, Growth> &);
     // distruttore
     ~PriorityQueue() { delete [] heap; }
     // overload dell'operatore di assegnamento =
-    PriorityQueue<T> &operator=(const PriorityQueue<T> &);
+    PriorityQueue<T, Growth> &operator=(const PriorityQueue<T, Growth> &);
 
     // operatori
 
@@ -43,6 +46,12 @@ public:
     void decrease(const T &, int p);
     // stampa il contenuto della coda
     void print() const;
+    // restituisce la capacita' del vettore
+    int getCapacity() const { return capacity; }
+    // porta la capacita' del vettore ad almeno n elementi
+    void reserve(int n) { if (n > capacity) resize(n); }
+    // riduce la capacita' del vettore al numero di elementi contenuti
+    void shrinkToFit() { if (size < capacity) resize(size > 0 ? size : 1); }
 private:
 
     struct PriorityItem { // struttura per rappresentare un elemento
@@ -72,30 +81,24 @@ private:
 
     // funzione per modificare le dimensioni dello heap
     void resize(int);
-
-    // soglia di fattore di carico per dimezzare il vettore
-    static const float minLoadFactor;
 };
 
-template <typename T>
-const float PriorityQueue<T>::minLoadFactor = .25;
-
 
 /*===========================================================================*/
 /*                           DEFINIZIONI FUNZIONI                            */
 /*===========================================================================*/
 
 // overload dell'operatore di inserimento <<
-template <typename T>
-std::ostream &operator<<(std::ostream &output, const PriorityQueue<T> &h)
+template <typename T, typename Growth>
+std::ostream &operator<<(std::ostream &output, const PriorityQueue<T, Growth> &h)
 {
     h.print();
     return output; // consente a << b << c
 }
 
 // crea una coda di priorita' vuota
-template <typename T>
-void PriorityQueue<T>::create(int c)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::create(int c)
 {
     if (c > 0)
         capacity = c;
@@ -104,8 +107,8 @@ void PriorityQueue<T>::create(int c)
 }
 
 // costruttore per copia
-template <typename T>
-PriorityQueue<T>::PriorityQueue(const PriorityQueue<T> &h)
+template <typename T, typename Growth>
+PriorityQueue<T, Growth>::PriorityQueue(const PriorityQueue<T, Growth> &h)
 {
     capacity = h.capacity;
     size = h.size;
@@ -116,8 +119,8 @@ PriorityQueue<T>::PriorityQueue(const PriorityQueue<T> &h)
 }
 
 // overload dell'operatore di assegnamento =
-template <typename T>
-PriorityQueue<T> &PriorityQueue<T>::operator=(const PriorityQueue<T> &h)
+template <typename T, typename Growth>
+PriorityQueue<T, Growth> &PriorityQueue<T, Growth>::operator=(const PriorityQueue<T, Growth> &h)
 {
     if (&h != this) { // evita l'autoassegnazione
         if (capacity != h.capacity) { // se i due array hanno capacita'
@@ -138,8 +141,8 @@ PriorityQueue<T> &PriorityQueue<T>::operator=(const PriorityQueue<T> &h)
 }
 
 // utility function per scambiare due elementi dello heap
-template <typename T>
-void PriorityQueue<T>::swap(int i, int j)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::swap(int i, int j)
 {
     PriorityItem temp = heap[i];
     heap[i] = heap[j];
@@ -153,8 +156,8 @@ void PriorityQueue<T>::swap(int i, int j)
 // utility function per modificare le dimensioni del vettore. Alloca un
 // nuovo vettore di dimensioni newCapacity e copia il contenuto del vecchio
 // vettore nel nuovo, dopodiche' cancella il vecchio vettore.
-template <typename T>
-void PriorityQueue<T>::resize(int newCapacity)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::resize(int newCapacity)
 {
     if (newCapacity <= 0)
         throw std::invalid_argument("newCapacity must be > 0!");
@@ -169,12 +172,12 @@ void PriorityQueue<T>::resize(int newCapacity)
 }
 
 // inserisce un elemento nella coda
-template <typename T>
-void PriorityQueue<T>::insert(T value, int p)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::insert(T value, int p)
 {
-    // se non c'e' spazio nel vettore, raddoppia le dimensioni
+    // se non c'e' spazio nel vettore, lo fa crescere
     if (size == capacity)
-        resize(capacity * 2);
+        resize(Growth::grow(capacity));
 
     heap[size].value = value;
     heap[size].priority = p;
@@ -190,8 +193,8 @@ void PriorityQueue<T>::insert(T value, int p)
 }
 
 // restituisce il minimo (senza cancellarlo)
-template <typename T>
-const T&PriorityQueue<T>::min() const
+template <typename T, typename Growth>
+const T&PriorityQueue<T, Growth>::min() const
 {
     if (isEmpty())
         throw std::domain_error("Queue is Empty!");
@@ -200,8 +203,8 @@ const T&PriorityQueue<T>::min() const
 }
 
 // ripristina la proprieta' min-heap
-template <typename T>
-void PriorityQueue<T>::minHeapRestore(int i)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::minHeapRestore(int i)
 {
     // indice dell'elemento con la priorita' piu' bassa
     int min = i;  // inizialmente indica il nodo passato per parametro
@@ -224,8 +227,8 @@ void PriorityQueue<T>::minHeapRestore(int i)
 }
 
 // cancella l'elemento con la priorita' piu' bassa (la radice)
-template <typename T>
-void PriorityQueue<T>::deleteMin()
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::deleteMin()
 {
     if (isEmpty()) {
         std::cerr << "Cannot delete: Queue is empty!\n";
@@ -236,15 +239,15 @@ void PriorityQueue<T>::deleteMin()
     --size;
     minHeapRestore(0);
 
-    // se il fattore di carico raggiunge la soglia minLoadFactor
-    // (di default 1/4), dimezza le dimensioni del vettore
-    if (static_cast<float>(size) / capacity <= minLoadFactor)
-        resize(capacity / 2);
+    // se il fattore di carico raggiunge la soglia prevista dalla politica
+    // Growth (di default 1/4), contrae il vettore
+    if (Growth::shouldShrink(size, capacity, defaultCapacity))
+        resize(Growth::shrink(capacity, defaultCapacity));
 }
 
 // diminuisce la priorita' dell'elemento indicato portandola a p
-template <typename T>
-void PriorityQueue<T>::decrease(const T &value, int p)
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::decrease(const T &value, int p)
 {
     // cerca l'elemento al quale diminuire la priorita'
     int i = 0;
@@ -264,8 +267,8 @@ void PriorityQueue<T>::decrease(const T &value, int p)
 }
 
 // stampa la coda. Gli elementi sono mostrati nel formato (valore, priorita')
-template <typename T>
-void PriorityQueue<T>::print() const
+template <typename T, typename Growth>
+void PriorityQueue<T, Growth>::print() const
 {
     if (isEmpty()) {
         std::cerr << "Queue is empty!\n";
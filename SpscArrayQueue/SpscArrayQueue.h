@@ -0,0 +1,344 @@
+// By Fabio Nardelli
+// coda FIFO a singolo produttore e singolo consumatore (SPSC), senza lock.
+// Come ArrayQueue usa un vettore circolare di capacita' pari a una potenza
+// di 2, ma puo' essere usata da due thread contemporaneamente: un thread
+// (il produttore) inserisce gli elementi, un altro (il consumatore) li
+// rimuove. Non cresce: se il vettore e' pieno, enqueue restituisce false.
+// head e tail sono contatori che crescono sempre (la posizione nel vettore
+// si ottiene con la maschera); ciascuno e' scritto da un solo thread, con
+// semantica release, e letto dall'altro con semantica acquire. I due indici
+// si trovano su linee di cache diverse, e ogni thread tiene una copia locale
+// dell'indice dell'altro, che rilegge solo quando la coda gli sembra piena
+// (o vuota): in questo modo la linea di cache dell'altro thread viene
+// trasferita solo quando e' necessario.
+// Le funzioni enqueue/enqueueN possono essere chiamate solo dal produttore,
+// dequeue/dequeueN/tryDequeue/top solo dal consumatore; print e le
+// funzioni che leggono la dimensione danno un risultato esatto solo
+// quando nessuno dei due thread sta modificando la coda.
+
+#ifndef SPSC_ARRAY_QUEUE_H
+#define SPSC_ARRAY_QUEUE_H
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+template <typename T>
+class SpscArrayQueue;
+
+template <typename T>
+std::ostream &operator<<(std::ostream &, const SpscArrayQueue<T> &);
+
+template <typename T>
+class SpscArrayQueue {
+    friend std::ostream &operator<< <>(std::ostream &,
+        const SpscArrayQueue<T> &);
+public:
+    SpscArrayQueue(int c = defaultCapacity);
+    ~SpscArrayQueue() { delete [] array; } // distruttore
+    // la coda e' condivisa fra due thread: non puo' essere copiata
+    SpscArrayQueue(const SpscArrayQueue<T> &) = delete;
+    SpscArrayQueue<T> &operator=(const SpscArrayQueue<T> &) = delete;
+
+    // operatori
+    // restituisce "true" se la coda e' vuota, "false" altrimenti
+    bool isEmpty() const { return getSize() == 0; }
+    // restituisce il numero di elementi contenuti nella coda
+    int getSize() const;
+    // restituisce la capacita' della coda
+    int getCapacity() const { return capacity; }
+    void print() const; // stampa la coda
+    // inserisce un elemento in coda (produttore). Restituisce
+    // false, senza inserire l'elemento, se la coda e' piena
+    bool enqueue(const T &);
+    bool enqueue(T &&);
+    // inserisce in coda fino a n elementi del vettore indicato (produttore)
+    // e li rende visibili al consumatore tutti insieme.
+    // Restituisce il numero di elementi inseriti
+    int enqueueN(const T *, int n);
+    // elimina l'elemento da piu' tempo in coda (consumatore).
+    // Restituisce false se la coda e' vuota
+    bool dequeue();
+    // sposta in item l'elemento da piu' tempo in coda e lo elimina
+    // (consumatore). Restituisce false se la coda e' vuota
+    bool tryDequeue(T &item);
+    // rimuove fino a n elementi dalla testa della coda e li sposta nel
+    // vettore indicato (consumatore). Restituisce il numero di elementi rimossi
+    int dequeueN(T *, int n);
+    T top() const; // legge l'elemento da piu' tempo in coda (consumatore)
+
+private:
+    static const std::size_t cacheLine = 64; // dimensione di una linea di cache
+    static const int defaultCapacity = 1024; // dimensione di default
+
+    // dati condivisi, scritti solo dal costruttore
+    T *array; // vettore circolare
+    int capacity; // dimensione del vettore (potenza di 2)
+    std::size_t mask; // capacity - 1
+
+    // dati del consumatore: indice della testa e copia locale della coda
+    alignas(cacheLine) std::atomic<std::size_t> head;
+    mutable std::size_t cachedTail;
+
+    // dati del produttore: indice della coda e copia locale della testa
+    alignas(cacheLine) std::atomic<std::size_t> tail;
+    std::size_t cachedHead;
+    // (l'allineamento di tail rende la dimensione dell'oggetto multipla di
+    // una linea di cache, per cui tail non condivide la linea con i dati
+    // che seguono l'oggetto in memoria)
+
+    // restituisce la piu' piccola potenza di 2 maggiore o uguale a c
+    static int roundCapacity(int c);
+    // copiano o spostano n elementi contigui da src a dest: per i tipi
+    // banalmente copiabili usano memcpy
+    static void copySpan(const T *src, int n, T *dest, std::true_type);
+    static void copySpan(const T *src, int n, T *dest, std::false_type);
+    static void copySpan(const T *src, int n, T *dest)
+        { copySpan(src, n, dest, std::is_trivially_copyable<T>()); }
+    static void moveSpan(T *src, int n, T *dest, std::true_type);
+    static void moveSpan(T *src, int n, T *dest, std::false_type);
+    static void moveSpan(T *src, int n, T *dest)
+        { moveSpan(src, n, dest, std::is_trivially_copyable<T>()); }
+    // restituiscono il numero di posizioni libere (produttore) e di
+    // elementi presenti (consumatore), rileggendo l'indice dell'altro
+    // thread solo se la copia locale non ne garantisce almeno n
+    std::size_t freeSlots(std::size_t t, std::size_t n);
+    std::size_t usedSlots(std::size_t h, std::size_t n) const;
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T>
+std::ostream &operator<<(std::ostream &output, const SpscArrayQueue<T> &q)
+{
+    q.print();
+    return output; // consente cout << a << b << c
+}
+
+// costruttore: la capacita' viene arrotondata alla potenza di 2 successiva
+template <typename T>
+SpscArrayQueue<T>::SpscArrayQueue(int c)
+    : capacity(roundCapacity(c > 0 ? c : defaultCapacity)),
+      mask(capacity - 1), head(0), cachedTail(0), tail(0), cachedHead(0)
+{
+    array = new T[capacity];
+}
+
+// restituisce la piu' piccola potenza di 2 maggiore o uguale a c
+template <typename T>
+int SpscArrayQueue<T>::roundCapacity(int c)
+{
+    int r = 1;
+    while (r < c)
+        r <<= 1;
+    return r;
+}
+
+// copia per i tipi banalmente copiabili
+template <typename T>
+void SpscArrayQueue<T>::copySpan(const T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// copia per i tipi generici
+template <typename T>
+void SpscArrayQueue<T>::copySpan(const T *src, int n, T *dest, std::false_type)
+{
+    std::copy(src, src + n, dest);
+}
+
+// spostamento per i tipi banalmente copiabili
+template <typename T>
+void SpscArrayQueue<T>::moveSpan(T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memcpy(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// spostamento per i tipi generici
+template <typename T>
+void SpscArrayQueue<T>::moveSpan(T *src, int n, T *dest, std::false_type)
+{
+    std::move(src, src + n, dest);
+}
+
+// restituisce il numero di elementi contenuti nella coda
+template <typename T>
+int SpscArrayQueue<T>::getSize() const
+{
+    // legge prima head: tail non puo' essere minore di un valore
+    // di head letto in precedenza
+    std::size_t h = head.load(std::memory_order_acquire);
+    std::size_t t = tail.load(std::memory_order_acquire);
+    return static_cast<int>(t - h);
+}
+
+// stampa la coda
+template <typename T>
+void SpscArrayQueue<T>::print() const
+{
+    std::size_t h = head.load(std::memory_order_acquire);
+    std::size_t t = tail.load(std::memory_order_acquire);
+
+    if (h == t) {
+        std::cout << "\n Queue is empty!\n";
+        return;
+    }
+
+    std::cout << "\n [";
+
+    for (std::size_t i = h; i != t; ++i) {
+        std::cout << std::setw(3) << array[i & mask] << " ";
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if ((i - h + 1) % 5 == 0 && i + 1 != t)
+            std::cout << "\n  ";
+    }
+    std::cout << " ]\n";
+}
+
+// restituisce il numero di posizioni libere, rileggendo head solo se la
+// copia locale indica meno di n posizioni libere (produttore)
+template <typename T>
+std::size_t SpscArrayQueue<T>::freeSlots(std::size_t t, std::size_t n)
+{
+    std::size_t slots = capacity - (t - cachedHead);
+    if (slots < n) {
+        // l'acquire garantisce che il consumatore abbia finito di
+        // leggere le posizioni che sta per liberare
+        cachedHead = head.load(std::memory_order_acquire);
+        slots = capacity - (t - cachedHead);
+    }
+    return slots;
+}
+
+// restituisce il numero di elementi presenti, rileggendo tail solo se la
+// copia locale indica meno di n elementi (consumatore)
+template <typename T>
+std::size_t SpscArrayQueue<T>::usedSlots(std::size_t h, std::size_t n) const
+{
+    std::size_t used = cachedTail - h;
+    if (used < n) {
+        // l'acquire garantisce che gli elementi pubblicati dal
+        // produttore siano visibili
+        cachedTail = tail.load(std::memory_order_acquire);
+        used = cachedTail - h;
+    }
+    return used;
+}
+
+// inserisce un elemento in coda
+template <typename T>
+bool SpscArrayQueue<T>::enqueue(const T &item)
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if (freeSlots(t, 1) == 0)
+        return false;
+
+    array[t & mask] = item;
+    tail.store(t + 1, std::memory_order_release); // pubblica l'elemento
+    return true;
+}
+
+// come sopra, ma sposta l'elemento indicato invece di copiarlo
+template <typename T>
+bool SpscArrayQueue<T>::enqueue(T &&item)
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if (freeSlots(t, 1) == 0)
+        return false;
+
+    array[t & mask] = std::move(item);
+    tail.store(t + 1, std::memory_order_release); // pubblica l'elemento
+    return true;
+}
+
+// inserisce fino a n elementi, copiandoli in al piu' due blocchi contigui,
+// e li pubblica con un'unica scrittura di tail
+template <typename T>
+int SpscArrayQueue<T>::enqueueN(const T *items, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    int k = static_cast<int>(std::min<std::size_t>(n, freeSlots(t, n)));
+    if (k == 0)
+        return 0;
+
+    int pos = static_cast<int>(t & mask);
+    int first = std::min(k, capacity - pos);
+    copySpan(items, first, array + pos);
+    copySpan(items + first, k - first, array);
+    tail.store(t + k, std::memory_order_release); // pubblica gli elementi
+    return k;
+}
+
+// elimina l'elemento da piu' tempo in coda
+template <typename T>
+bool SpscArrayQueue<T>::dequeue()
+{
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (usedSlots(h, 1) == 0)
+        return false;
+
+    head.store(h + 1, std::memory_order_release); // libera la posizione
+    return true;
+}
+
+// sposta in item l'elemento da piu' tempo in coda e lo elimina
+template <typename T>
+bool SpscArrayQueue<T>::tryDequeue(T &item)
+{
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (usedSlots(h, 1) == 0)
+        return false;
+
+    item = std::move(array[h & mask]);
+    head.store(h + 1, std::memory_order_release); // libera la posizione
+    return true;
+}
+
+// rimuove fino a n elementi, spostandoli in out in al piu' due blocchi
+// contigui, e libera le posizioni con un'unica scrittura di head
+template <typename T>
+int SpscArrayQueue<T>::dequeueN(T *out, int n)
+{
+    if (n <= 0)
+        return 0;
+
+    std::size_t h = head.load(std::memory_order_relaxed);
+    int k = static_cast<int>(std::min<std::size_t>(n, usedSlots(h, n)));
+    if (k == 0)
+        return 0;
+
+    int pos = static_cast<int>(h & mask);
+    int first = std::min(k, capacity - pos);
+    moveSpan(array + pos, first, out);
+    moveSpan(array, k - first, out + first);
+    head.store(h + k, std::memory_order_release); // libera le posizioni
+    return k;
+}
+
+// legge il dato contenuto nell'elemento di testa
+template <typename T>
+T SpscArrayQueue<T>::top() const
+{
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (usedSlots(h, 1) == 0)
+        throw std::domain_error("Queue is empty!");
+
+    return array[h & mask];
+}
+
+#endif
@@ -0,0 +1,146 @@
+// benchmark di SpscArrayQueue: un thread produttore e un thread consumatore
+// si scambiano n interi. Confronta la coda senza lock (un elemento alla
+// volta e a blocchi) con una ArrayQueue protetta da un mutex.
+// Su Linux i due thread vengono fissati su due core diversi.
+// Compilare con -pthread.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include "SpscArrayQueue.h"
+#include "../ArrayQueue/ArrayQueue.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+using std::cout;
+
+// fissa il thread corrente sul core indicato (solo su Linux)
+void pinThread(int core)
+{
+#ifdef __linux__
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores < 2)
+        return; // con un solo core i thread si alternano comunque
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+// esegue producer e consumer su due thread e restituisce
+// il numero di milioni di elementi trasferiti al secondo
+template <typename P, typename C>
+double throughput(P producer, C consumer, int n)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    std::thread t([&consumer]() { pinThread(1); consumer(); });
+    pinThread(0);
+    producer();
+    t.join();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return n / std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+// un elemento alla volta
+double spscSingle(int n)
+{
+    SpscArrayQueue<int> q(4096);
+    long long sum = 0;
+    return throughput([&q, n]() {
+        for (int i = 0; i < n; ++i)
+            while (!q.enqueue(i))
+                std::this_thread::yield();
+    }, [&q, &sum, n]() {
+        int x;
+        for (int i = 0; i < n; ) {
+            if (q.tryDequeue(x)) {
+                sum += x;
+                ++i;
+            } else
+                std::this_thread::yield();
+        }
+    }, n);
+}
+
+// blocchi di 64 elementi
+double spscBatch(int n)
+{
+    const int batch = 64;
+    SpscArrayQueue<int> q(4096);
+    long long sum = 0;
+    return throughput([&q, n]() {
+        int buf[batch];
+        for (int i = 0; i < n; ) {
+            int k = (n - i < batch ? n - i : batch);
+            for (int j = 0; j < k; ++j)
+                buf[j] = i + j;
+            int done = 0;
+            while (done < k) {
+                int m = q.enqueueN(buf + done, k - done);
+                if (m == 0)
+                    std::this_thread::yield();
+                done += m;
+            }
+            i += k;
+        }
+    }, [&q, &sum, n]() {
+        int buf[batch];
+        for (int i = 0; i < n; ) {
+            int k = q.dequeueN(buf, batch);
+            if (k == 0)
+                std::this_thread::yield();
+            for (int j = 0; j < k; ++j)
+                sum += buf[j];
+            i += k;
+        }
+    }, n);
+}
+
+// ArrayQueue protetta da un mutex
+double mutexQueue(int n)
+{
+    ArrayQueue<int> q(4096);
+    std::mutex m;
+    long long sum = 0;
+    return throughput([&q, &m, n]() {
+        for (int i = 0; i < n; ++i) {
+            std::lock_guard<std::mutex> lock(m);
+            q.enqueue(i);
+        }
+    }, [&q, &m, &sum, n]() {
+        for (int i = 0; i < n; ) {
+            std::unique_lock<std::mutex> lock(m);
+            if (!q.isEmpty()) {
+                sum += q.top();
+                q.dequeue();
+                ++i;
+            } else {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    }, n);
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK SpscArrayQueue **************\n\n";
+    cout << "elementi trasferiti fra due thread (milioni/s)\n\n";
+    cout << std::setw(10) << "n" << std::setw(12) << "Spsc"
+         << std::setw(12) << "Spsc x64" << std::setw(12) << "mutex" << "\n";
+
+    for (int n = 1 << 18; n <= 1 << 22; n <<= 2)
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1)
+             << std::setw(12) << spscSingle(n) << std::setw(12) << spscBatch(n)
+             << std::setw(12) << mutexQueue(n) << "\n";
+
+    return 0;
+}
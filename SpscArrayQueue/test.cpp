@@ -0,0 +1,72 @@
+#include <iostream>
+#include <thread>
+#include "SpscArrayQueue.h"
+using std::cout;
+
+int main()
+{
+    SpscArrayQueue<int> queue(8);
+
+    cout << "\n************** TEST CLASSE SpscArrayQueue **************\n\n";
+
+    // stampa una coda vuota
+    cout << "Crea e tenta di stampare una coda vuota:\n";
+    queue.print();
+
+    // inserimenti fino a riempire la coda
+    int i = 1;
+    while (queue.enqueue(i))
+        ++i;
+    cout << "\nFUNZIONE enqueue:\ninserisce elementi fino a riempire la coda "
+         << "(capacita' " << queue.getCapacity() << ").\nL'inserimento "
+         << "dell'elemento " << i << " restituisce false\n" << queue;
+
+    // lettura e rimozione
+    int item;
+    cout << "\nFUNZIONI top, dequeue E tryDequeue\ntop(): " << queue.top();
+    queue.dequeue();
+    queue.tryDequeue(item);
+    cout << "\nrimossi due elementi, tryDequeue ha restituito " << item
+         << queue;
+
+    // inserimento e rimozione di piu' elementi alla volta
+    int in[4] = { 10, 11, 12, 13 };
+    int out[8];
+    int n = queue.enqueueN(in, 4);
+    cout << "\nFUNZIONI enqueueN E dequeueN\nenqueueN di 4 elementi, inseriti: "
+         << n << queue;
+    n = queue.dequeueN(out, 8);
+    cout << "dequeueN di 8 elementi, rimossi: " << n << " ->";
+    for (int j = 0; j < n; ++j)
+        cout << " " << out[j];
+    cout << queue;
+
+    // un produttore e un consumatore su due thread
+    const int count = 1000000;
+    long long sum = 0;
+    bool ordered = true;
+    std::thread consumer([&queue, &sum, &ordered, count]() {
+        int expected = 0, x;
+        while (expected < count) {
+            if (queue.tryDequeue(x)) {
+                ordered = ordered && x == expected;
+                sum += x;
+                ++expected;
+            } else
+                std::this_thread::yield(); // coda vuota: cede il processore
+        }
+    });
+    for (int j = 0; j < count; ++j)
+        while (!queue.enqueue(j))
+            std::this_thread::yield(); // coda piena: cede il processore
+    consumer.join();
+    cout << "\nDUE THREAD\nil produttore inserisce 0.." << count - 1
+         << ", il consumatore li rimuove\nsomma: " << sum << " (attesa "
+         << (long long)count * (count - 1) / 2 << "), ordine rispettato: "
+         << (ordered ? "true" : "false") << "\n";
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+}
\ No newline at end of file
@@ -0,0 +1,560 @@
+// By Fabio Nardelli
+// lista "srotolata" (unrolled linked list) doppiamente concatenata con
+// sentinella: ogni nodo contiene un vettore di al massimo N elementi
+// contigui, per cui la scansione sequenziale legge un nodo (e quindi una
+// nuova riga di cache) ogni N elementi invece che uno per elemento.
+// Un nodo pieno viene diviso a meta' quando vi si inserisce un elemento;
+// un nodo che scende sotto N/2 elementi dopo una rimozione prende un
+// elemento dal nodo successivo o viene fuso con esso (o con il precedente,
+// se e' l'ultimo nodo).
+// Una posizione e' formata dal nodo e dall'indice dell'elemento nel nodo:
+// resta valida finche' non si inseriscono o rimuovono elementi nello stesso
+// nodo o in uno dei nodi adiacenti (che possono essere divisi o fusi).
+// Per questo insert e remove restituiscono una posizione valida.
+
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "../Utils/Range.h"
+
+// di default un nodo contiene circa 256 byte di elementi (4 righe di
+// cache), e almeno 8 elementi per i tipi grandi
+template <typename T, int N = (sizeof(T) < 32
+    ? static_cast<int>(256 / sizeof(T)) : 8)>
+class UnrolledLinkedList;
+
+template <typename T, int N>
+std::ostream &operator<<(std::ostream &, const UnrolledLinkedList<T, N> &);
+
+template <typename T, int N>
+class UnrolledLinkedList {
+    static_assert(N >= 2, "A node must hold at least 2 items");
+    friend std::ostream &operator<< <>(std::ostream &,
+        const UnrolledLinkedList<T, N> &);
+private:
+    struct Node;
+    template <typename V> class BasicIterator;
+public:
+    // posizione di un elemento: nodo che lo contiene e indice nel nodo
+    struct Position {
+        Node *node;
+        int index;
+
+        Position() : node(0), index(0) { }
+        Position(Node *n, int i) : node(n), index(i) { }
+        bool operator==(const Position &p) const
+            { return node == p.node && index == p.index; }
+        bool operator!=(const Position &p) const { return !(*this == p); }
+    };
+    // iteratori bidirezionali
+    typedef BasicIterator<T> iterator;
+    typedef BasicIterator<const T> const_iterator;
+
+    UnrolledLinkedList() : size(0) { create(); } // costruttore di default
+    // costruttore per copia
+    UnrolledLinkedList(const UnrolledLinkedList<T, N> &);
+    ~UnrolledLinkedList(); // distruttore
+    UnrolledLinkedList<T, N> &operator=(const UnrolledLinkedList<T, N> &);
+
+    // operatori
+    // restituisce "true" se la lista e' vuota, "false" altrimenti
+    bool isEmpty() const { return size == 0; }
+    // restituisce il numero di elementi contenuti nella lista
+    int getSize() const { return size; }
+    void print() const; // stampa la lista
+    // inserisce un elemento in coda
+    void pushBack(T item) { insert(Position(head, 0), std::move(item)); }
+    // inserisce un elemento in testa
+    void pushFront(T item) { insert(begin(), std::move(item)); }
+    // inserisce un elemento nella posizione precedente quella indicata e
+    // restituisce la posizione dell'elemento inserito
+    Position insert(Position, T);
+    void popBack(); // rimuove l'elemento in coda
+    void popFront(); // rimuove l'elemento in testa
+    void clear(); // rimuove tutti gli elementi
+    // rimuove l'elemento nella posizione indicata e restituisce
+    // la posizione dell'elemento successivo
+    Position remove(Position);
+    // sposta la posizione all'elemento successivo
+    Position next(Position pos) const
+    {
+        return pos.index + 1 < pos.node->count
+            ? Position(pos.node, pos.index + 1) : Position(pos.node->next, 0);
+    }
+    // sposta la posizione all'elemento precedente
+    Position previous(Position pos) const
+    {
+        return pos.index > 0 ? Position(pos.node, pos.index - 1)
+            : Position(pos.node->previous, pos.node->previous->count - 1);
+    }
+    Position search(const T &) const;
+    // restituisce la posizione del primo elemento
+    Position begin() const { return Position(head->next, 0); }
+    // restituisce la posizione dell'ultimo elemento
+    Position end() const
+        { return Position(head->previous, head->previous->count - 1); }
+    // restituisce "true" se la posizione indicata si riferisce
+    // alla fine della lista (sentinella), "false" altrimenti
+    bool finished(Position pos) const { return pos.node == head; }
+    // legge il dato nella posizione indicata
+    const T &read(Position) const;
+    // scrive nella posizione indicata
+    void write(Position, const T &);
+    bool operator==(const UnrolledLinkedList<T, N> &) const;
+
+    // iteratori compatibili con la libreria standard: ibegin() indica il
+    // primo elemento, iend() la sentinella. Non effettuano controlli
+    iterator ibegin() { return iterator(head->next, 0); }
+    iterator iend() { return iterator(head, 0); }
+    const_iterator ibegin() const { return const_iterator(head->next, 0); }
+    const_iterator iend() const { return const_iterator(head, 0); }
+    // consente di scandire la lista con un ciclo range-for
+    Range<iterator> items() { return Range<iterator>(ibegin(), iend()); }
+    Range<const_iterator> items() const
+        { return Range<const_iterator>(ibegin(), iend()); }
+private:
+
+    // rappresenta un generico nodo. Gli elementi occupano le prime count
+    // celle del vettore items; la sentinella non contiene elementi
+    struct Node {
+        Node *next; // puntatore al nodo successivo
+        Node *previous; // puntatore al nodo precedente
+        int count; // numero di elementi contenuti nel nodo
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type items[N];
+
+        // restituisce l'elemento i-esimo del nodo
+        T *at(int i) { return reinterpret_cast<T *>(items + i); }
+        const T *at(int i) const
+            { return reinterpret_cast<const T *>(items + i); }
+    };
+
+    Node *head; // puntatore al primo nodo (sentinella) della lista
+    int size; // numero di elementi contenuti nella lista
+
+    void create(); // crea una lista vuota
+    // crea un nodo vuoto e lo collega dopo il nodo indicato
+    Node *linkAfter(Node *);
+    // scollega un nodo (gia' vuoto) dalla lista e ne libera la memoria
+    void unlink(Node *);
+    // divide a meta' un nodo pieno, spostando la seconda meta' degli
+    // elementi in un nuovo nodo successivo
+    void split(Node *);
+    // riequilibra un nodo rimasto con meno di N/2 elementi. pos e' la
+    // posizione di un elemento del nodo o quella che lo segue, e viene
+    // aggiornata se l'elemento cambia nodo
+    void rebalance(Position &pos);
+    // sposta n elementi da src in celle non inizializzate a partire da
+    // dest. I due intervalli possono sovrapporsi. Per i tipi copiabili
+    // banalmente si usa memmove, altrimenti costruttore di spostamento
+    // e distruttore elemento per elemento
+    static void relocate(T *src, int n, T *dest, std::true_type);
+    static void relocate(T *src, int n, T *dest, std::false_type);
+    static void relocate(T *src, int n, T *dest)
+        { relocate(src, n, dest, std::is_trivially_copyable<T>()); }
+};
+
+// iteratore bidirezionale: memorizza il nodo e l'indice nel nodo, come
+// Position. L'iteratore alla sentinella e' quello di fine sequenza
+template <typename T, int N>
+template <typename V>
+class UnrolledLinkedList<T, N>::BasicIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_cv<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    BasicIterator() : node(0), index(0) { }
+    BasicIterator(Node *n, int i) : node(n), index(i) { }
+    // conversione da iteratore a iteratore costante
+    operator BasicIterator<const V>() const
+        { return BasicIterator<const V>(node, index); }
+
+    reference operator*() const { return *node->at(index); }
+    pointer operator->() const { return node->at(index); }
+
+    BasicIterator &operator++()
+    {
+        if (++index == node->count) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+    BasicIterator operator++(int)
+        { BasicIterator old(*this); ++*this; return old; }
+    BasicIterator &operator--()
+    {
+        if (index-- == 0) {
+            node = node->previous;
+            index = node->count - 1;
+        }
+        return *this;
+    }
+    BasicIterator operator--(int)
+        { BasicIterator old(*this); --*this; return old; }
+
+    bool operator==(const BasicIterator &it) const
+        { return node == it.node && index == it.index; }
+    bool operator!=(const BasicIterator &it) const { return !(*this == it); }
+private:
+    Node *node; // nodo corrente
+    int index; // indice dell'elemento nel nodo
+};
+
+/*===========================================================================*/
+/*                           DEFINIZIONI FUNZIONI                            */
+/*===========================================================================*/
+
+// overload dell'operatore di inserimento <<
+template <typename T, int N>
+std::ostream &operator<<(std::ostream &output, const UnrolledLinkedList<T, N> &l)
+{
+    l.print();
+    return output; // consente cout << a << b << c
+}
+
+// crea una lista vuota, munita di sentinella (nodo head).
+// E' chiamata dai costruttori
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::create()
+{
+    head = static_cast<Node *>(::operator new(sizeof(Node)));
+    head->next = head;
+    head->previous = head;
+    head->count = 0;
+}
+
+// costruttore per copia: gli elementi vengono copiati in nodi pieni
+template <typename T, int N>
+UnrolledLinkedList<T, N>::UnrolledLinkedList(const UnrolledLinkedList<T, N> &l)
+    : size(0)
+{
+    create();
+    try {
+        for (const_iterator it = l.ibegin(); it != l.iend(); ++it)
+            pushBack(*it);
+    } catch (...) {
+        clear();
+        ::operator delete(head);
+        throw;
+    }
+}
+
+// distruttore
+template <typename T, int N>
+UnrolledLinkedList<T, N>::~UnrolledLinkedList()
+{
+    clear();
+    ::operator delete(head);
+}
+
+// rimuove tutti gli elementi
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::clear()
+{
+    Node *current = head->next;
+    while (current != head) {
+        Node *next = current->next;
+        for (int i = 0; i < current->count; ++i)
+            current->at(i)->~T();
+        ::operator delete(current);
+        current = next;
+    }
+    head->next = head;
+    head->previous = head;
+    size = 0;
+}
+
+// spostamento per i tipi copiabili banalmente
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::relocate(T *src, int n, T *dest, std::true_type)
+{
+    if (n > 0)
+        std::memmove(static_cast<void *>(dest), src, n * sizeof(T));
+}
+
+// spostamento per i tipi generici, elemento per elemento. Il verso della
+// copia dipende da quello dello spostamento, in modo da non sovrascrivere
+// elementi non ancora spostati quando i due intervalli si sovrappongono
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::relocate(T *src, int n, T *dest, std::false_type)
+{
+    if (dest < src) {
+        for (int i = 0; i < n; ++i) {
+            new (dest + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    } else {
+        for (int i = n - 1; i >= 0; --i) {
+            new (dest + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+// crea un nodo vuoto e lo collega dopo il nodo indicato
+template <typename T, int N>
+typename UnrolledLinkedList<T, N>::Node *
+    UnrolledLinkedList<T, N>::linkAfter(Node *node)
+{
+    Node *newNode = static_cast<Node *>(::operator new(sizeof(Node)));
+    newNode->count = 0;
+    newNode->previous = node;
+    newNode->next = node->next;
+    node->next->previous = newNode;
+    node->next = newNode;
+    return newNode;
+}
+
+// scollega un nodo vuoto dalla lista e ne libera la memoria
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::unlink(Node *node)
+{
+    node->previous->next = node->next;
+    node->next->previous = node->previous;
+    ::operator delete(node);
+}
+
+// divide un nodo pieno: i primi N/2 elementi restano nel nodo,
+// gli altri vengono spostati in un nuovo nodo successivo
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::split(Node *node)
+{
+    Node *newNode = linkAfter(node);
+    const int half = N / 2;
+    relocate(node->at(half), node->count - half, newNode->at(0));
+    newNode->count = node->count - half;
+    node->count = half;
+}
+
+// stampa la lista
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::print() const
+{
+    if (isEmpty()) {
+        std::cout << "\n List is empty!\n";
+        return;
+    }
+
+    std::cout << "\n [";
+    int i = 0;
+    for (const_iterator it = ibegin(); it != iend(); ++it) {
+        std::cout << std::setw(3) << *it << " ";
+        // va a capo ogni 5 elementi, tranne dopo l'ultimo
+        if ((i + 1) % 5 == 0 && i + 1 != size)
+            std::cout << "\n  ";
+        ++i;
+    }
+    std::cout << " ]\n";
+}
+
+// inserisce un elemento nella posizione precedente a quella indicata.
+// Se la posizione e' la sentinella l'elemento viene inserito in coda
+// all'ultimo nodo; se e' la prima di un nodo e il nodo precedente non e'
+// pieno, l'elemento viene inserito in coda al nodo precedente, in modo da
+// non spostare gli elementi del nodo. Se il nodo di destinazione e' pieno
+// e l'elemento va in testa o in coda al nodo viene creato un nuovo nodo
+// (cosi' gli inserimenti in sequenza riempiono completamente i nodi),
+// altrimenti il nodo viene prima diviso a meta'
+template <typename T, int N>
+typename UnrolledLinkedList<T, N>::Position
+    UnrolledLinkedList<T, N>::insert(Position pos, T item)
+{
+    Node *node = pos.node;
+    int index = pos.index;
+    if (node == head || (index == 0 && node->previous != head
+        && node->previous->count < N)) {
+        node = node->previous;
+        index = node->count;
+        if (node == head) // lista vuota
+            node = linkAfter(head);
+    }
+
+    if (node->count == N) {
+        if (index == N) { // in coda a un nodo pieno: nuovo nodo successivo
+            node = linkAfter(node);
+            index = 0;
+        } else if (index == 0) { // in testa: nuovo nodo precedente
+            node = linkAfter(node->previous);
+        } else {
+            split(node);
+            if (index > node->count) {
+                index -= node->count;
+                node = node->next;
+            }
+        }
+    }
+
+    // sposta in avanti gli elementi successivi e costruisce il nuovo
+    relocate(node->at(index), node->count - index, node->at(index + 1));
+    try {
+        new (node->at(index)) T(std::move(item));
+    } catch (...) {
+        relocate(node->at(index + 1), node->count - index, node->at(index));
+        if (node->count == 0)
+            unlink(node);
+        throw;
+    }
+    ++node->count;
+    ++size;
+    return Position(node, index);
+}
+
+// rimuove l'elemento in coda
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::popBack()
+{
+    if (!isEmpty())
+        remove(end());
+}
+
+// rimuove l'elemento in testa
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::popFront()
+{
+    if (!isEmpty())
+        remove(begin());
+}
+
+// rimuove l'elemento nella posizione indicata e riequilibra il nodo
+template <typename T, int N>
+typename UnrolledLinkedList<T, N>::Position
+    UnrolledLinkedList<T, N>::remove(Position pos)
+{
+    if (isEmpty() || finished(pos))
+        return pos;
+
+    Node *node = pos.node;
+    node->at(pos.index)->~T();
+    relocate(node->at(pos.index + 1), node->count - pos.index - 1,
+        node->at(pos.index));
+    --node->count;
+    --size;
+
+    if (node->count < N / 2)
+        rebalance(pos);
+    // se l'elemento rimosso era l'ultimo del nodo, quello
+    // successivo e' il primo del nodo seguente
+    if (pos.node != head && pos.index == pos.node->count)
+        pos = Position(pos.node->next, 0);
+    return pos;
+}
+
+// riequilibra il nodo pos.node, rimasto con meno di N/2 elementi:
+// - se e' vuoto viene eliminato;
+// - se gli elementi suoi e del nodo successivo stanno in un solo
+//   nodo, il successivo viene fuso in questo;
+// - altrimenti prende il primo elemento del nodo successivo;
+// - se e' l'ultimo nodo, viene fuso nel precedente se possibile.
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::rebalance(Position &pos)
+{
+    Node *node = pos.node;
+    if (node->count == 0) {
+        pos = Position(node->next, 0);
+        unlink(node);
+        return;
+    }
+
+    Node *next = node->next;
+    if (next != head) {
+        if (node->count + next->count <= N) {
+            relocate(next->at(0), next->count, node->at(node->count));
+            node->count += next->count;
+            next->count = 0;
+            unlink(next);
+        } else {
+            relocate(next->at(0), 1, node->at(node->count));
+            relocate(next->at(1), next->count - 1, next->at(0));
+            ++node->count;
+            --next->count;
+        }
+    } else {
+        Node *previous = node->previous;
+        if (previous != head && previous->count + node->count <= N) {
+            relocate(node->at(0), node->count, previous->at(previous->count));
+            pos = Position(previous, previous->count + pos.index);
+            previous->count += node->count;
+            node->count = 0;
+            unlink(node);
+        }
+    }
+}
+
+// cerca la prima occorrenza di un dato. Se lo trova restituisce la
+// sua posizione, altrimenti restituisce la posizione della sentinella
+// (per cui finished() restituisce "true")
+template <typename T, int N>
+typename UnrolledLinkedList<T, N>::Position
+    UnrolledLinkedList<T, N>::search(const T &item) const
+{
+    for (Node *node = head->next; node != head; node = node->next)
+        for (int i = 0; i < node->count; ++i)
+            if (*node->at(i) == item)
+                return Position(node, i);
+
+    return Position(head, 0);
+}
+
+// legge il dato nella posizione indicata
+template <typename T, int N>
+const T &UnrolledLinkedList<T, N>::read(Position pos) const
+{
+    if (isEmpty())
+        throw std::domain_error("List is empty!");
+    if (finished(pos) || pos.index < 0 || pos.index >= pos.node->count)
+        throw std::out_of_range("Invalid position!");
+
+    return *pos.node->at(pos.index);
+}
+
+// scrive nella posizione indicata
+template <typename T, int N>
+void UnrolledLinkedList<T, N>::write(Position pos, const T &item)
+{
+    if (!isEmpty() && !finished(pos))
+        *pos.node->at(pos.index) = item;
+}
+
+// overload dell'operatore di assegnazione =
+template <typename T, int N>
+UnrolledLinkedList<T, N> &
+    UnrolledLinkedList<T, N>::operator=(const UnrolledLinkedList<T, N> &l)
+{
+    if (&l != this) { // evita l'auto-assegnazione
+        clear();
+        for (const_iterator it = l.ibegin(); it != l.iend(); ++it)
+            pushBack(*it);
+    }
+
+    return *this; // consente a = b = c
+}
+
+// overload dell'operatore di uguaglianza ==. Le due liste possono avere
+// gli elementi distribuiti in modo diverso fra i nodi
+template <typename T, int N>
+bool UnrolledLinkedList<T, N>::operator==(const UnrolledLinkedList<T, N> &l) const
+{
+    if (size != l.size)
+        return false;
+
+    const_iterator it = l.ibegin();
+    for (const_iterator current = ibegin(); current != iend(); ++current, ++it)
+        if (!(*current == *it))
+            return false;
+
+    return true;
+}
+
+#endif
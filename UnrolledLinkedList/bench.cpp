@@ -0,0 +1,101 @@
+// benchmark di scansione sequenziale: UnrolledLinkedList contro LinkedList.
+// Per ogni dimensione n viene misurato il tempo medio per elemento di una
+// scansione completa che somma gli elementi, sia con le posizioni
+// (next/read) sia con gli iteratori:
+//   LinkedList: nodi allocati in sequenza con pushBack, per cui sono
+//               quasi contigui in memoria (caso favorevole);
+//   LinkedList sparsa: la stessa lista ordinata con sort() dopo averla
+//               riempita con valori casuali, per cui nodi consecutivi si
+//               trovano in punti lontani della memoria, come accade in una
+//               lista modificata a lungo;
+//   Unrolled:   UnrolledLinkedList con gli stessi elementi, ordinati.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include "UnrolledLinkedList.h"
+#include "../LinkedList/LinkedList.h"
+using std::cout;
+
+// evita che il compilatore elimini i cicli di lettura
+volatile long long sink;
+
+// restituisce il tempo medio in nanosecondi per elemento della funzione f,
+// ripetuta in modo da leggere complessivamente circa 10 milioni di elementi
+template <typename F>
+double timeScan(F f, int n)
+{
+    const int repeats = n >= 10000000 ? 1 : 10000000 / n;
+    f(); // riscaldamento
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+        f();
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count()
+        / (static_cast<double>(repeats) * n);
+}
+
+// scansione con le posizioni
+template <typename L>
+void scanPositions(const L &l)
+{
+    long long sum = 0;
+    for (typename L::Position pos = l.begin(); !l.finished(pos);
+        pos = l.next(pos))
+        sum += l.read(pos);
+    sink = sum;
+}
+
+// scansione con gli iteratori
+template <typename L>
+void scanIterators(const L &l)
+{
+    long long sum = 0;
+    for (const int &x : l.items())
+        sum += x;
+    sink = sum;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK UnrolledLinkedList **************\n\n";
+    cout << "tempo medio di scansione per elemento (ns)\n\n";
+    cout << std::setw(10) << "n" << std::setw(12) << "Linked"
+         << std::setw(12) << "sparsa" << std::setw(12) << "Unrolled"
+         << std::setw(12) << "Linked" << std::setw(12) << "sparsa"
+         << std::setw(12) << "Unrolled" << "\n";
+    cout << std::setw(10) << "" << std::setw(36) << "posizioni"
+         << std::setw(36) << "iteratori" << "\n";
+
+    std::mt19937 random(1);
+    for (int n = 1000; n <= 10000000; n *= 10) {
+        LinkedList<int> linked;
+        for (int i = 0; i < n; ++i)
+            linked.pushBack(static_cast<int>(random() % 1000));
+        double linkedPos = timeScan([&linked] { scanPositions(linked); }, n);
+        double linkedIt = timeScan([&linked] { scanIterators(linked); }, n);
+
+        linked.sort();
+        double sparsePos = timeScan([&linked] { scanPositions(linked); }, n);
+        double sparseIt = timeScan([&linked] { scanIterators(linked); }, n);
+
+        UnrolledLinkedList<int> unrolled;
+        for (const int &x : linked.items())
+            unrolled.pushBack(x);
+        double unrolledPos =
+            timeScan([&unrolled] { scanPositions(unrolled); }, n);
+        double unrolledIt =
+            timeScan([&unrolled] { scanIterators(unrolled); }, n);
+
+        cout << std::setw(10) << n << std::fixed << std::setprecision(2)
+             << std::setw(12) << linkedPos << std::setw(12) << sparsePos
+             << std::setw(12) << unrolledPos << std::setw(12) << linkedIt
+             << std::setw(12) << sparseIt << std::setw(12) << unrolledIt
+             << "\n";
+    }
+
+    return 0;
+}
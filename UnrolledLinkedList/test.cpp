@@ -0,0 +1,130 @@
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include "UnrolledLinkedList.h"
+using std::cout;
+using std::string;
+
+// stampa la distribuzione degli elementi nei nodi: ogni nodo fra parentesi
+template <typename T, int N>
+void printNodes(const UnrolledLinkedList<T, N> &l)
+{
+    cout << " ";
+    typename UnrolledLinkedList<T, N>::Position pos = l.begin();
+    while (!l.finished(pos)) {
+        if (pos.index == 0)
+            cout << "(";
+        cout << l.read(pos);
+        pos = l.next(pos);
+        cout << (pos.index == 0 ? ") " : " ");
+    }
+    cout << "\n";
+}
+
+int main()
+{
+    // nodi piccoli (4 elementi) per mostrare divisioni e fusioni
+    UnrolledLinkedList<int, 4> list;
+
+    cout << "\n************** TEST CLASSE UnrolledLinkedList **************\n\n";
+
+    // stampa una lista vuota
+    cout << "Crea e tenta di stampare una lista vuota:\n";
+    list.print();
+
+    // inserisce elementi con insert, pushFront e pushBack
+    list.insert(list.begin(), 1);
+    list.insert(list.end(), 2);
+    list.pushFront(3);
+    list.pushBack(4);
+    cout << "\nFUNZIONI insert, pushFront E pushBack:\ninserisce 1 (lista "
+         << "vuota), 2 (prima dell'ultimo), 3 (in testa) e 4 (in coda)\n"
+         << list;
+    cout << "nodi (al massimo 4 elementi per nodo):\n";
+    printNodes(list);
+
+    // un inserimento in un nodo pieno lo divide a meta'
+    UnrolledLinkedList<int, 4>::Position pos = list.next(list.begin());
+    pos = list.insert(pos, 10);
+    cout << "\nDIVISIONE DI UN NODO:\ninserisce 10 in seconda posizione "
+         << "nel nodo pieno\n";
+    printNodes(list);
+    pos = list.insert(list.next(pos), 11);
+    cout << "inserisce 11 dopo 10 usando la posizione restituita da insert\n";
+    printNodes(list);
+    for (int i = 5; i < 12; ++i)
+        list.pushBack(i);
+    cout << "inserisce in coda gli elementi da 5 a 11: i nodi in coda"
+         << " vengono riempiti\ncompletamente\n";
+    printNodes(list);
+
+    // una rimozione che lascia un nodo con meno di 2 elementi
+    // lo riequilibra con il nodo successivo
+    pos = list.search(10);
+    pos = list.remove(pos);
+    cout << "\nRIMOZIONE E RIEQUILIBRIO DEI NODI:\nrimuove 10\n";
+    printNodes(list);
+    pos = list.remove(pos);
+    cout << "rimuove l'elemento successivo (11) usando la posizione "
+         << "restituita da remove\n";
+    printNodes(list);
+    list.popFront();
+    list.popBack();
+    cout << "rimuove il primo e l'ultimo elemento: il primo nodo resta con"
+         << " un solo elemento\ne prende il primo elemento del successivo,"
+         << " l'ultimo nodo viene eliminato\n";
+    printNodes(list);
+
+    // lettura, scrittura e ricerca
+    cout << "\nFUNZIONI read, write E search\nprimo elemento: "
+         << list.read(list.begin()) << ", ultimo elemento: "
+         << list.read(list.end()) << "\n";
+    list.write(list.begin(), 100);
+    cout << "scrive 100 nel primo elemento\n" << list;
+    cout << "search(7): " << (list.finished(list.search(7)) ? "non trovato"
+        : "trovato") << "\nsearch(42): "
+         << (list.finished(list.search(42)) ? "non trovato" : "trovato") << "\n";
+    try {
+        list.read(list.next(list.end()));
+    } catch (std::out_of_range &e) {
+        cout << "lettura della sentinella: " << e.what() << "\n";
+    }
+
+    // copia, assegnamento e uguaglianza
+    UnrolledLinkedList<int, 4> list2(list), list3;
+    list3 = list;
+    cout << "\nCOSTRUTTORE PER COPIA E OPERATORE =\nlist2:" << list2
+         << "list2 == list: " << (list2 == list ? "true" : "false") << "\n";
+    list3.pushBack(0);
+    cout << "list3 (copia di list con 0 in coda):" << list3
+         << "list3 == list: " << (list3 == list ? "true" : "false") << "\n";
+
+    // iteratori
+    cout << "\nITERATORI\nsomma degli elementi con un ciclo range-for: ";
+    int sum = 0;
+    for (const int &x : list.items())
+        sum += x;
+    cout << sum << "\nmassimo con std::max_element: "
+         << *std::max_element(list.ibegin(), list.iend()) << "\n";
+    cout << "elementi dall'ultimo al primo:";
+    UnrolledLinkedList<int, 4>::iterator it = list.iend();
+    while (it != list.ibegin())
+        cout << " " << *--it;
+    cout << "\n";
+
+    // lista di stringhe con la dimensione dei nodi di default
+    UnrolledLinkedList<string> words;
+    words.pushBack("lista");
+    words.pushBack("srotolata");
+    words.pushFront("una");
+    cout << "\nLISTA DI STRINGHE\n" << words;
+    words.clear();
+    cout << "dopo clear():" << words;
+
+    // mantiene aperto il terminale
+    int x;
+    cout << "\npremere un tasto per continuare...";
+    std::cin >> x;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+// By Fabio Nardelli
+// Politiche di crescita e contrazione dei vettori dinamici, condivise da
+// ArrayList, ArrayStack e PriorityQueue (e utilizzabili da qualunque classe).
+// Una politica e' una classe con tre funzioni statiche:
+//   grow(c)              restituisce la nuova capacita' quando il vettore,
+//                        di capacita' c, e' pieno;
+//   shouldShrink(s, c, m) restituisce true se un vettore di capacita' c che
+//                        contiene s elementi deve essere contratto (m e' la
+//                        capacita' minima al di sotto della quale non si scende);
+//   shrink(c, m)         restituisce la capacita' dopo la contrazione.
+// GrowthPolicy<Num, Den, ShrinkDivisor> fa crescere il vettore di un fattore
+// Num/Den e lo contrae dello stesso fattore quando il fattore di carico scende
+// a 1/ShrinkDivisor. Poiche' la soglia di contrazione deve essere minore
+// dell'inverso del fattore di crescita (isteresi), dopo una riallocazione
+// servono sempre un numero di operazioni proporzionale alla capacita' prima
+// della successiva: inserimenti e rimozioni alternati attorno a una soglia
+// costano quindi O(1) ammortizzato. Con ShrinkDivisor = 0 il vettore non
+// viene mai contratto.
+
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+template <unsigned GrowthNum = 2, unsigned GrowthDen = 1,
+          unsigned ShrinkDivisor = 4>
+struct GrowthPolicy {
+    static_assert(GrowthNum > GrowthDen, "Growth factor must be > 1");
+    static_assert(ShrinkDivisor == 0 || ShrinkDivisor * GrowthDen > GrowthNum,
+        "Shrink threshold must be lower than 1 / growth factor");
+
+    // restituisce la capacita' dopo una crescita (almeno capacity + 1)
+    static int grow(int capacity)
+    {
+        long long c = static_cast<long long>(capacity) * GrowthNum / GrowthDen;
+        return c > capacity ? static_cast<int>(c) : capacity + 1;
+    }
+
+    // restituisce true se il fattore di carico e' sceso alla soglia
+    // 1/ShrinkDivisor e la capacita' e' maggiore di quella minima
+    static bool shouldShrink(int size, int capacity, int minCapacity)
+    {
+        return ShrinkDivisor != 0 && capacity > minCapacity
+            && static_cast<long long>(size) * ShrinkDivisor <= capacity;
+    }
+
+    // restituisce la capacita' dopo una contrazione
+    static int shrink(int capacity, int minCapacity)
+    {
+        int c = static_cast<int>(
+            static_cast<long long>(capacity) * GrowthDen / GrowthNum);
+        return c > minCapacity ? c : minCapacity;
+    }
+};
+
+// politica di default: raddoppia quando il vettore e' pieno e
+// dimezza quando il fattore di carico scende a 1/4
+typedef GrowthPolicy<> DefaultGrowth;
+// raddoppia quando il vettore e' pieno ma non lo contrae mai
+typedef GrowthPolicy<2, 1, 0> NeverShrink;
+
+#endif
@@ -0,0 +1,51 @@
+// By Fabio Nardelli
+// Iteratore bidirezionale per le strutture basate su lista doppiamente
+// concatenata con sentinella (LinkedList, LinkedQueue, LinkedStack).
+// Node deve avere i campi value, next e previous; V e' il tipo dell'elemento
+// (const T per gli iteratori costanti). L'iteratore alla sentinella e' quello
+// di fine sequenza, percio' l'accesso agli elementi non richiede controlli.
+
+#ifndef LIST_ITERATOR_H
+#define LIST_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+template <typename Node, typename V>
+class ListIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_cv<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    ListIterator() : node(0) { }
+    explicit ListIterator(Node *n) : node(n) { }
+    // conversione da iteratore a iteratore costante (solo in questo verso:
+    // un iteratore costante non puo' diventare un iteratore modificabile)
+    template <typename U, typename = typename std::enable_if<
+        std::is_same<const U, V>::value && !std::is_same<U, V>::value>::type>
+    ListIterator(const ListIterator<Node, U> &it) : node(it.getNode()) { }
+
+    reference operator*() const { return node->value; }
+    pointer operator->() const { return &node->value; }
+
+    ListIterator &operator++() { node = node->next; return *this; }
+    ListIterator operator++(int)
+        { ListIterator old(*this); node = node->next; return old; }
+    ListIterator &operator--() { node = node->previous; return *this; }
+    ListIterator operator--(int)
+        { ListIterator old(*this); node = node->previous; return old; }
+
+    bool operator==(const ListIterator &it) const { return node == it.node; }
+    bool operator!=(const ListIterator &it) const { return node != it.node; }
+
+    // restituisce il nodo puntato dall'iteratore
+    Node *getNode() const { return node; }
+private:
+    Node *node; // nodo corrente
+};
+
+#endif
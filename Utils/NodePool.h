@@ -0,0 +1,119 @@
+// By Fabio Nardelli
+// Allocatori di nodi per le strutture basate su lista concatenata
+// (LinkedList, LinkedQueue, LinkedStack), che li ricevono come parametro
+// template template: ciascun contenitore possiede un'istanza di
+// Alloc<Node>, per cui ogni contenitore ha la propria area di memoria.
+// Un allocatore e' una classe con:
+//   Node *allocate()         restituisce memoria non inizializzata per un nodo;
+//   void deallocate(Node *)  restituisce la memoria di un nodo;
+//   void release()           libera in blocco tutta la memoria dell'allocatore
+//                            (solo se releasesAll e' true);
+//   releasesAll              true se release() libera tutti i nodi allocati,
+//                            che quindi non devono essere restituiti uno a uno;
+//   stateless                true se la memoria di un nodo puo' essere
+//                            restituita a un'istanza diversa da quella che
+//                            l'ha allocata (i nodi possono passare da un
+//                            contenitore all'altro).
+// HeapAllocator usa new e delete per ogni nodo. PoolAllocator alloca i nodi
+// a blocchi (slab) di circa 4 KB e riutilizza i nodi restituiti tramite una
+// lista di nodi liberi: un'allocazione costa quindi una chiamata a malloc
+// ogni slab invece che una per nodo, e release() libera l'intera area con
+// una chiamata per slab, indipendentemente dal numero di nodi.
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+// allocatore di default: un'allocazione di memoria per ogni nodo
+template <typename Node>
+struct HeapAllocator {
+    static const bool releasesAll = false;
+    static const bool stateless = true;
+
+    Node *allocate()
+        { return static_cast<Node *>(::operator new(sizeof(Node))); }
+    void deallocate(Node *node) { ::operator delete(node); }
+    void release() { }
+};
+
+// allocatore a blocchi di dimensione fissa. Una copia dell'allocatore non
+// condivide i blocchi dell'originale, ma ne crea di propri
+template <typename Node>
+class PoolAllocator {
+public:
+    static const bool releasesAll = true;
+    static const bool stateless = false;
+
+    PoolAllocator() : slabs(0), freeSlots(0), next(0), last(0) { }
+    PoolAllocator(const PoolAllocator &)
+        : slabs(0), freeSlots(0), next(0), last(0) { }
+    PoolAllocator &operator=(const PoolAllocator &) { return *this; }
+    ~PoolAllocator() { release(); }
+
+    // restituisce un nodo libero o, se non ce ne sono, il primo
+    // nodo non ancora utilizzato dell'ultimo blocco
+    Node *allocate()
+    {
+        if (freeSlots != 0) {
+            Slot *slot = freeSlots;
+            freeSlots = slot->next;
+            return reinterpret_cast<Node *>(slot);
+        }
+        if (next == last)
+            addSlab();
+        return reinterpret_cast<Node *>(next++);
+    }
+
+    // inserisce il nodo nella lista dei nodi liberi
+    void deallocate(Node *node)
+    {
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->next = freeSlots;
+        freeSlots = slot;
+    }
+
+    // libera tutti i blocchi
+    void release()
+    {
+        while (slabs != 0) {
+            Slot *nextSlab = slabs->next;
+            ::operator delete(slabs);
+            slabs = nextSlab;
+        }
+        freeSlots = next = last = 0;
+    }
+
+private:
+    // una posizione del blocco: contiene un nodo oppure, se la posizione
+    // e' libera, il puntatore alla posizione libera successiva
+    union Slot {
+        Slot *next;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type node;
+    };
+
+    // posizioni per blocco: circa 4 KB, almeno 16. La prima posizione
+    // di ogni blocco contiene il puntatore al blocco successivo
+    static const int slabSlots = sizeof(Slot) * 16 >= 4096
+        ? 16 : static_cast<int>(4096 / sizeof(Slot));
+
+    Slot *slabs; // lista dei blocchi allocati
+    Slot *freeSlots; // lista delle posizioni restituite
+    Slot *next; // prima posizione mai utilizzata dell'ultimo blocco
+    Slot *last; // fine dell'ultimo blocco
+
+    // alloca un nuovo blocco e lo inserisce in testa alla lista dei blocchi
+    void addSlab()
+    {
+        Slot *slab = static_cast<Slot *>(
+            ::operator new(slabSlots * sizeof(Slot)));
+        slab->next = slabs;
+        slabs = slab;
+        next = slab + 1;
+        last = slab + slabSlots;
+    }
+};
+
+#endif
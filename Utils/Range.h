@@ -0,0 +1,26 @@
+// By Fabio Nardelli
+// Coppia di iteratori che consente di usare i contenitori nei cicli
+// range-for. Le funzioni begin() e end() dei contenitori restituiscono una
+// Position (e end() indica l'ultimo elemento, non la posizione successiva),
+// percio' i contenitori espongono i propri elementi tramite items(), che
+// restituisce un oggetto Range:
+//   for (const int &x : list.items()) ...
+
+#ifndef RANGE_H
+#define RANGE_H
+
+template <typename It>
+class Range {
+public:
+    Range(It first, It last) : first(first), last(last) { }
+
+    // iteratore al primo elemento
+    It begin() const { return first; }
+    // iteratore alla posizione successiva all'ultimo elemento
+    It end() const { return last; }
+private:
+    It first;
+    It last;
+};
+
+#endif
@@ -0,0 +1,105 @@
+// benchmark delle politiche di crescita (Utils/GrowthPolicy.h).
+// Ciascun contenitore viene riempito fino alla capacita' del vettore, poi si
+// alternano inserimenti e rimozioni esattamente sulla soglia di crescita.
+// Con la politica di default (isteresi) il costo per operazione resta
+// costante al crescere della dimensione; con una politica senza isteresi
+// (EagerShrink, che contrae appena il fattore di carico scende a 1/2) ogni
+// coppia inserimento/rimozione rialloca e copia l'intero vettore.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "../ArrayList/ArrayList.h"
+#include "../ArrayStack/ArrayStack.h"
+#include "../PriorityQueue/PriorityQueue.h"
+using std::cout;
+
+// politica senza isteresi, usata solo per confronto
+struct EagerShrink {
+    static int grow(int capacity) { return capacity * 2; }
+    static bool shouldShrink(int size, int capacity, int minCapacity)
+        { return capacity > minCapacity && 2 * size <= capacity; }
+    static int shrink(int capacity, int minCapacity)
+        { return capacity / 2 > minCapacity ? capacity / 2 : minCapacity; }
+};
+
+// restituisce il tempo medio in nanosecondi di una operazione
+template <typename F>
+double timeOps(F f, int ops)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f(ops);
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+template <typename G>
+double benchList(int n, int ops)
+{
+    ArrayList<int, G> l;
+    for (int i = 0; i < n; ++i)
+        l.pushBack(i);
+    return timeOps([&l](int k) {
+        for (int i = 0; i < k; i += 2) {
+            l.pushBack(i);
+            l.popBack();
+        }
+    }, ops);
+}
+
+template <typename G>
+double benchStack(int n, int ops)
+{
+    ArrayStack<int, G> s;
+    for (int i = 0; i < n; ++i)
+        s.push(i);
+    return timeOps([&s](int k) {
+        for (int i = 0; i < k; i += 2) {
+            s.push(i);
+            s.pop();
+        }
+    }, ops);
+}
+
+template <typename G>
+double benchQueue(int n, int ops)
+{
+    PriorityQueue<int, G> q;
+    for (int i = 0; i < n; ++i)
+        q.insert(i, i);
+    return timeOps([&q](int k) {
+        for (int i = 0; i < k; i += 2) {
+            q.insert(-1, -1);
+            q.deleteMin();
+        }
+    }, ops);
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK GrowthPolicy **************\n\n";
+    cout << "push/pop alternati sulla soglia di crescita (ns/op)\n\n";
+    cout << std::setw(10) << "n" << std::setw(12) << "List"
+         << std::setw(12) << "List*" << std::setw(12) << "Stack"
+         << std::setw(12) << "Stack*" << std::setw(12) << "PQueue"
+         << std::setw(12) << "PQueue*" << "\n";
+
+    const int ops = 200000; // operazioni con la politica di default
+    for (int n = 1 << 10; n <= 1 << 20; n <<= 2) {
+        // con EagerShrink ogni operazione costa O(n): limita il numero
+        // di operazioni per mantenere contenuto il tempo di esecuzione
+        int eagerOps = 2 * (1 << 22) / n;
+        cout << std::setw(10) << n << std::fixed << std::setprecision(1)
+             << std::setw(12) << benchList<DefaultGrowth>(n, ops)
+             << std::setw(12) << benchList<EagerShrink>(n, eagerOps)
+             << std::setw(12) << benchStack<DefaultGrowth>(n, ops)
+             << std::setw(12) << benchStack<EagerShrink>(n, eagerOps)
+             << std::setw(12) << benchQueue<DefaultGrowth>(n, ops)
+             << std::setw(12) << benchQueue<EagerShrink>(n, eagerOps) << "\n";
+    }
+    cout << "\n* = politica senza isteresi (EagerShrink)\n";
+
+    return 0;
+}
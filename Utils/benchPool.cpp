@@ -0,0 +1,134 @@
+// benchmark degli allocatori di nodi (Utils/NodePool.h).
+// Conta le chiamate all'operatore new (sostituito in questo file) e misura
+// il tempo medio per operazione con HeapAllocator e PoolAllocator su:
+//   riempimento e distruzione di una lista di n elementi;
+//   coda con ricambio continuo (inserimento in fondo, rimozione in testa);
+//   pila che cresce e si svuota piu' volte (raffiche di push e pop).
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "../LinkedList/LinkedList.h"
+#include "../LinkedQueue/LinkedQueue.h"
+#include "../LinkedStack/LinkedStack.h"
+using std::cout;
+
+// numero di chiamate all'operatore new
+static long long allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size != 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+// risultato di una misura: tempo per operazione e allocazioni
+struct Result {
+    double ns;
+    long long allocs;
+};
+
+// esegue f(ops) e restituisce tempo medio e numero di allocazioni
+template <typename F>
+Result measure(F f, int ops)
+{
+    long long before = allocations;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f(ops);
+    std::chrono::steady_clock::time_point stop =
+        std::chrono::steady_clock::now();
+    Result r;
+    r.ns = std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+    r.allocs = allocations - before;
+    return r;
+}
+
+template <template <typename> class Alloc>
+Result fillAndDestroy(int n)
+{
+    return measure([](int k) {
+        LinkedList<int, Alloc> l;
+        for (int i = 0; i < k; ++i)
+            l.pushBack(i);
+    }, n);
+}
+
+template <template <typename> class Alloc>
+Result queueChurn(int n)
+{
+    LinkedQueue<int, Alloc> q;
+    for (int i = 0; i < n; ++i)
+        q.enqueue(i);
+    return measure([&q](int k) {
+        for (int i = 0; i < k; ++i) {
+            q.enqueue(i);
+            q.dequeue();
+        }
+    }, 4 * n);
+}
+
+template <template <typename> class Alloc>
+Result stackBursts(int n)
+{
+    LinkedStack<int, Alloc> s;
+    return measure([&s, n](int k) {
+        for (int round = 0; round < k / (2 * n); ++round) {
+            for (int i = 0; i < n; ++i)
+                s.push(i);
+            for (int i = 0; i < n; ++i)
+                s.pop();
+        }
+    }, 8 * n);
+}
+
+// stampa una coppia di risultati (heap, pool)
+void printPair(const Result &heap, const Result &pool)
+{
+    cout << std::fixed << std::setprecision(1)
+         << std::setw(9) << heap.ns << std::setw(9) << pool.ns
+         << std::setw(10) << heap.allocs << std::setw(8) << pool.allocs;
+}
+
+int main()
+{
+    cout << "\n************** BENCHMARK NodePool **************\n\n";
+    cout << "ns/op e chiamate a new con HeapAllocator (H) e PoolAllocator (P)"
+         << "\n\n" << std::setw(8) << "n";
+    const char *names[] = { "riempi e distruggi", "coda con ricambio",
+                            "raffiche di push/pop" };
+    for (int i = 0; i < 3; ++i)
+        cout << std::setw(36) << names[i];
+    cout << "\n" << std::setw(8) << "";
+    for (int i = 0; i < 3; ++i)
+        cout << std::setw(9) << "ns H" << std::setw(9) << "ns P"
+             << std::setw(10) << "new H" << std::setw(8) << "new P";
+    cout << "\n";
+
+    for (int n = 1 << 10; n <= 1 << 18; n <<= 4) {
+        cout << std::setw(8) << n;
+        printPair(fillAndDestroy<HeapAllocator>(n),
+                  fillAndDestroy<PoolAllocator>(n));
+        printPair(queueChurn<HeapAllocator>(n), queueChurn<PoolAllocator>(n));
+        printPair(stackBursts<HeapAllocator>(n),
+                  stackBursts<PoolAllocator>(n));
+        cout << "\n";
+    }
+
+    return 0;
+}